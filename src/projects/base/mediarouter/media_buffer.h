@@ -11,6 +11,7 @@
 
 #include <cstdint>
 #include <map>
+#include <vector>
 
 #include <base/common_types.h>
 #include "media_type.h"
@@ -22,6 +23,43 @@ enum class MediaPacketFlag : uint8_t
 	Key // Key Frame
 };
 
+// Index of the NAL units in an H.264/H.265 (Annex B) packet.
+// MediaRouter builds it once per packet, and the publishers use it instead of scanning the bitstream again.
+// It is shared by the publishers, so it must not be modified after it is set to a packet.
+struct NalUnitIndex
+{
+	struct NalUnit
+	{
+		// Offset of the NAL unit header (the start code is not included)
+		size_t offset = 0;
+		size_t length = 0;
+		// 3 or 4 (0 if the NAL unit has no start code)
+		uint8_t start_code_length = 0;
+		// nal_unit_type of H.264 or H.265
+		uint8_t type = 0;
+	};
+
+	const NalUnit *Find(uint8_t type) const
+	{
+		for (const auto &nal_unit : nal_units)
+		{
+			if (nal_unit.type == type)
+			{
+				return &nal_unit;
+			}
+		}
+
+		return nullptr;
+	}
+
+	std::vector<NalUnit> nal_units;
+
+	// IDR picture or SPS for H.264, IRAP picture for H.265
+	bool has_keyframe = false;
+	// All parameter sets (SPS/PPS, and VPS for H.265) are included
+	bool has_parameter_sets = false;
+};
+
 class MediaPacket
 {
 public:
@@ -181,6 +219,17 @@ public:
 		return &_frag_hdr;
 	}
 
+	void SetNalUnitIndex(const std::shared_ptr<const NalUnitIndex> &nal_unit_index)
+	{
+		_nal_unit_index = nal_unit_index;
+	}
+
+	// nullptr if the index is not built
+	const std::shared_ptr<const NalUnitIndex> &GetNalUnitIndex() const
+	{
+		return _nal_unit_index;
+	}
+
 	std::shared_ptr<MediaPacket> ClonePacket()
 	{
 		auto packet = std::make_shared<MediaPacket>(
@@ -193,6 +242,7 @@ public:
 			GetFlag());
 
 		packet->_frag_hdr = _frag_hdr;
+		packet->_nal_unit_index = _nal_unit_index;
 
 		return packet;
 	}
@@ -210,6 +260,7 @@ protected:
 	common::BitstreamFormat _bitstream_format = common::BitstreamFormat::Unknwon;
 	common::PacketType _packet_type = common::PacketType::Unknwon;
 	FragmentationHeader _frag_hdr;
+	std::shared_ptr<const NalUnitIndex> _nal_unit_index;
 };
 
 class MediaFrame
@@ -0,0 +1,152 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2020 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "hmac_sha1.h"
+
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/sha.h>
+
+#include "ovcrypto_private.h"
+
+namespace ov
+{
+	struct HmacSha1Context
+	{
+		// States after H(K XOR ipad) / H(K XOR opad) are started
+		EVP_MD_CTX *inner_base = nullptr;
+		EVP_MD_CTX *outer_base = nullptr;
+
+		// State of the message which is being hashed
+		EVP_MD_CTX *inner = nullptr;
+		// Used by Finish(), so the context is not allocated for each message
+		EVP_MD_CTX *outer = nullptr;
+
+		~HmacSha1Context()
+		{
+			// EVP_MD_CTX_free() cleanses the states
+			EVP_MD_CTX_free(inner_base);
+			EVP_MD_CTX_free(outer_base);
+			EVP_MD_CTX_free(inner);
+			EVP_MD_CTX_free(outer);
+		}
+	};
+
+	static_assert(HmacSha1::DigestLength == SHA_DIGEST_LENGTH, "Invalid digest length");
+
+	HmacSha1::HmacSha1()
+	{
+	}
+
+	HmacSha1::~HmacSha1()
+	{
+		if (_context != nullptr)
+		{
+			delete _context;
+			_context = nullptr;
+		}
+	}
+
+	bool HmacSha1::SetKey(const void *key, size_t key_length)
+	{
+		constexpr size_t block_length = SHA_CBLOCK;
+
+		// padding을 위해, 키를 임시 버퍼에 복사함
+		uint8_t new_key[block_length] = {0};
+
+		bool result = true;
+
+		if (key_length > block_length)
+		{
+			// key 길이가 block 길이보다 크면 hash 한 뒤 그 결과를 key로 사용함
+			result = (::EVP_Digest(key, key_length, new_key, nullptr, ::EVP_sha1(), nullptr) == 1);
+		}
+		else if (key_length > 0)
+		{
+			::memcpy(new_key, key, key_length);
+		}
+
+		uint8_t input_pad[block_length];
+		uint8_t output_pad[block_length];
+
+		for (size_t index = 0; index < block_length; index++)
+		{
+			input_pad[index] = 0x36 ^ new_key[index];
+			output_pad[index] = 0x5C ^ new_key[index];
+		}
+
+		if (_context == nullptr)
+		{
+			_context = new HmacSha1Context();
+
+			_context->inner_base = ::EVP_MD_CTX_new();
+			_context->outer_base = ::EVP_MD_CTX_new();
+			_context->inner = ::EVP_MD_CTX_new();
+			_context->outer = ::EVP_MD_CTX_new();
+		}
+
+		result = result && (_context->inner_base != nullptr) && (_context->outer_base != nullptr) && (_context->inner != nullptr) && (_context->outer != nullptr);
+
+		result = result && (::EVP_DigestInit_ex(_context->inner_base, ::EVP_sha1(), nullptr) == 1);
+		result = result && (::EVP_DigestUpdate(_context->inner_base, input_pad, block_length) == 1);
+		result = result && (::EVP_DigestInit_ex(_context->outer_base, ::EVP_sha1(), nullptr) == 1);
+		result = result && (::EVP_DigestUpdate(_context->outer_base, output_pad, block_length) == 1);
+
+		result = result && (::EVP_MD_CTX_copy_ex(_context->inner, _context->inner_base) == 1);
+
+		OPENSSL_cleanse(new_key, sizeof(new_key));
+		OPENSSL_cleanse(input_pad, sizeof(input_pad));
+		OPENSSL_cleanse(output_pad, sizeof(output_pad));
+
+		if (result == false)
+		{
+			logte("Could not prepare the HMAC key");
+
+			delete _context;
+			_context = nullptr;
+		}
+
+		return result;
+	}
+
+	bool HmacSha1::Update(const void *input, size_t input_length)
+	{
+		if (_context == nullptr)
+		{
+			OV_ASSERT(false, "Key is not set");
+			return false;
+		}
+
+		return (::EVP_DigestUpdate(_context->inner, input, input_length) == 1);
+	}
+
+	bool HmacSha1::Finish(uint8_t output[DigestLength])
+	{
+		if (_context == nullptr)
+		{
+			OV_ASSERT(false, "Key is not set");
+			return false;
+		}
+
+		uint8_t inner_hash[SHA_DIGEST_LENGTH];
+
+		bool result = true;
+
+		result = result && (::EVP_DigestFinal_ex(_context->inner, inner_hash, nullptr) == 1);
+		result = result && (::EVP_MD_CTX_copy_ex(_context->outer, _context->outer_base) == 1);
+		result = result && (::EVP_DigestUpdate(_context->outer, inner_hash, sizeof(inner_hash)) == 1);
+		result = result && (::EVP_DigestFinal_ex(_context->outer, output, nullptr) == 1);
+
+		// Ready for the next message
+		result = (::EVP_MD_CTX_copy_ex(_context->inner, _context->inner_base) == 1) && result;
+
+		OPENSSL_cleanse(inner_hash, sizeof(inner_hash));
+
+		return result;
+	}
+}  // namespace ov
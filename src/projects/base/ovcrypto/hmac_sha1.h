@@ -0,0 +1,60 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2020 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+
+namespace ov
+{
+	struct HmacSha1Context;
+
+	// HMAC-SHA1 (RFC 2104) with a key which is prepared once.
+	//
+	// MessageDigest::ComputeHmac() pads the key and creates the digest contexts for every message.
+	// HmacSha1 keeps the SHA1 states after the padded keys are hashed, so only the message is hashed
+	// for each HMAC, and the digest contexts are created only once. (Used for STUN MESSAGE-INTEGRITY)
+	//
+	// It is not thread-safe.
+	class HmacSha1
+	{
+	public:
+		static constexpr size_t DigestLength = 20;
+
+		HmacSha1();
+		~HmacSha1();
+
+		HmacSha1(const HmacSha1 &) = delete;
+		HmacSha1 &operator=(const HmacSha1 &) = delete;
+
+		bool SetKey(const void *key, size_t key_length);
+		bool SetKey(const ov::String &key)
+		{
+			return SetKey(key.CStr(), key.GetLength());
+		}
+
+		bool IsKeySet() const
+		{
+			return (_context != nullptr);
+		}
+
+		// The message can be given in several parts (Update() -> Update() -> ... -> Finish())
+		bool Update(const void *input, size_t input_length);
+		// Writes the HMAC of the message, and prepares for the next message
+		bool Finish(uint8_t output[DigestLength]);
+
+		bool Compute(const void *input, size_t input_length, uint8_t output[DigestLength])
+		{
+			return Update(input, input_length) && Finish(output);
+		}
+
+	protected:
+		// openssl을 외부로 부터 감추기 위해 forward declaration 사용
+		HmacSha1Context *_context = nullptr;
+	};
+}  // namespace ov
@@ -11,6 +11,7 @@
 #include "./crc_32.h"
 #include "./base_64.h"
 #include "./message_digest.h"
+#include "./hmac_sha1.h"
 #include "./certificate.h"
 
 #include "./openssl/openssl_manager.h"
@@ -0,0 +1,294 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2020 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "buffer_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <new>
+
+namespace ov
+{
+	static constexpr size_t BLOCK_SIZE_LIST[BufferPool::ClassCount] = {
+		256,
+		1536,
+		16 * 1024,
+		256 * 1024,
+		2 * 1024 * 1024};
+
+	// Maximum number of free blocks that each thread keeps
+	static constexpr size_t THREAD_CACHE_LIMIT_LIST[BufferPool::ClassCount] = {
+		256,
+		128,
+		32,
+		4,
+		1};
+
+	// Maximum number of free blocks in the global free list (2MB, 6MB, 8MB, 16MB, 32MB)
+	static constexpr size_t GLOBAL_LIMIT_LIST[BufferPool::ClassCount] = {
+		8192,
+		4096,
+		512,
+		64,
+		16};
+
+	struct BufferPoolClass
+	{
+		std::mutex mutex;
+		std::vector<void *> free_list;
+
+		std::atomic<uint64_t> hit_count{0};
+		std::atomic<uint64_t> miss_count{0};
+		std::atomic<uint64_t> in_use_count{0};
+		std::atomic<uint64_t> high_water_count{0};
+	};
+
+	struct BufferPoolStatisticsForOversized
+	{
+		std::atomic<uint64_t> allocation_count{0};
+		std::atomic<uint64_t> in_use_count{0};
+		std::atomic<uint64_t> high_water_count{0};
+	};
+
+	// These are never destroyed, because buffers can be released by static/thread_local destructors at exit
+	static BufferPoolClass *GetClassList()
+	{
+		static auto class_list = new BufferPoolClass[BufferPool::ClassCount];
+		return class_list;
+	}
+
+	static BufferPoolStatisticsForOversized *GetOversizedStatistics()
+	{
+		static auto statistics = new BufferPoolStatisticsForOversized();
+		return statistics;
+	}
+
+	static void UpdateHighWater(std::atomic<uint64_t> &high_water_count, uint64_t in_use_count)
+	{
+		auto high_water = high_water_count.load(std::memory_order_relaxed);
+
+		while ((in_use_count > high_water) && (high_water_count.compare_exchange_weak(high_water, in_use_count, std::memory_order_relaxed) == false))
+		{
+		}
+	}
+
+	// Moves blocks from the end of source to the global free list of the class, and frees the blocks that exceed the limit
+	static void ReturnToGlobal(size_t index, std::vector<void *> &source, size_t count)
+	{
+		auto &pool_class = GetClassList()[index];
+		std::vector<void *> blocks_to_free;
+
+		{
+			std::lock_guard<std::mutex> lock(pool_class.mutex);
+
+			while ((count > 0) && (source.empty() == false))
+			{
+				if (pool_class.free_list.size() < GLOBAL_LIMIT_LIST[index])
+				{
+					pool_class.free_list.push_back(source.back());
+				}
+				else
+				{
+					blocks_to_free.push_back(source.back());
+				}
+
+				source.pop_back();
+				count--;
+			}
+		}
+
+		for (auto block : blocks_to_free)
+		{
+			::operator delete(block);
+		}
+	}
+
+	struct BufferPoolThreadCache
+	{
+		~BufferPoolThreadCache();
+
+		std::vector<void *> free_list[BufferPool::ClassCount];
+	};
+
+	// BufferPoolThreadCache must not be used after it is destroyed, so this trivial flag is checked
+	static thread_local bool g_thread_cache_destroyed = false;
+	static thread_local BufferPoolThreadCache g_thread_cache;
+
+	BufferPoolThreadCache::~BufferPoolThreadCache()
+	{
+		g_thread_cache_destroyed = true;
+
+		for (size_t index = 0; index < BufferPool::ClassCount; index++)
+		{
+			ReturnToGlobal(index, free_list[index], free_list[index].size());
+		}
+	}
+
+	static int GetClassIndex(size_t size)
+	{
+		for (size_t index = 0; index < BufferPool::ClassCount; index++)
+		{
+			if (size <= BLOCK_SIZE_LIST[index])
+			{
+				return static_cast<int>(index);
+			}
+		}
+
+		return -1;
+	}
+
+	size_t BufferPool::GetBlockSize(size_t size)
+	{
+		auto index = GetClassIndex(size);
+
+		return (index >= 0) ? BLOCK_SIZE_LIST[index] : size;
+	}
+
+	void *BufferPool::Allocate(size_t size)
+	{
+		auto index = GetClassIndex(size);
+
+		if (index < 0)
+		{
+			auto statistics = GetOversizedStatistics();
+
+			statistics->allocation_count.fetch_add(1, std::memory_order_relaxed);
+			UpdateHighWater(statistics->high_water_count, statistics->in_use_count.fetch_add(1, std::memory_order_relaxed) + 1);
+
+			return ::operator new(size);
+		}
+
+		auto &pool_class = GetClassList()[index];
+		void *block = nullptr;
+
+		if (g_thread_cache_destroyed == false)
+		{
+			auto &free_list = g_thread_cache.free_list[index];
+
+			if (free_list.empty())
+			{
+				// Take a batch from the global free list to fill half of the thread cache
+				size_t count = std::max<size_t>(THREAD_CACHE_LIMIT_LIST[index] / 2, 1);
+
+				std::lock_guard<std::mutex> lock(pool_class.mutex);
+
+				while ((count > 0) && (pool_class.free_list.empty() == false))
+				{
+					free_list.push_back(pool_class.free_list.back());
+					pool_class.free_list.pop_back();
+					count--;
+				}
+			}
+
+			if (free_list.empty() == false)
+			{
+				block = free_list.back();
+				free_list.pop_back();
+			}
+		}
+		else
+		{
+			std::lock_guard<std::mutex> lock(pool_class.mutex);
+
+			if (pool_class.free_list.empty() == false)
+			{
+				block = pool_class.free_list.back();
+				pool_class.free_list.pop_back();
+			}
+		}
+
+		if (block != nullptr)
+		{
+			pool_class.hit_count.fetch_add(1, std::memory_order_relaxed);
+		}
+		else
+		{
+			block = ::operator new(BLOCK_SIZE_LIST[index]);
+			pool_class.miss_count.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		UpdateHighWater(pool_class.high_water_count, pool_class.in_use_count.fetch_add(1, std::memory_order_relaxed) + 1);
+
+		return block;
+	}
+
+	void BufferPool::Deallocate(void *block, size_t size) noexcept
+	{
+		if (block == nullptr)
+		{
+			return;
+		}
+
+		auto index = GetClassIndex(size);
+
+		if (index < 0)
+		{
+			GetOversizedStatistics()->in_use_count.fetch_sub(1, std::memory_order_relaxed);
+			::operator delete(block);
+			return;
+		}
+
+		auto &pool_class = GetClassList()[index];
+
+		pool_class.in_use_count.fetch_sub(1, std::memory_order_relaxed);
+
+		if (g_thread_cache_destroyed)
+		{
+			std::vector<void *> blocks = {block};
+			ReturnToGlobal(index, blocks, 1);
+			return;
+		}
+
+		auto &free_list = g_thread_cache.free_list[index];
+
+		free_list.push_back(block);
+
+		if (free_list.size() > THREAD_CACHE_LIMIT_LIST[index])
+		{
+			// Give half of the cache back, so the blocks released by this thread can be used by the others
+			ReturnToGlobal(index, free_list, std::max<size_t>(free_list.size() / 2, 1));
+		}
+	}
+
+	std::vector<BufferPoolStatistics> BufferPool::GetStatistics()
+	{
+		std::vector<BufferPoolStatistics> statistics_list;
+		auto class_list = GetClassList();
+
+		for (size_t index = 0; index < ClassCount; index++)
+		{
+			auto &pool_class = class_list[index];
+			BufferPoolStatistics statistics;
+
+			statistics.block_size = BLOCK_SIZE_LIST[index];
+			statistics.hit_count = pool_class.hit_count.load(std::memory_order_relaxed);
+			statistics.miss_count = pool_class.miss_count.load(std::memory_order_relaxed);
+			statistics.in_use_count = pool_class.in_use_count.load(std::memory_order_relaxed);
+			statistics.high_water_count = pool_class.high_water_count.load(std::memory_order_relaxed);
+
+			{
+				std::lock_guard<std::mutex> lock(pool_class.mutex);
+				statistics.pooled_count = pool_class.free_list.size();
+			}
+
+			statistics_list.push_back(statistics);
+		}
+
+		auto oversized = GetOversizedStatistics();
+		BufferPoolStatistics statistics;
+
+		statistics.miss_count = oversized->allocation_count.load(std::memory_order_relaxed);
+		statistics.in_use_count = oversized->in_use_count.load(std::memory_order_relaxed);
+		statistics.high_water_count = oversized->high_water_count.load(std::memory_order_relaxed);
+
+		statistics_list.push_back(statistics);
+
+		return statistics_list;
+	}
+}  // namespace ov
@@ -0,0 +1,91 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2020 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ov
+{
+	struct BufferPoolStatistics
+	{
+		// 0 means the allocations that are larger than the largest class (not pooled)
+		size_t block_size = 0;
+
+		// Allocations served from a thread cache or the global free list
+		uint64_t hit_count = 0;
+		// Allocations that needed a new block from the system allocator
+		uint64_t miss_count = 0;
+		// Blocks that are currently in use
+		uint64_t in_use_count = 0;
+		// The maximum value of in_use_count
+		uint64_t high_water_count = 0;
+		// Free blocks kept in the global free list (blocks in the thread caches are not included)
+		uint64_t pooled_count = 0;
+	};
+
+	// Size-classed block pool for media payloads (256B / 1.5KB / 16KB / 256KB / 2MB).
+	//
+	// Each thread keeps a small cache of free blocks per class, and exchanges them with a global free list
+	// in batches, so most allocations do not take any lock. Blocks are kept (up to a limit) instead of being
+	// returned to the system, which avoids page faults and fragmentation for the same-sized buffers.
+	class BufferPool
+	{
+	public:
+		static constexpr size_t ClassCount = 5;
+
+		static void *Allocate(size_t size);
+		// size must be the same as the size passed to Allocate()
+		static void Deallocate(void *block, size_t size) noexcept;
+
+		// Returns the size that will actually be allocated for size
+		static size_t GetBlockSize(size_t size);
+
+		// Statistics of each class, followed by the statistics of the allocations that are not pooled
+		static std::vector<BufferPoolStatistics> GetStatistics();
+	};
+
+	// STL allocator that allocates from BufferPool
+	template <typename T>
+	class PoolAllocator
+	{
+	public:
+		using value_type = T;
+
+		PoolAllocator() noexcept = default;
+
+		template <typename U>
+		PoolAllocator(const PoolAllocator<U> &) noexcept
+		{
+		}
+
+		T *allocate(size_t count)
+		{
+			return static_cast<T *>(BufferPool::Allocate(count * sizeof(T)));
+		}
+
+		void deallocate(T *pointer, size_t count) noexcept
+		{
+			BufferPool::Deallocate(pointer, count * sizeof(T));
+		}
+
+		template <typename U>
+		bool operator==(const PoolAllocator<U> &) const noexcept
+		{
+			return true;
+		}
+
+		template <typename U>
+		bool operator!=(const PoolAllocator<U> &) const noexcept
+		{
+			return false;
+		}
+	};
+}  // namespace ov
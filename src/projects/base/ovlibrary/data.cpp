@@ -51,7 +51,7 @@ namespace ov
 		_reference_data = data._reference_data;
 		if (data._allocated_data != nullptr)
 		{
-			_allocated_data = std::make_shared<std::vector<uint8_t>>();
+			_allocated_data = CreateBuffer();
 			Append(&data);
 		}
 		_offset = data._offset;
@@ -246,7 +246,7 @@ namespace ov
 		// Reset the offset
 		_offset = 0L;
 
-		_allocated_data = std::make_shared<std::vector<uint8_t>>(begin, end);
+		_allocated_data = CreateBuffer(begin, end);
 		_allocated_data->reserve(old_data->capacity() - old_offset);
 
 		return (_allocated_data != nullptr);
@@ -265,10 +265,11 @@ namespace ov
 		}
 		else
 		{
-			_allocated_data = std::make_shared<std::vector<uint8_t>>();
+			_allocated_data = CreateBuffer();
 		}
 
-		_allocated_data->reserve(capacity);
+		// Use the whole block of the pool, so it is not reallocated until it is full
+		_allocated_data->reserve(BufferPool::GetBlockSize(capacity));
 
 		return true;
 	}
@@ -277,7 +278,7 @@ namespace ov
 	{
 		// Reallocate the buffer (this method is faster than Detach() & clear());
 		_reference_data = nullptr;
-		_allocated_data = std::make_shared<std::vector<uint8_t>>();
+		_allocated_data = CreateBuffer();
 		_offset = 0;
 		_length = 0;
 
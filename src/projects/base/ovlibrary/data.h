@@ -11,7 +11,7 @@
 #include "./string.h"
 #include "./assert.h"
 #include "./memory_utilities.h"
-#include "./data.h"
+#include "./buffer_pool.h"
 
 #include <memory>
 #include <algorithm>
@@ -22,6 +22,9 @@ namespace ov
 	class Data
 	{
 	public:
+		// Backing store of the data. The memory is allocated from BufferPool.
+		using Buffer = std::vector<uint8_t, PoolAllocator<uint8_t>>;
+
 		// Default constructor
 		Data();
 
@@ -206,6 +209,13 @@ namespace ov
 	protected:
 		std::shared_ptr<const Data> SubdataInternal(off_t offset, size_t length) const;
 
+		// The control block of std::shared_ptr is also allocated from BufferPool
+		template <typename... Targuments>
+		static std::shared_ptr<Buffer> CreateBuffer(Targuments &&... arguments)
+		{
+			return std::allocate_shared<Buffer>(PoolAllocator<Buffer>(), std::forward<Targuments>(arguments)...);
+		}
+
 		/// Called to separate from the origin data
 		///
 		/// @return true on success, false on failure
@@ -214,7 +224,7 @@ namespace ov
 		const void *_reference_data = nullptr;
 
 		// Allocated data. If this data is subdata, _current_data and _data can be different.
-		std::shared_ptr<std::vector<uint8_t>> _allocated_data = nullptr;
+		std::shared_ptr<Buffer> _allocated_data = nullptr;
 		// Offset from _allocated_data
 		off_t _offset = 0;
 
@@ -0,0 +1,397 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2020 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "executor.h"
+
+#include <pthread.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include "./log.h"
+#include "./platform.h"
+
+#define OV_LOG_TAG "Executor"
+
+namespace ov
+{
+	thread_local Executor *Executor::_current_executor = nullptr;
+	thread_local size_t Executor::_current_index = 0;
+
+	Executor *Executor::GetInstance()
+	{
+		// Never destroyed, because tasks can be posted by static destructors at exit
+		static auto instance = new Executor("OvExecutor", Platform::GetProcessorCount());
+
+		return instance;
+	}
+
+	const std::vector<Executor *> &Executor::GetShardList()
+	{
+		static auto shard_list = []() -> std::vector<Executor *> {
+			std::vector<Executor *> list;
+			auto count = std::max(Platform::GetProcessorCount(), 1);
+
+			for (int index = 0; index < count; index++)
+			{
+				char name[16];
+				::snprintf(name, sizeof(name), "OvShard%d_", index);
+
+				// Never destroyed, like the shared instance
+				list.push_back(new Executor(name, 1, index));
+			}
+
+			return list;
+		}();
+
+		return shard_list;
+	}
+
+	Executor *Executor::GetShard(size_t key)
+	{
+		auto &shard_list = GetShardList();
+
+		return shard_list[key % shard_list.size()];
+	}
+
+	size_t Executor::GetShardCount()
+	{
+		return GetShardList().size();
+	}
+
+	Executor::Executor(const char *name, size_t thread_count, int first_processor)
+		: _first_processor(first_processor)
+	{
+		thread_count = std::max<size_t>(thread_count, 1);
+
+		for (size_t index = 0; index < thread_count; index++)
+		{
+			_worker_list.push_back(std::make_unique<Worker>());
+		}
+
+		// Workers are started after all of them are created, because they steal from each other
+		for (size_t index = 0; index < thread_count; index++)
+		{
+			auto &worker = _worker_list[index];
+
+			worker->thread = std::thread(&Executor::WorkerThread, this, index);
+
+			// The name of a thread must be shorter than 16 characters
+			char thread_name[16];
+			::snprintf(thread_name, sizeof(thread_name), "%s%zu", name, index);
+			::pthread_setname_np(worker->thread.native_handle(), thread_name);
+		}
+
+		logtd("%s is started with %zu threads", name, thread_count);
+	}
+
+	Executor::~Executor()
+	{
+		Stop();
+	}
+
+	bool Executor::Post(Task task)
+	{
+		if (_stop)
+		{
+			return false;
+		}
+
+		// Keep the task in the current worker if possible, since the data it uses is likely to be in the cache
+		size_t index = (_current_executor == this) ? _current_index : (_next_index.fetch_add(1, std::memory_order_relaxed) % _worker_list.size());
+		auto &worker = _worker_list[index];
+
+		{
+			std::lock_guard<std::mutex> lock_guard(worker->mutex);
+			worker->task_queue.push_back(std::move(task));
+		}
+
+		// Must be increased before checking _idle_count (see WorkerThread())
+		_pending_count.fetch_add(1);
+
+		if (_idle_count.load() > 0)
+		{
+			std::lock_guard<std::mutex> lock_guard(_idle_mutex);
+			_idle_condition.notify_one();
+		}
+
+		return true;
+	}
+
+	void Executor::Stop()
+	{
+		if (_stop.exchange(true))
+		{
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock_guard(_idle_mutex);
+			_idle_condition.notify_all();
+		}
+
+		for (auto &worker : _worker_list)
+		{
+			if (worker->thread.joinable())
+			{
+				if (worker->thread.get_id() == std::this_thread::get_id())
+				{
+					// Stop() is called by a task
+					worker->thread.detach();
+				}
+				else
+				{
+					worker->thread.join();
+				}
+			}
+
+			std::lock_guard<std::mutex> lock_guard(worker->mutex);
+			worker->task_queue.clear();
+		}
+	}
+
+	bool Executor::PopTask(size_t index, Task &task)
+	{
+		auto &worker = _worker_list[index];
+		std::lock_guard<std::mutex> lock_guard(worker->mutex);
+
+		if (worker->task_queue.empty())
+		{
+			return false;
+		}
+
+		task = std::move(worker->task_queue.front());
+		worker->task_queue.pop_front();
+
+		return true;
+	}
+
+	bool Executor::StealTask(size_t index, Task &task)
+	{
+		auto count = _worker_list.size();
+
+		for (size_t offset = 1; offset < count; offset++)
+		{
+			auto &victim = _worker_list[(index + offset) % count];
+
+			// Don't wait for a busy victim, try the next one
+			std::unique_lock<std::mutex> lock(victim->mutex, std::try_to_lock);
+
+			if (lock.owns_lock() && (victim->task_queue.empty() == false))
+			{
+				// The owner takes tasks from the front, so steal from the back
+				task = std::move(victim->task_queue.back());
+				victim->task_queue.pop_back();
+
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void Executor::WorkerThread(size_t index)
+	{
+		_current_executor = this;
+		_current_index = index;
+
+		if ((_first_processor >= 0) && (Platform::SetThreadAffinity(_first_processor + static_cast<int>(index)) == false))
+		{
+			logtw("Could not pin worker #%zu to processor %zu", index, _first_processor + index);
+		}
+
+		Task task;
+
+		while (_stop == false)
+		{
+			if (PopTask(index, task) || StealTask(index, task))
+			{
+				_pending_count.fetch_sub(1);
+
+				task();
+				task = nullptr;
+
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(_idle_mutex);
+
+			_idle_count.fetch_add(1);
+
+			// Post() increases _pending_count before checking _idle_count, so either this worker sees the task,
+			// or Post() sees this worker and notifies it after wait() releases _idle_mutex
+			if ((_pending_count.load() == 0) && (_stop == false))
+			{
+				_idle_condition.wait_for(lock, std::chrono::milliseconds(OV_EXECUTOR_IDLE_TIMEOUT_MS));
+			}
+
+			_idle_count.fetch_sub(1);
+		}
+	}
+
+	Strand::Strand(Executor *executor)
+		: _state(std::make_shared<State>())
+	{
+		_state->executor = (executor != nullptr) ? executor : Executor::GetInstance();
+	}
+
+	Strand::~Strand()
+	{
+		Stop();
+	}
+
+	bool Strand::Post(Executor::Task task)
+	{
+		if (task == nullptr)
+		{
+			return false;
+		}
+
+		std::lock_guard<std::mutex> lock_guard(_state->mutex);
+
+		if (_state->stopped)
+		{
+			return false;
+		}
+
+		_state->task_queue.push_back(std::move(task));
+
+		if (_state->scheduled == false)
+		{
+			_state->scheduled = true;
+
+			auto state = _state;
+			_state->executor->Post([state]() { Run(state); });
+		}
+
+		return true;
+	}
+
+	void Strand::SetHandler(Executor::Task handler)
+	{
+		std::lock_guard<std::mutex> lock_guard(_state->mutex);
+
+		_state->handler = std::move(handler);
+	}
+
+	bool Strand::Notify()
+	{
+		if (_state->notified.exchange(true))
+		{
+			// The handler has not started yet, and it will process this request too
+			return true;
+		}
+
+		std::lock_guard<std::mutex> lock_guard(_state->mutex);
+
+		if (_state->stopped)
+		{
+			return false;
+		}
+
+		// An empty task means the handler
+		_state->task_queue.emplace_back();
+
+		if (_state->scheduled == false)
+		{
+			_state->scheduled = true;
+
+			auto state = _state;
+			_state->executor->Post([state]() { Run(state); });
+		}
+
+		return true;
+	}
+
+	void Strand::Stop()
+	{
+		std::unique_lock<std::mutex> lock(_state->mutex);
+
+		_state->stopped = true;
+		_state->task_queue.clear();
+
+		if (_state->running_thread_id == std::this_thread::get_id())
+		{
+			// Called by a task of this strand
+			return;
+		}
+
+		_state->idle_condition.wait(lock, [this]() -> bool {
+			return _state->running_thread_id == std::thread::id();
+		});
+	}
+
+	bool Strand::IsStopped() const
+	{
+		std::lock_guard<std::mutex> lock_guard(_state->mutex);
+
+		return _state->stopped;
+	}
+
+	bool Strand::IsCurrent() const
+	{
+		std::lock_guard<std::mutex> lock_guard(_state->mutex);
+
+		return _state->running_thread_id == std::this_thread::get_id();
+	}
+
+	void Strand::Run(const std::shared_ptr<State> &state)
+	{
+		std::unique_lock<std::mutex> lock(state->mutex);
+
+		state->running_thread_id = std::this_thread::get_id();
+
+		for (int count = 0; count < OV_STRAND_MAX_TASKS_PER_RUN; count++)
+		{
+			if (state->stopped || state->task_queue.empty())
+			{
+				state->scheduled = false;
+				state->running_thread_id = std::thread::id();
+				state->idle_condition.notify_all();
+
+				return;
+			}
+
+			auto task = std::move(state->task_queue.front());
+			state->task_queue.pop_front();
+
+			bool is_handler = (task == nullptr);
+
+			if (is_handler)
+			{
+				task = state->handler;
+				// Notify() after this point requests another run, because the handler may have passed the data already
+				state->notified = false;
+			}
+
+			lock.unlock();
+
+			if (task != nullptr)
+			{
+				task();
+			}
+
+			lock.lock();
+		}
+
+		state->running_thread_id = std::thread::id();
+		state->idle_condition.notify_all();
+
+		if (state->stopped || state->task_queue.empty())
+		{
+			state->scheduled = false;
+			return;
+		}
+
+		// Give the worker to the other tasks, and continue later
+		if (state->executor->Post([state]() { Run(state); }) == false)
+		{
+			state->scheduled = false;
+		}
+	}
+}  // namespace ov
@@ -0,0 +1,144 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2020 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// How long an idle worker sleeps before it looks for a task to steal again
+#define OV_EXECUTOR_IDLE_TIMEOUT_MS 100
+// A strand yields its worker after running this many tasks in a row, so the other strands are not starved
+#define OV_STRAND_MAX_TASKS_PER_RUN 64
+
+namespace ov
+{
+	// A process-wide pool of worker threads, sized to the number of processors.
+	//
+	// Each worker has its own task queue. Tasks posted from a worker go to the queue of that worker,
+	// and tasks posted from the other threads are distributed to the queues in round-robin order.
+	// A worker that has nothing to do steals tasks from the others before going to sleep.
+	//
+	// Tasks of an executor are not ordered. Use ov::Strand when the tasks must run one at a time in order.
+	// Tasks must not block for a long time (e.g. waiting for a network I/O), because the workers are shared.
+	class Executor
+	{
+	public:
+		using Task = std::function<void()>;
+
+		// The shared instance, which is created when it is used for the first time
+		static Executor *GetInstance();
+
+		// Single-threaded executors, one per processor, and each of them is pinned to its processor.
+		// Tasks posted to a shard always run on the same thread, so the objects owned by a shard
+		// (e.g. sessions) are touched by one core only. The same key always returns the same shard.
+		static Executor *GetShard(size_t key);
+		static size_t GetShardCount();
+
+		// If first_processor is not negative, the worker #n is pinned to the processor (first_processor + n)
+		Executor(const char *name, size_t thread_count, int first_processor = -1);
+		~Executor();
+
+		bool Post(Task task);
+
+		size_t GetThreadCount() const
+		{
+			return _worker_list.size();
+		}
+
+		// Running tasks are finished, and pending tasks are discarded
+		void Stop();
+
+	protected:
+		struct Worker
+		{
+			std::mutex mutex;
+			std::deque<Task> task_queue;
+			std::thread thread;
+		};
+
+		void WorkerThread(size_t index);
+		bool PopTask(size_t index, Task &task);
+		bool StealTask(size_t index, Task &task);
+
+		static thread_local Executor *_current_executor;
+		static thread_local size_t _current_index;
+
+		static const std::vector<Executor *> &GetShardList();
+
+		int _first_processor = -1;
+		std::vector<std::unique_ptr<Worker>> _worker_list;
+		std::atomic<size_t> _next_index{0};
+
+		// Number of tasks in all queues
+		std::atomic<size_t> _pending_count{0};
+
+		std::mutex _idle_mutex;
+		std::condition_variable _idle_condition;
+		std::atomic<int> _idle_count{0};
+
+		std::atomic<bool> _stop{false};
+	};
+
+	// Runs the posted tasks one at a time, in the order they are posted, on an Executor.
+	//
+	// A strand doesn't own a thread, so it costs almost nothing while it is idle.
+	// Use one strand per object that needed a dedicated thread only for ordering (e.g. per stream).
+	class Strand
+	{
+	public:
+		explicit Strand(Executor *executor = nullptr);
+		~Strand();
+
+		// Returns false if the strand is stopped
+		bool Post(Executor::Task task);
+
+		// The handler is run by Notify(). It must be set before Notify() is called.
+		void SetHandler(Executor::Task handler);
+		// Requests a run of the handler. Requests made before the handler starts are merged into one run,
+		// so the handler must process everything that is pending (e.g. drain a queue).
+		bool Notify();
+
+		// Pending tasks are discarded, and waits for the running task to finish
+		// (unless it is called from the task itself). Tasks posted after Stop() are ignored.
+		void Stop();
+
+		bool IsStopped() const;
+
+		// Returns true if the caller is a task of this strand
+		bool IsCurrent() const;
+
+	protected:
+		struct State
+		{
+			Executor *executor = nullptr;
+
+			std::mutex mutex;
+			std::condition_variable idle_condition;
+			// An empty task is a request to run the handler
+			std::deque<Executor::Task> task_queue;
+			Executor::Task handler;
+			std::atomic<bool> notified{false};
+
+			bool scheduled = false;
+			bool stopped = false;
+			std::thread::id running_thread_id;
+		};
+
+		static void Run(const std::shared_ptr<State> &state);
+
+		// Tasks keep the state alive, so the strand can be destroyed while a run is scheduled
+		std::shared_ptr<State> _state;
+	};
+}  // namespace ov
@@ -0,0 +1,474 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2020 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "log_async_writer.h"
+
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <cstdio>
+
+namespace ov
+{
+	static constexpr const char *NEW_LINE = "\n";
+
+	// LogWrite is not thread-safe, so the writer thread and WriteDirectly() must not write to a file at the same time.
+	// This is only contended while the writer thread is stopping.
+	static std::mutex g_log_file_mutex;
+
+	std::atomic<bool> LogAsyncWriter::_destroyed{false};
+	thread_local LogAsyncWriter::ThreadBufferHolder LogAsyncWriter::_thread_buffer;
+
+	LogAsyncWriter *LogAsyncWriter::GetInstance()
+	{
+		if (_destroyed)
+		{
+			return nullptr;
+		}
+
+		static LogAsyncWriter instance;
+
+		return &instance;
+	}
+
+	LogAsyncWriter::LogAsyncWriter()
+	{
+		// The writer thread does not survive fork(), so it is restarted by the next log in the child
+		::pthread_atfork(OnForkPrepare, OnForkParent, OnForkChild);
+	}
+
+	LogAsyncWriter::~LogAsyncWriter()
+	{
+		// From now on, logs are written by the calling threads
+		_destroyed = true;
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stop = true;
+		}
+		_wake_condition.notify_one();
+
+		if ((_thread != nullptr) && _thread->joinable())
+		{
+			_thread->join();
+		}
+
+		_running = false;
+	}
+
+	bool LogAsyncWriter::StartIfNeeded()
+	{
+		if (_running)
+		{
+			return true;
+		}
+
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		if (_running)
+		{
+			return true;
+		}
+
+		if (_stop)
+		{
+			return false;
+		}
+
+		try
+		{
+			_thread = std::make_unique<std::thread>(&LogAsyncWriter::WriterThread, this);
+			::pthread_setname_np(_thread->native_handle(), "LogWriter");
+		}
+		catch (const std::system_error &)
+		{
+			return false;
+		}
+
+		_running = true;
+
+		return true;
+	}
+
+	LogAsyncWriter::ThreadBuffer *LogAsyncWriter::GetThreadBuffer()
+	{
+		auto &holder = _thread_buffer;
+
+		if (holder.buffer == nullptr)
+		{
+			holder.buffer = std::make_shared<ThreadBuffer>();
+
+			std::lock_guard<std::mutex> lock(_buffer_list_mutex);
+			_buffer_list.push_back(holder.buffer);
+			_buffer_list_changed = true;
+		}
+
+		return holder.buffer.get();
+	}
+
+	bool LogAsyncWriter::Push(LogWrite *log_file, LogConsole console, const char *color_prefix, const char *color_suffix, const char *message, size_t length)
+	{
+		if (StartIfNeeded() == false)
+		{
+			WriteDirectly(log_file, console, color_prefix, color_suffix, message, length);
+			return true;
+		}
+
+		length = std::min<size_t>(length, OV_LOG_MAX_MESSAGE_LENGTH);
+
+		constexpr size_t capacity = OV_LOG_THREAD_BUFFER_SIZE;
+		auto buffer = GetThreadBuffer();
+
+		size_t head = buffer->head.load(std::memory_order_relaxed);
+		size_t tail = buffer->tail.load(std::memory_order_acquire);
+		size_t used = head - tail;
+
+		size_t offset = head % capacity;
+		size_t to_end = capacity - offset;
+		size_t record_size = GetRecordSize(length);
+		size_t required = (record_size > to_end) ? (to_end + record_size) : record_size;
+
+		if ((used + required) > capacity)
+		{
+			// The writer thread cannot keep up, and blocking here would put the I/O latency into the caller
+			_dropped_count.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		if (record_size > to_end)
+		{
+			// The reader skips the rest of the ring by itself if there is no room for a header
+			if (to_end >= sizeof(RecordHeader))
+			{
+				auto skip_header = reinterpret_cast<RecordHeader *>(buffer->data.get() + offset);
+				skip_header->skip = true;
+			}
+
+			head += to_end;
+			offset = 0;
+		}
+
+		auto header = reinterpret_cast<RecordHeader *>(buffer->data.get() + offset);
+
+		header->log_file = log_file;
+		header->color_prefix = color_prefix;
+		header->color_suffix = color_suffix;
+		header->length = static_cast<uint32_t>(length);
+		header->console = console;
+		header->skip = false;
+
+		::memcpy(header + 1, message, length);
+
+		buffer->head.store(head + record_size, std::memory_order_release);
+
+		// Do not wait for the next interval if the buffer is getting full
+		if ((used < (capacity / 2)) && ((used + required) >= (capacity / 2)))
+		{
+			RequestWake();
+		}
+
+		return true;
+	}
+
+	void LogAsyncWriter::RequestWake()
+	{
+		_wake_requested = true;
+		_wake_condition.notify_one();
+	}
+
+	void LogAsyncWriter::Flush(int timeout_msec)
+	{
+		if (_running == false)
+		{
+			return;
+		}
+
+		// The writer is idle while _mutex is held, so the next pass will see the lines
+		std::unique_lock<std::mutex> lock(_mutex);
+
+		auto target_generation = _drain_generation + 1;
+
+		_wake_requested = true;
+		_wake_condition.notify_one();
+
+		_flush_condition.wait_for(lock, std::chrono::milliseconds(timeout_msec), [this, target_generation]() -> bool {
+			return (_drain_generation >= target_generation) || (_running == false);
+		});
+	}
+
+	void LogAsyncWriter::WriteDirectly(LogWrite *log_file, LogConsole console, const char *color_prefix, const char *color_suffix, const char *message, size_t length)
+	{
+		if (console != LogConsole::None)
+		{
+			struct iovec iov[] = {
+				{const_cast<char *>(color_prefix), ::strlen(color_prefix)},
+				{const_cast<char *>(message), length},
+				{const_cast<char *>(color_suffix), ::strlen(color_suffix)},
+				{const_cast<char *>(NEW_LINE), 1}};
+
+			LogWrite::WriteVector((console == LogConsole::Stdout) ? STDOUT_FILENO : STDERR_FILENO, iov, 4);
+		}
+
+		if (log_file != nullptr)
+		{
+			struct iovec iov[] = {
+				{const_cast<char *>(message), length},
+				{const_cast<char *>(NEW_LINE), 1}};
+
+			std::lock_guard<std::mutex> lock(g_log_file_mutex);
+			log_file->Write(iov, 2);
+		}
+	}
+
+	void LogAsyncWriter::WriterThread()
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+
+		while (true)
+		{
+			bool stop = _stop;
+			_wake_requested = false;
+
+			auto written_count = DrainOnce();
+
+			_drain_generation++;
+			_flush_condition.notify_all();
+
+			if (stop)
+			{
+				break;
+			}
+
+			if (written_count == 0)
+			{
+				_wake_condition.wait_for(lock, std::chrono::milliseconds(OV_LOG_WRITER_INTERVAL_MS), [this]() -> bool {
+					return _stop || _wake_requested;
+				});
+			}
+		}
+	}
+
+	size_t LogAsyncWriter::DrainOnce()
+	{
+		{
+			std::lock_guard<std::mutex> lock(_buffer_list_mutex);
+
+			if (_buffer_list_changed)
+			{
+				_writer_buffer_list = _buffer_list;
+				_buffer_list_changed = false;
+			}
+		}
+
+		constexpr size_t capacity = OV_LOG_THREAD_BUFFER_SIZE;
+		size_t written_count = 0;
+		bool has_exited_buffer = false;
+
+		_writer_tail_list.resize(_writer_buffer_list.size());
+
+		for (size_t index = 0; index < _writer_buffer_list.size(); index++)
+		{
+			auto &buffer = _writer_buffer_list[index];
+
+			// Must be checked before loading the head, so no record can follow it
+			bool thread_exited = buffer->thread_exited;
+			size_t head = buffer->head.load(std::memory_order_acquire);
+			size_t tail = buffer->tail.load(std::memory_order_relaxed);
+
+			while (tail != head)
+			{
+				size_t offset = tail % capacity;
+				size_t to_end = capacity - offset;
+
+				auto header = reinterpret_cast<const RecordHeader *>(buffer->data.get() + offset);
+
+				if ((to_end < sizeof(RecordHeader)) || header->skip)
+				{
+					tail += to_end;
+					continue;
+				}
+
+				AppendRecord(header, reinterpret_cast<const char *>(header + 1));
+
+				tail += GetRecordSize(header->length);
+				written_count++;
+			}
+
+			_writer_tail_list[index] = tail;
+			has_exited_buffer = has_exited_buffer || thread_exited;
+		}
+
+		FlushConsole();
+
+		{
+			std::lock_guard<std::mutex> lock(g_log_file_mutex);
+
+			for (auto &destination : _destination_list)
+			{
+				if (destination.iov_list.empty() == false)
+				{
+					destination.log_file->Write(destination.iov_list.data(), static_cast<int>(destination.iov_list.size()));
+					destination.iov_list.clear();
+				}
+			}
+		}
+
+		auto dropped_count = _dropped_count.load(std::memory_order_relaxed);
+
+		if (dropped_count != _reported_dropped_count)
+		{
+			char message[128];
+			int length = ::snprintf(message, sizeof(message), "[LogAsyncWriter] %lu log line(s) were dropped because the writer could not keep up\n", dropped_count - _reported_dropped_count);
+
+			struct iovec iov = {message, static_cast<size_t>(length)};
+			LogWrite::WriteVector(STDERR_FILENO, &iov, 1);
+
+			_reported_dropped_count = dropped_count;
+		}
+
+		// The records can be overwritten only after they are written
+		for (size_t index = 0; index < _writer_buffer_list.size(); index++)
+		{
+			_writer_buffer_list[index]->tail.store(_writer_tail_list[index], std::memory_order_release);
+		}
+
+		if (has_exited_buffer)
+		{
+			std::lock_guard<std::mutex> lock(_buffer_list_mutex);
+
+			for (auto iterator = _buffer_list.begin(); iterator != _buffer_list.end();)
+			{
+				auto &buffer = *iterator;
+
+				if (buffer->thread_exited && (buffer->head.load() == buffer->tail.load()))
+				{
+					iterator = _buffer_list.erase(iterator);
+					_buffer_list_changed = true;
+				}
+				else
+				{
+					++iterator;
+				}
+			}
+		}
+
+		return written_count;
+	}
+
+	void LogAsyncWriter::AppendRecord(const RecordHeader *header, const char *message)
+	{
+		if (header->console != LogConsole::None)
+		{
+			int fd = (header->console == LogConsole::Stdout) ? STDOUT_FILENO : STDERR_FILENO;
+
+			if (fd != _console_fd)
+			{
+				FlushConsole();
+				_console_fd = fd;
+			}
+
+			_console_iov_list.push_back({const_cast<char *>(header->color_prefix), ::strlen(header->color_prefix)});
+			_console_iov_list.push_back({const_cast<char *>(message), header->length});
+			_console_iov_list.push_back({const_cast<char *>(header->color_suffix), ::strlen(header->color_suffix)});
+			_console_iov_list.push_back({const_cast<char *>(NEW_LINE), 1});
+		}
+
+		if (header->log_file != nullptr)
+		{
+			Destination *destination = nullptr;
+
+			for (auto &item : _destination_list)
+			{
+				if (item.log_file == header->log_file)
+				{
+					destination = &item;
+					break;
+				}
+			}
+
+			if (destination == nullptr)
+			{
+				destination = &(_destination_list.emplace_back());
+				destination->log_file = header->log_file;
+			}
+
+			destination->iov_list.push_back({const_cast<char *>(message), header->length});
+			destination->iov_list.push_back({const_cast<char *>(NEW_LINE), 1});
+		}
+	}
+
+	void LogAsyncWriter::FlushConsole()
+	{
+		if (_console_iov_list.empty() == false)
+		{
+			LogWrite::WriteVector(_console_fd, _console_iov_list.data(), static_cast<int>(_console_iov_list.size()));
+			_console_iov_list.clear();
+		}
+	}
+
+	void LogAsyncWriter::OnForkPrepare()
+	{
+		auto instance = GetInstance();
+
+		if (instance != nullptr)
+		{
+			// Wait until the writer thread is idle, so the child does not inherit a half-written state
+			instance->_mutex.lock();
+			instance->_buffer_list_mutex.lock();
+			g_log_file_mutex.lock();
+		}
+	}
+
+	void LogAsyncWriter::OnForkParent()
+	{
+		auto instance = GetInstance();
+
+		if (instance != nullptr)
+		{
+			g_log_file_mutex.unlock();
+			instance->_buffer_list_mutex.unlock();
+			instance->_mutex.unlock();
+		}
+	}
+
+	void LogAsyncWriter::OnForkChild()
+	{
+		auto instance = GetInstance();
+
+		if (instance == nullptr)
+		{
+			return;
+		}
+
+		// Only the forking thread exists in the child. The condition variables may still refer to
+		// the waiters of the parent, so they are recreated.
+		new (&(instance->_wake_condition)) std::condition_variable();
+		new (&(instance->_flush_condition)) std::condition_variable();
+
+		// The thread does not exist in the child, so it must not be joined or destroyed
+		instance->_thread.release();
+		instance->_running = false;
+		instance->_wake_requested = false;
+
+		for (auto &buffer : instance->_buffer_list)
+		{
+			// Pending lines are written by the parent
+			buffer->tail.store(buffer->head.load());
+
+			if (buffer != _thread_buffer.buffer)
+			{
+				buffer->thread_exited = true;
+			}
+		}
+
+		g_log_file_mutex.unlock();
+		instance->_buffer_list_mutex.unlock();
+		instance->_mutex.unlock();
+	}
+}  // namespace ov
@@ -0,0 +1,170 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2020 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <sys/uio.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "./log_write.h"
+
+// Size of the ring buffer that each logging thread owns
+#define OV_LOG_THREAD_BUFFER_SIZE (128 * 1024)
+// A message longer than this is truncated
+#define OV_LOG_MAX_MESSAGE_LENGTH (OV_LOG_THREAD_BUFFER_SIZE / 4)
+// How often the writer thread wakes up when nobody asks it to
+#define OV_LOG_WRITER_INTERVAL_MS 10
+
+namespace ov
+{
+	enum class LogConsole : uint8_t
+	{
+		None,
+		Stdout,
+		Stderr
+	};
+
+	// Moves file/console I/O of the logs off the calling threads.
+	//
+	// Each logging thread appends formatted lines to its own single-producer/single-consumer
+	// ring buffer without any lock. A single writer thread collects the lines of all buffers,
+	// and writes them with one writev() per destination.
+	//
+	// Logging never blocks: if the buffer of a thread is full, the line is dropped and counted.
+	// Lines of different threads are not ordered with each other.
+	class LogAsyncWriter
+	{
+	public:
+		// Returns nullptr after the instance is destroyed (while exiting the process)
+		static LogAsyncWriter *GetInstance();
+
+		~LogAsyncWriter();
+
+		// Returns false if the line is dropped
+		bool Push(LogWrite *log_file, LogConsole console, const char *color_prefix, const char *color_suffix, const char *message, size_t length);
+
+		// Waits until the lines pushed before this call are written
+		void Flush(int timeout_msec);
+
+		uint64_t GetDroppedCount() const
+		{
+			return _dropped_count;
+		}
+
+		// Used when the writer thread is not available
+		static void WriteDirectly(LogWrite *log_file, LogConsole console, const char *color_prefix, const char *color_suffix, const char *message, size_t length);
+
+	protected:
+		struct RecordHeader
+		{
+			// nullptr if the line is written only to the console
+			LogWrite *log_file;
+			const char *color_prefix;
+			const char *color_suffix;
+			uint32_t length;
+			LogConsole console;
+			// The record did not fit at the end of the ring, so the rest of the ring is skipped
+			bool skip;
+		};
+
+		struct ThreadBuffer
+		{
+			ThreadBuffer()
+				: data(new uint8_t[OV_LOG_THREAD_BUFFER_SIZE])
+			{
+			}
+
+			std::unique_ptr<uint8_t[]> data;
+
+			// Written only by the owner thread
+			alignas(64) std::atomic<size_t> head{0};
+			// Written only by the writer thread
+			alignas(64) std::atomic<size_t> tail{0};
+
+			std::atomic<bool> thread_exited{false};
+		};
+
+		struct ThreadBufferHolder
+		{
+			~ThreadBufferHolder()
+			{
+				if (buffer != nullptr)
+				{
+					buffer->thread_exited = true;
+				}
+			}
+
+			std::shared_ptr<ThreadBuffer> buffer;
+		};
+
+		struct Destination
+		{
+			LogWrite *log_file;
+			std::vector<struct iovec> iov_list;
+		};
+
+		static constexpr size_t GetRecordSize(size_t length)
+		{
+			// Keep RecordHeader aligned
+			return (sizeof(RecordHeader) + length + 7) & ~static_cast<size_t>(7);
+		}
+
+		LogAsyncWriter();
+
+		ThreadBuffer *GetThreadBuffer();
+		bool StartIfNeeded();
+
+		void WriterThread();
+		// Returns the number of lines written
+		size_t DrainOnce();
+		void AppendRecord(const RecordHeader *header, const char *message);
+		void FlushConsole();
+		void RequestWake();
+
+		static void OnForkPrepare();
+		static void OnForkParent();
+		static void OnForkChild();
+
+		static std::atomic<bool> _destroyed;
+		static thread_local ThreadBufferHolder _thread_buffer;
+
+		// Held by the writer thread while it is writing, so holding it means that the writer is idle
+		std::mutex _mutex;
+		std::condition_variable _wake_condition;
+		std::condition_variable _flush_condition;
+		// A lost wake-up only delays the lines until the next interval, so producers don't take _mutex
+		std::atomic<bool> _wake_requested{false};
+		uint64_t _drain_generation = 0;
+
+		std::mutex _buffer_list_mutex;
+		std::vector<std::shared_ptr<ThreadBuffer>> _buffer_list;
+		bool _buffer_list_changed = false;
+
+		// Used only by the writer thread
+		std::vector<std::shared_ptr<ThreadBuffer>> _writer_buffer_list;
+		std::vector<size_t> _writer_tail_list;
+		std::vector<Destination> _destination_list;
+		// Console lines are written in order, so they are flushed whenever the stream (stdout/stderr) changes
+		int _console_fd = -1;
+		std::vector<struct iovec> _console_iov_list;
+		uint64_t _reported_dropped_count = 0;
+
+		// std::thread is kept on the heap, because it cannot be destroyed in a forked child
+		std::unique_ptr<std::thread> _thread;
+		std::atomic<bool> _running{false};
+		bool _stop = false;
+
+		std::atomic<uint64_t> _dropped_count{0};
+	};
+}  // namespace ov
@@ -8,6 +8,9 @@
 //==============================================================================
 #include "log_internal.h"
 
+#include <pthread.h>
+#include <string.h>
+
 #define OV_LOG_COLOR_RESET "\x1B[0m"
 
 #define OV_LOG_COLOR_FG_BLACK "\x1B[30m"
@@ -48,10 +51,33 @@
 
 namespace ov
 {
+	// Formatted date/time of the current second, so localtime_r() is called at most once per second per thread
+	struct LogTimeCache
+	{
+		std::time_t second = -1;
+		char text[32]{};
+	};
+
+	static thread_local LogTimeCache g_log_time_cache;
+	static thread_local int64_t g_log_thread_id = 0;
+
+	static void ResetThreadIdOnFork()
+	{
+		// The forking thread has a different id in the child
+		g_log_thread_id = 0;
+	}
+
 	LogInternal::LogInternal(std::string log_file_name) noexcept
 		: _level(OVLogLevelDebug),
 		  _log_file(log_file_name)
 	{
+		static std::once_flag atfork_flag;
+		std::call_once(atfork_flag, []() {
+			::pthread_atfork(nullptr, nullptr, ResetThreadIdOnFork);
+		});
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		ResetEnableCache();
 	}
 
 	void LogInternal::SetLogLevel(OVLogLevel level)
@@ -59,70 +85,126 @@ namespace ov
 		_level = level;
 	}
 
+	void LogInternal::ResetEnableCache()
+	{
+		auto cache = std::make_unique<EnableCache>();
+
+		_enable_cache = cache.get();
+		_enable_cache_list.push_back(std::move(cache));
+	}
+
 	void LogInternal::ResetEnable()
 	{
 		std::lock_guard<std::mutex> lock(_mutex);
 
-		_enable_map.clear();
-
 		_enable_list.clear();
+
+		ResetEnableCache();
 	}
 
-	bool LogInternal::IsEnabled(const char *tag, OVLogLevel level)
+	const LogInternal::CachedEnableItem *LogInternal::FindCachedEnableItem(const char *tag, size_t hash) const
 	{
-		std::lock_guard<std::mutex> lock(_mutex);
-
-		auto item = _enable_map.find(tag);
+		auto cache = _enable_cache.load(std::memory_order_acquire);
 
-		if (item == _enable_map.cend())
+		for (size_t count = 0, index = hash % EnableCache::Capacity; count < EnableCache::Capacity; count++, index = (index + 1) % EnableCache::Capacity)
 		{
-			// If there is no cached item, it finds a item in _enable_list that matches regular expression
-			for (const auto &enable_item : _enable_list)
-			{
-				if (std::regex_match(tag, *(enable_item.regex.get())))
-				{
-					_enable_map[tag] = enable_item;
+			auto item = cache->items[index].load(std::memory_order_acquire);
 
-					break;
-				}
+			if (item == nullptr)
+			{
+				break;
 			}
 
-			item = _enable_map.find(tag);
-
-			if (item == _enable_map.cend())
+			if ((item->hash == hash) && (item->tag == tag))
 			{
-				// If there is no match in the regular expression, info level is enabled (default)
-				_enable_map[tag] = (EnableItem){
-					.regex = nullptr,
-					.level = OVLogLevelInformation,
-					.is_enabled = true};
+				return item;
 			}
+		}
 
-			item = _enable_map.find(tag);
+		return nullptr;
+	}
 
-			if (item == _enable_map.cend())
+	const LogInternal::CachedEnableItem *LogInternal::AddCachedEnableItem(const char *tag, size_t hash)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		// Another thread might have added it
+		auto found_item = FindCachedEnableItem(tag, hash);
+
+		if (found_item != nullptr)
+		{
+			return found_item;
+		}
+
+		auto new_item = std::make_unique<CachedEnableItem>();
+
+		new_item->tag = tag;
+		new_item->hash = hash;
+		// If there is no match in the regular expression, info level is enabled (default)
+		new_item->level = OVLogLevelInformation;
+		new_item->is_enabled = true;
+
+		// Find a item in _enable_list that matches regular expression
+		for (const auto &enable_item : _enable_list)
+		{
+			if (std::regex_match(tag, *(enable_item.regex.get())))
 			{
-				// Item must be added
-				OV_ASSERT2(false);
-				return false;
+				new_item->level = enable_item.level;
+				new_item->is_enabled = enable_item.is_enabled;
+
+				break;
 			}
 		}
 
-		if (level >= item->second.level)
+		auto cache = _enable_cache.load(std::memory_order_relaxed);
+
+		// Keep some empty slots to bound the probing
+		if ((cache->item_list.size() * 4) >= (EnableCache::Capacity * 3))
+		{
+			ResetEnableCache();
+			cache = _enable_cache.load(std::memory_order_relaxed);
+		}
+
+		size_t index = hash % EnableCache::Capacity;
+
+		while (cache->items[index].load(std::memory_order_relaxed) != nullptr)
+		{
+			index = (index + 1) % EnableCache::Capacity;
+		}
+
+		auto item = new_item.get();
+
+		cache->item_list.push_back(std::move(new_item));
+		cache->items[index].store(item, std::memory_order_release);
+
+		return item;
+	}
+
+	bool LogInternal::IsEnabled(const char *tag, OVLogLevel level)
+	{
+		auto hash = std::hash<std::string_view>()(tag);
+		auto item = FindCachedEnableItem(tag, hash);
+
+		if (item == nullptr)
+		{
+			item = AddCachedEnableItem(tag, hash);
+		}
+
+		if (level >= item->level)
 		{
 			// Returns whether the log level for the tag is activated
-			return item->second.is_enabled;
+			return item->is_enabled;
 		}
 
 		// Levels below level behave as opposed to being activated
-		return (item->second.is_enabled == false);
+		return (item->is_enabled == false);
 	}
 
 	bool LogInternal::SetEnable(const char *tag_regex, OVLogLevel level, bool is_enabled)
 	{
 		std::lock_guard<std::mutex> lock(_mutex);
 
-		_enable_map.clear();
+		ResetEnableCache();
 
 		try
 		{
@@ -157,7 +239,12 @@ namespace ov
 
 	int64_t LogInternal::GetThreadId()
 	{
-		return (int64_t)::syscall(SYS_gettid);
+		if (g_log_thread_id == 0)
+		{
+			g_log_thread_id = (int64_t)::syscall(SYS_gettid);
+		}
+
+		return g_log_thread_id;
 	}
 
 	void LogInternal::Log(bool show_format, OVLogLevel level, const char *tag, const char *file, int line, const char *method, const char *format, va_list &arg_list)
@@ -205,27 +292,33 @@ namespace ov
 			OV_LOG_COLOR_RESET};
 
 		// Obtain current time in milliseconds
-		auto current = std::chrono::system_clock::now();
-		auto mseconds = std::chrono::duration_cast<std::chrono::milliseconds>(current.time_since_epoch()).count() % 1000;
-
-		// Obtain current hours/minutes/seconds
-		std::time_t time = std::time(nullptr);
-		std::tm localTime{};
-		::localtime_r(&time, &localTime);
+		struct timespec current;
+		::clock_gettime(CLOCK_REALTIME, &current);
+		auto mseconds = static_cast<int>(current.tv_nsec / 1000000);
 
-		ov::String log;
-
-#if OV_LOG_SHOW_FILE_NAME
-		ov::String fileName = file;
+		// Obtain current date/time, which is formatted only when the second is changed
+		auto &time_cache = g_log_time_cache;
 
+		if (time_cache.second != current.tv_sec)
 		{
-			ssize_t position = fileName.IndexOfRev('/');
+			std::tm localTime{};
+			::localtime_r(&current.tv_sec, &localTime);
 
-			if (position >= 0)
-			{
-				fileName = fileName.Substring(position + 1);
-			}
+#if DEBUG
+			// In DEBUG mode, the year is not displayed
+			::strftime(time_cache.text, sizeof(time_cache.text), "%m-%d %H:%M:%S", &localTime);
+#else	// DEBUG
+			::strftime(time_cache.text, sizeof(time_cache.text), "%Y-%m-%d %H:%M:%S", &localTime);
+#endif	// DEBUG
+
+			time_cache.second = current.tv_sec;
 		}
+
+		ov::String log;
+
+#if OV_LOG_SHOW_FILE_NAME
+		const char *fileName = ::strrchr(file, '/');
+		fileName = (fileName != nullptr) ? (fileName + 1) : file;
 #endif	// OV_LOG_SHOW_FILE_NAME
 
 #if OV_LOG_SHOW_FUNCTION_NAME
@@ -256,17 +349,8 @@ namespace ov
 				""
 				// color
 				"%s"
-#if DEBUG
-				// In DEBUG mode, the year is not displayed
-				"["
-#else	// DEBUG
-
-				// date,
-				"[%04d-"
-#endif	// DEBUG
-
-				// time ([mm-dd hh:mm:ss.sss])
-				"%02d-%02d %02d:%02d:%02d.%03d]"
+				// date, time ([yyyy-mm-dd hh:mm:ss.sss])
+				"[%s.%03d]"
 
 				// <log level>
 				" %s"
@@ -286,19 +370,14 @@ namespace ov
 #endif	// OV_LOG_SHOW_FUNCTION_NAME
 				,
 				"",
-#if DEBUG
-				localTime.tm_mon + 1, localTime.tm_mday,
-#else	// DEBUG
-				1900 + localTime.tm_year, localTime.tm_mon + 1, localTime.tm_mday,
-#endif	// DEBUG
-				localTime.tm_hour, localTime.tm_min, localTime.tm_sec, mseconds,
+				time_cache.text, mseconds,
 				log_level[level],
 				GetThreadId(),
 				(tag[0] == '\0') ? "" : " ", tag
 
 #if OV_LOG_SHOW_FILE_NAME
 				,
-				fileName.CStr(), line
+				fileName, line
 #endif	// OV_LOG_SHOW_FILE_NAME
 #if OV_LOG_SHOW_FUNCTION_NAME
 				,
@@ -309,21 +388,31 @@ namespace ov
 
 		// Append messages
 		log.AppendVFormat(format, &(arg_list[0]));
+
+		LogConsole console = LogConsole::None;
+
 		if (show_format)
 		{
-			if (level < OVLogLevelWarning)
-			{
-				fprintf(stdout, "%s%s%s\n", color_prefix[level], log.CStr(), color_suffix[level]);
-				fflush(stdout);
-			}
-			else
-			{
-				fprintf(stderr, "%s%s%s\n", color_prefix[level], log.CStr(), color_suffix[level]);
-				fflush(stderr);
-			}
+			console = (level < OVLogLevelWarning) ? LogConsole::Stdout : LogConsole::Stderr;
 		}
 
-		_log_file.Write(log.CStr());
+		// The console and the file are written by the writer thread
+		auto writer = LogAsyncWriter::GetInstance();
+
+		if (writer == nullptr)
+		{
+			// The process is exiting
+			LogAsyncWriter::WriteDirectly(&_log_file, console, color_prefix[level], color_suffix[level], log.CStr(), log.GetLength());
+			return;
+		}
+
+		writer->Push(&_log_file, console, color_prefix[level], color_suffix[level], log.CStr(), log.GetLength());
+
+		if (level == OVLogLevelCritical)
+		{
+			// The process may be aborted right after a critical log
+			writer->Flush(1000);
+		}
 	}
 
 	void LogInternal::SetLogPath(const char *log_path)
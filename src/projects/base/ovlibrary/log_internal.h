@@ -12,14 +12,19 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <atomic>
 #include <chrono>
 #include <cstdio>
 #include <ctime>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <regex>
+#include <vector>
 
 #include "./assert.h"
 #include "./log.h"
+#include "./log_async_writer.h"
 #include "./log_write.h"
 #include "./string.h"
 
@@ -68,12 +73,6 @@ namespace ov
 		void SetLogPath(const char *log_path);
 
 	protected:
-		OVLogLevel _level;
-
-		std::mutex _mutex;
-
-		LogWrite _log_file;
-
 		struct EnableItem
 		{
 			std::shared_ptr<std::regex> regex;
@@ -82,11 +81,42 @@ namespace ov
 			ov::String regex_string;
 		};
 
+		// Result of matching a tag against _enable_list
+		struct CachedEnableItem
+		{
+			ov::String tag;
+			size_t hash;
+			OVLogLevel level;
+			bool is_enabled;
+		};
+
+		// Fixed size open addressing table, so it can be looked up without any lock.
+		// Items are only added (under _mutex), and the whole table is replaced when the rules are changed.
+		struct EnableCache
+		{
+			static constexpr size_t Capacity = 1024;
+
+			std::atomic<const CachedEnableItem *> items[Capacity]{};
+			std::vector<std::unique_ptr<CachedEnableItem>> item_list;
+		};
+
+		const CachedEnableItem *FindCachedEnableItem(const char *tag, size_t hash) const;
+		const CachedEnableItem *AddCachedEnableItem(const char *tag, size_t hash);
+		// Must be called while _mutex is locked
+		void ResetEnableCache();
+
+		std::atomic<OVLogLevel> _level;
+
+		std::mutex _mutex;
+
+		LogWrite _log_file;
+
 		std::vector<EnableItem> _enable_list;
 
-		// This map used for cache (It reduces regex matching cost)
-		// key: tag
-		// value: is_enabled
-		std::map<ov::String, EnableItem> _enable_map;
+		// This cache reduces regex matching cost
+		std::atomic<EnableCache *> _enable_cache;
+		// Replaced caches are kept until LogInternal is destroyed, because other threads may still be reading them.
+		// They are only replaced when the configuration is (re)loaded.
+		std::vector<std::unique_ptr<EnableCache>> _enable_cache_list;
 	};
-}  // namespace ov
\ No newline at end of file
+}  // namespace ov
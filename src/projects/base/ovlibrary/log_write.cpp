@@ -7,11 +7,16 @@
 //
 //==============================================================================
 
-#include <iostream>
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
 #include <iomanip>
 #include <memory>
 #include <sstream>
-#include <sys/stat.h>
+#include <vector>
 
 #include "log_write.h"
 
@@ -20,7 +25,10 @@ namespace ov
     bool LogWrite::_start_service = false;
 
     LogWrite::LogWrite(std::string log_file_name) :
+        _log_fd(-1),
         _last_day(0),
+        _last_check_time(0),
+        _path_changed(false),
         _log_path(OV_LOG_DIR)
     {
         if(log_file_name.empty())
@@ -35,10 +43,22 @@ namespace ov
         _log_file = _log_path + std::string("/") + log_file_name;
     }
 
+    LogWrite::~LogWrite()
+    {
+        if (_log_fd >= 0)
+        {
+            ::close(_log_fd);
+        }
+    }
+
     void LogWrite::SetLogPath(const char* log_path)
     {
+        std::lock_guard<std::mutex> lock_guard(_log_path_mutex);
+
         _log_path = log_path;
         _log_file = log_path + std::string("/") + _log_file_name;
+
+        _path_changed = true;
     }
 
     void LogWrite::Initialize()
@@ -51,15 +71,21 @@ namespace ov
             _start_service = false;
         }
 
+        std::lock_guard<std::mutex> lock_guard(_log_path_mutex);
+
+        if (_log_fd >= 0)
+        {
+            ::close(_log_fd);
+            _log_fd = -1;
+        }
+
         if ((::mkdir(_log_path.c_str(), 0755) == -1) && errno != EEXIST)
         {
             return;
         }
 
-        std::lock_guard<std::mutex> lock_guard(_log_stream_mutex);
-        _log_stream.close();
-        _log_stream.clear();
-        _log_stream.open(_log_file, std::ofstream::out | std::ofstream::app);
+        _log_fd = ::open(_log_file.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        _path_changed = false;
     }
 
     void LogWrite::Initialize(bool start_service)
@@ -67,9 +93,17 @@ namespace ov
         _start_service = start_service;
     }
 
-    void LogWrite::Write(const char *log)
+    void LogWrite::CheckLogFile()
     {
         std::time_t time = std::time(nullptr);
+
+        if ((time == _last_check_time) && (_path_changed == false))
+        {
+            return;
+        }
+
+        _last_check_time = time;
+
         std::tm localTime {};
         ::localtime_r(&time, &localTime);
 
@@ -79,6 +113,8 @@ namespace ov
         {
             if (_last_day)
             {
+                std::lock_guard<std::mutex> lock_guard(_log_path_mutex);
+
                 std::ostringstream logfile;
                 logfile << _log_file << "." << std::put_time(&localTime, "%Y%m%d");
                 ::rename(_log_file.c_str(), logfile.str().c_str());
@@ -86,14 +122,75 @@ namespace ov
             _last_day = localTime.tm_mday;
         }
 
-        struct stat file_stat {};
-        if (!_log_stream.is_open() || _log_stream.fail() || ::stat(_log_file.c_str(), &file_stat) != 0)
+        bool need_to_open = (_log_fd < 0) || _path_changed.exchange(false);
+
+        if (need_to_open == false)
+        {
+            // Reopen the file if it was removed or renamed (by logrotate, or the rotation above)
+            std::lock_guard<std::mutex> lock_guard(_log_path_mutex);
+
+            struct stat file_stat {};
+            need_to_open = (::stat(_log_file.c_str(), &file_stat) != 0);
+        }
+
+        if (need_to_open)
         {
             Initialize();
         }
+    }
+
+    void LogWrite::Write(const struct iovec *iov, int count)
+    {
+        CheckLogFile();
+
+        if (_log_fd < 0)
+        {
+            return;
+        }
+
+        if (WriteVector(_log_fd, iov, count) == false)
+        {
+            // Try to reopen the file at the next check
+            ::close(_log_fd);
+            _log_fd = -1;
+        }
+    }
+
+    bool LogWrite::WriteVector(int fd, const struct iovec *iov, int count)
+    {
+        // writev() may write only a part of iov, so the remaining entries are adjusted on a copy
+        std::vector<struct iovec> remaining(iov, iov + count);
+        size_t index = 0;
+
+        while (index < remaining.size())
+        {
+            int chunk_count = static_cast<int>(std::min<size_t>(remaining.size() - index, IOV_MAX));
+            ssize_t written = ::writev(fd, remaining.data() + index, chunk_count);
+
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                return false;
+            }
+
+            // Skip the iovecs that were written completely
+            while ((index < remaining.size()) && (static_cast<size_t>(written) >= remaining[index].iov_len))
+            {
+                written -= remaining[index].iov_len;
+                index++;
+            }
+
+            if (written > 0)
+            {
+                remaining[index].iov_base = static_cast<char *>(remaining[index].iov_base) + written;
+                remaining[index].iov_len -= written;
+            }
+        }
 
-        std::lock_guard<std::mutex> lock_guard(_log_stream_mutex);
-        _log_stream << log << std::endl;
-        _log_stream.flush();
+        return true;
     }
-}
\ No newline at end of file
+}
@@ -8,8 +8,12 @@
 //==============================================================================
 #pragma once
 
-#include <fstream>
+#include <sys/uio.h>
+
+#include <atomic>
+#include <ctime>
 #include <mutex>
+#include <string>
 
 #define OV_LOG_DIR              "logs"
 #define OV_LOG_DIR_SVC          "/var/log/ovenmediaengine"
@@ -27,18 +31,28 @@ namespace ov
     {
     public:
         LogWrite(std::string log_file_name);
-        virtual ~LogWrite() = default;
-        void Write(const char* log);
+        virtual ~LogWrite();
+
+        // Must be called by one thread at a time (LogAsyncWriter's thread)
+        void Write(const struct iovec *iov, int count);
         void SetLogPath(const char* log_path);
 
         static void Initialize(bool start_service);
 
+        // Writes all of iov to fd, handling partial writes and IOV_MAX
+        static bool WriteVector(int fd, const struct iovec *iov, int count);
+
     private:
         void Initialize();
+        void CheckLogFile();
 
-        std::mutex _log_stream_mutex;
-        std::ofstream _log_stream;
+        // Protects _log_path and _log_file, which can be changed by SetLogPath() while the writer is running
+        std::mutex _log_path_mutex;
+        int _log_fd;
         int _last_day;
+        // ::stat() and the day rotation are checked at most once per second
+        std::time_t _last_check_time;
+        std::atomic<bool> _path_changed;
         std::string _log_path;
         std::string _log_file_name;
         std::string _log_file;
@@ -46,4 +60,3 @@ namespace ov
         static bool _start_service;
     };
 }
-
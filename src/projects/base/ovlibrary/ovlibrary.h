@@ -12,6 +12,7 @@
 
 #include "./assert.h"
 #include "./bps_calculator.h"
+#include "./buffer_pool.h"
 #include "./byte_ordering.h"
 #include "./byte_stream.h"
 #include "./clock.h"
@@ -20,6 +21,7 @@
 #include "./dump_utilities.h"
 #include "./enable_shared_from_this.h"
 #include "./error.h"
+#include "./executor.h"
 #include "./json.h"
 #include "./log.h"
 #include "./memory_utilities.h"
@@ -28,10 +30,13 @@
 #include "./platform.h"
 #include "./queue.h"
 #include "./random.h"
+#include "./ring_queue.h"
 #include "./semaphore.h"
 #include "./singleton.h"
 #include "./stack_trace.h"
 #include "./stop_watch.h"
+#include "./striped_map.h"
 #include "./string.h"
+#include "./timer_wheel.h"
 #include "./url.h"
 #include "./bit_writer.h"
\ No newline at end of file
@@ -13,6 +13,8 @@
 #include <zconf.h>
 #include <pthread.h>
 
+#include <thread>
+
 namespace ov
 {
 	std::string Platform::GetName()
@@ -35,6 +37,32 @@ namespace ov
 		return static_cast<uint64_t>(::syscall(SYS_gettid));
 #else
 		return 0ULL;
+#endif
+	}
+
+	int Platform::GetProcessorCount()
+	{
+		auto count = ::sysconf(_SC_NPROCESSORS_ONLN);
+
+		if (count <= 0)
+		{
+			count = std::thread::hardware_concurrency();
+		}
+
+		return (count > 0) ? static_cast<int>(count) : 1;
+	}
+
+	bool Platform::SetThreadAffinity(int processor_index)
+	{
+#if IS_LINUX
+		cpu_set_t cpu_set;
+
+		CPU_ZERO(&cpu_set);
+		CPU_SET(processor_index % GetProcessorCount(), &cpu_set);
+
+		return (::pthread_setaffinity_np(::pthread_self(), sizeof(cpu_set), &cpu_set) == 0);
+#else
+		return false;
 #endif
 	}
 }
\ No newline at end of file
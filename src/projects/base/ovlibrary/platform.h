@@ -104,5 +104,10 @@ namespace ov
 		static std::string GetName();
 		static uint64_t GetProcessId();
 		static uint64_t GetThreadId();
+
+		// Number of the processors currently online
+		static int GetProcessorCount();
+		// Pin the calling thread to the processor (Linux only)
+		static bool SetThreadAffinity(int processor_index);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,525 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2020 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#if defined(__APPLE__)
+#	include <condition_variable>
+#	include <mutex>
+#else
+#	include <linux/futex.h>
+#	include <sys/syscall.h>
+#	include <unistd.h>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "./dump_utilities.h"
+#include "./log.h"
+#include "./ovdata_structure.h"
+#include "./stop_watch.h"
+#include "./string.h"
+
+namespace ov
+{
+	// A bounded, lock-free alternative to ov::Queue for hot paths.
+	//
+	// Items are stored in a power-of-two ring of cells, each tagged with a sequence number
+	// (Dmitry Vyukov's bounded MPMC queue), so any number of producers and consumers may be used.
+	// In OME it is used as a MPSC or SPSC queue.
+	//
+	// Consumers sleep on a futex (a condition variable on macOS). Producers only issue a wake-up when the queue goes from
+	// empty to non-empty and somebody is actually waiting, so a busy queue costs no system calls.
+	//
+	// When the ring is full, Enqueue() sleeps until a consumer releases a slot (back pressure),
+	// and TryEnqueue() returns false instead.
+	template <typename T>
+	class RingQueue
+	{
+	public:
+		static constexpr size_t DefaultCapacity = 1024;
+
+		RingQueue()
+			: RingQueue(nullptr)
+		{
+		}
+
+		RingQueue(const char *alias, size_t threshold = 0, size_t capacity = DefaultCapacity, int log_interval_in_msec = 5000)
+			: _threshold(threshold),
+			  _log_interval(log_interval_in_msec)
+		{
+			size_t ring_size = 2;
+
+			while ((ring_size < capacity) || (ring_size < threshold))
+			{
+				ring_size <<= 1;
+			}
+
+			_mask = ring_size - 1;
+			_cells = std::make_unique<Cell[]>(ring_size);
+
+			for (size_t index = 0; index < ring_size; index++)
+			{
+				_cells[index].sequence.store(index, std::memory_order_relaxed);
+			}
+
+			SetAlias(alias);
+
+			_last_log_time.Start();
+
+			auto shared_lock = std::shared_lock(_name_mutex);
+			logd("ov.RingQueue", "[%p] %s is created with capacity: %zu, threshold: %zu, interval: %d", this, _queue_name.CStr(), ring_size, threshold, log_interval_in_msec);
+		}
+
+		~RingQueue()
+		{
+			auto shared_lock = std::shared_lock(_name_mutex);
+			logd("ov.RingQueue", "[%p] %s is destroyed", this, _queue_name.CStr());
+		}
+
+		String GetAlias() const
+		{
+			auto shared_lock = std::shared_lock(_name_mutex);
+			return _queue_name;
+		}
+
+		void SetAlias(const char *alias)
+		{
+			auto lock_guard = std::lock_guard(_name_mutex);
+
+			if ((alias != nullptr) && (alias[0] != '\0'))
+			{
+				_queue_name = alias;
+			}
+			else
+			{
+				_queue_name.Format("RingQueue<%s>", Demangle(typeid(T).name()).CStr());
+			}
+
+			logd("ov.RingQueue", "[%p] The alias is changed to %s", this, _queue_name.CStr());
+		}
+
+		size_t GetCapacity() const
+		{
+			return _mask + 1;
+		}
+
+		// Returns false only if the queue is stopped while waiting for a free slot
+		bool Enqueue(const T &item)
+		{
+			return EnqueueInternal(item);
+		}
+
+		bool Enqueue(T &&item)
+		{
+			return EnqueueInternal(std::move(item));
+		}
+
+		// Returns false if the queue is full. The item is not consumed in that case.
+		template <typename U>
+		bool TryEnqueue(U &&item)
+		{
+			size_t position = _enqueue_position.load(std::memory_order_relaxed);
+			Cell *cell;
+
+			while (true)
+			{
+				cell = &(_cells[position & _mask]);
+
+				auto sequence = cell->sequence.load(std::memory_order_acquire);
+				auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+				if (diff == 0)
+				{
+					if (_enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					{
+						break;
+					}
+				}
+				else if (diff < 0)
+				{
+					// The ring is full
+					return false;
+				}
+				else
+				{
+					// Another producer took this cell
+					position = _enqueue_position.load(std::memory_order_relaxed);
+				}
+			}
+
+			cell->value.emplace(std::forward<U>(item));
+			cell->sequence.store(position + 1, std::memory_order_release);
+
+			auto prev_size = _size.fetch_add(1);
+
+			CheckThreshold(prev_size + 1);
+
+			if ((prev_size == 0) && (_waiters.load() > 0))
+			{
+				WakeUp(_wake_sequence);
+			}
+
+			return true;
+		}
+
+		// Returns an item immediately if there is one
+		std::optional<T> TryDequeue()
+		{
+			size_t position = _dequeue_position.load(std::memory_order_relaxed);
+			Cell *cell;
+
+			while (true)
+			{
+				cell = &(_cells[position & _mask]);
+
+				auto sequence = cell->sequence.load(std::memory_order_acquire);
+				auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+
+				if (diff == 0)
+				{
+					if (_dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					{
+						break;
+					}
+				}
+				else if (diff < 0)
+				{
+					// The ring is empty (or the producer of this cell has not published it yet)
+					return {};
+				}
+				else
+				{
+					position = _dequeue_position.load(std::memory_order_relaxed);
+				}
+			}
+
+			std::optional<T> value = std::move(cell->value);
+			cell->value.reset();
+			cell->sequence.store(position + _mask + 1, std::memory_order_release);
+
+			_size.fetch_sub(1);
+
+			if (_space_waiters.load() > 0)
+			{
+				WakeUp(_space_sequence);
+			}
+
+			return value;
+		}
+
+		// Timeout in milliseconds
+		std::optional<T> Dequeue(int timeout = Infinite)
+		{
+			// Calculated only when the consumer has to sleep
+			std::chrono::steady_clock::time_point expire;
+
+			while (_stop.load() == false)
+			{
+				auto value = TryDequeue();
+
+				if (value.has_value())
+				{
+					return value;
+				}
+
+				if (_size.load() > 0)
+				{
+					// A producer has claimed the head cell, but has not published it yet
+					std::this_thread::yield();
+					continue;
+				}
+
+				if (WaitForItem(timeout, expire) == false)
+				{
+					// timed out
+					break;
+				}
+			}
+
+			return {};
+		}
+
+		// Waits for the first item like Dequeue(), and then moves up to max_count items that are
+		// already in the queue into items without waiting.
+		//
+		// Returns the number of items appended to items
+		size_t DequeueBatch(std::vector<T> &items, size_t max_count, int timeout = Infinite)
+		{
+			if (max_count == 0)
+			{
+				return 0;
+			}
+
+			auto first = Dequeue(timeout);
+
+			if (first.has_value() == false)
+			{
+				return 0;
+			}
+
+			items.push_back(std::move(first.value()));
+
+			size_t count = 1;
+
+			while (count < max_count)
+			{
+				auto value = TryDequeue();
+
+				if (value.has_value() == false)
+				{
+					break;
+				}
+
+				items.push_back(std::move(value.value()));
+				count++;
+			}
+
+			return count;
+		}
+
+		bool IsEmpty() const
+		{
+			return (_size.load() == 0);
+		}
+
+		// Must not be called while consumers are running
+		void Clear()
+		{
+			while (TryDequeue().has_value())
+			{
+			}
+		}
+
+		size_t Size() const
+		{
+			return _size.load();
+		}
+
+		bool IsStopped() const
+		{
+			return _stop.load();
+		}
+
+		void Stop()
+		{
+			_stop.store(true);
+
+			WakeUp(_wake_sequence);
+			WakeUp(_space_sequence);
+		}
+
+	protected:
+		struct Cell
+		{
+			std::atomic<size_t> sequence{0};
+			std::optional<T> value;
+		};
+
+		template <typename U>
+		bool EnqueueInternal(U &&item)
+		{
+			// TryEnqueue() does not touch the item when it fails, so it is safe to forward it again
+			while (TryEnqueue(std::forward<U>(item)) == false)
+			{
+				if (_stop.load())
+				{
+					return false;
+				}
+
+				LogFull();
+
+				WaitForSpace();
+			}
+
+			return true;
+		}
+
+		void WaitForSpace()
+		{
+			_space_waiters.fetch_add(1);
+
+			// Must be loaded before checking the size, so a wake-up between the check and the wait is not lost
+			uint32_t space_sequence = _space_sequence.load();
+
+			if ((_size.load() >= GetCapacity()) && (_stop.load() == false))
+			{
+				Wait(_space_sequence, space_sequence, -1LL);
+			}
+			else
+			{
+				// A slot is being released (or claimed by another producer), it will be available soon
+				std::this_thread::yield();
+			}
+
+			_space_waiters.fetch_sub(1);
+		}
+
+		// Returns false if timed out
+		bool WaitForItem(int timeout, std::chrono::steady_clock::time_point &expire)
+		{
+			if (timeout == 0)
+			{
+				return false;
+			}
+
+			bool result = true;
+
+			_waiters.fetch_add(1);
+
+			while (true)
+			{
+				// Must be loaded before checking the size, so a wake-up between the check and FUTEX_WAIT is not lost
+				uint32_t wake_sequence = _wake_sequence.load();
+
+				if ((_size.load() > 0) || _stop.load())
+				{
+					break;
+				}
+
+				int64_t remaining_ns = -1LL;
+
+				if (timeout != Infinite)
+				{
+					auto now = std::chrono::steady_clock::now();
+
+					if (expire.time_since_epoch().count() == 0)
+					{
+						expire = now + std::chrono::milliseconds(timeout);
+					}
+
+					if (now >= expire)
+					{
+						result = false;
+						break;
+					}
+
+					remaining_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(expire - now).count();
+				}
+
+				Wait(_wake_sequence, wake_sequence, remaining_ns);
+			}
+
+			_waiters.fetch_sub(1);
+
+			return result;
+		}
+
+		// Sleeps while word is value, until WakeUp(word) is called or timeout_ns (< 0: infinite) elapses
+		void Wait(std::atomic<uint32_t> &word, uint32_t value, int64_t timeout_ns)
+		{
+#if defined(__APPLE__)
+			auto lock = std::unique_lock(_wait_mutex);
+			auto is_changed = [&]() -> bool { return word.load() != value; };
+
+			if (timeout_ns < 0LL)
+			{
+				_wait_condition.wait(lock, is_changed);
+			}
+			else
+			{
+				_wait_condition.wait_for(lock, std::chrono::nanoseconds(timeout_ns), is_changed);
+			}
+#else
+			struct timespec timeout;
+			struct timespec *timeout_ptr = nullptr;
+
+			if (timeout_ns >= 0LL)
+			{
+				timeout.tv_sec = timeout_ns / 1000000000LL;
+				timeout.tv_nsec = timeout_ns % 1000000000LL;
+				timeout_ptr = &timeout;
+			}
+
+			::syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAIT_PRIVATE, value, timeout_ptr, nullptr, 0);
+#endif
+		}
+
+		void WakeUp(std::atomic<uint32_t> &word)
+		{
+#if defined(__APPLE__)
+			{
+				// Changed with the lock held, so a waiter cannot miss it between its check and its wait
+				auto lock_guard = std::lock_guard(_wait_mutex);
+				word.fetch_add(1);
+			}
+
+			_wait_condition.notify_all();
+#else
+			word.fetch_add(1);
+			::syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#endif
+		}
+
+		inline void CheckThreshold(size_t size)
+		{
+			if ((_threshold > 0) && (size >= _threshold))
+			{
+				// Producers must not block each other only to write a log
+				auto lock = std::unique_lock(_log_mutex, std::try_to_lock);
+
+				if (lock.owns_lock() && _last_log_time.IsElapsed(_log_interval) && _last_log_time.Update())
+				{
+					auto shared_lock = std::shared_lock(_name_mutex);
+					logw("ov.RingQueue", "[%p] %s size has exceeded the threshold: queue: %zu, threshold: %zu", this, _queue_name.CStr(), size, _threshold);
+				}
+			}
+		}
+
+		void LogFull()
+		{
+			auto lock = std::unique_lock(_log_mutex, std::try_to_lock);
+
+			if (lock.owns_lock() && _last_log_time.IsElapsed(_log_interval) && _last_log_time.Update())
+			{
+				auto shared_lock = std::shared_lock(_name_mutex);
+				logw("ov.RingQueue", "[%p] %s is full, the producer is waiting for the consumer: capacity: %zu", this, _queue_name.CStr(), GetCapacity());
+			}
+		}
+
+	private:
+		static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "std::atomic<uint32_t> cannot be used as a futex word");
+
+		std::mutex _log_mutex;
+		StopWatch _last_log_time;
+
+		mutable std::shared_mutex _name_mutex;
+		String _queue_name;
+
+		size_t _threshold = 0;
+		int _log_interval = 0;
+
+		std::unique_ptr<Cell[]> _cells;
+		size_t _mask = 0;
+
+		// Producers and consumers are kept on separate cache lines
+		alignas(64) std::atomic<size_t> _enqueue_position{0};
+		alignas(64) std::atomic<size_t> _dequeue_position{0};
+		alignas(64) std::atomic<size_t> _size{0};
+
+		// Consumers wait for an item
+		std::atomic<uint32_t> _wake_sequence{0};
+		std::atomic<int> _waiters{0};
+		// Producers wait for a free slot
+		std::atomic<uint32_t> _space_sequence{0};
+		std::atomic<int> _space_waiters{0};
+		std::atomic<bool> _stop{false};
+
+#if defined(__APPLE__)
+		std::mutex _wait_mutex;
+		std::condition_variable _wait_condition;
+#endif
+	};
+}  // namespace ov
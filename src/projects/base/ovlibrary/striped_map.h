@@ -0,0 +1,157 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2020 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace ov
+{
+	// A hash map which is split into stripes, each with its own std::shared_mutex.
+	//
+	// Lookups take a shared lock on the one stripe the key belongs to, so readers never block each other,
+	// and writers only block the keys in the same stripe.
+	// Use it instead of a std::map + std::mutex for the tables which are looked up for every packet.
+	template <typename Tkey, typename Tvalue, typename Thash = std::hash<Tkey>>
+	class StripedMap
+	{
+	public:
+		static constexpr size_t DefaultStripeCount = 16;
+
+		explicit StripedMap(size_t stripe_count = DefaultStripeCount)
+			: _stripes((stripe_count == 0) ? 1 : stripe_count)
+		{
+		}
+
+		// Copies the value to value if the key is found
+		bool Find(const Tkey &key, Tvalue *value) const
+		{
+			auto &stripe = GetStripe(key);
+			std::shared_lock<std::shared_mutex> lock(stripe.mutex);
+
+			auto item = stripe.map.find(key);
+
+			if (item == stripe.map.end())
+			{
+				return false;
+			}
+
+			if (value != nullptr)
+			{
+				*value = item->second;
+			}
+
+			return true;
+		}
+
+		bool Contains(const Tkey &key) const
+		{
+			return Find(key, nullptr);
+		}
+
+		// Inserts or replaces the value
+		void Set(const Tkey &key, const Tvalue &value)
+		{
+			auto &stripe = GetStripe(key);
+			std::lock_guard<std::shared_mutex> lock(stripe.mutex);
+
+			stripe.map[key] = value;
+		}
+
+		// Returns false if the key already exists (the value is not replaced)
+		bool Insert(const Tkey &key, const Tvalue &value)
+		{
+			auto &stripe = GetStripe(key);
+			std::lock_guard<std::shared_mutex> lock(stripe.mutex);
+
+			return stripe.map.emplace(key, value).second;
+		}
+
+		bool Erase(const Tkey &key)
+		{
+			auto &stripe = GetStripe(key);
+			std::lock_guard<std::shared_mutex> lock(stripe.mutex);
+
+			return stripe.map.erase(key) > 0;
+		}
+
+		// Erases the items which predicate returns true for, and returns them.
+		// predicate is called with the lock of the stripe held, so it must not access this map.
+		std::vector<Tvalue> EraseIf(const std::function<bool(const Tkey &key, const Tvalue &value)> &predicate)
+		{
+			std::vector<Tvalue> erased_list;
+
+			for (auto &stripe : _stripes)
+			{
+				std::lock_guard<std::shared_mutex> lock(stripe.mutex);
+
+				for (auto item = stripe.map.begin(); item != stripe.map.end();)
+				{
+					if (predicate(item->first, item->second))
+					{
+						erased_list.push_back(item->second);
+						item = stripe.map.erase(item);
+					}
+					else
+					{
+						++item;
+					}
+				}
+			}
+
+			return erased_list;
+		}
+
+		void Clear()
+		{
+			for (auto &stripe : _stripes)
+			{
+				std::lock_guard<std::shared_mutex> lock(stripe.mutex);
+
+				stripe.map.clear();
+			}
+		}
+
+		size_t GetCount() const
+		{
+			size_t count = 0;
+
+			for (auto &stripe : _stripes)
+			{
+				std::shared_lock<std::shared_mutex> lock(stripe.mutex);
+
+				count += stripe.map.size();
+			}
+
+			return count;
+		}
+
+	protected:
+		struct Stripe
+		{
+			mutable std::shared_mutex mutex;
+			std::unordered_map<Tkey, Tvalue, Thash> map;
+		};
+
+		Stripe &GetStripe(const Tkey &key)
+		{
+			return _stripes[Thash()(key) % _stripes.size()];
+		}
+
+		const Stripe &GetStripe(const Tkey &key) const
+		{
+			return _stripes[Thash()(key) % _stripes.size()];
+		}
+
+		std::vector<Stripe> _stripes;
+	};
+}  // namespace ov
@@ -0,0 +1,127 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2020 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "timer_wheel.h"
+
+#include <pthread.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include "./log.h"
+
+#define OV_LOG_TAG "TimerWheel"
+
+namespace ov
+{
+	TimerWheel *TimerWheel::GetInstance()
+	{
+		// Never destroyed, like Executor::GetInstance()
+		static auto instance = new TimerWheel("OvTimerWheel", OV_TIMER_WHEEL_TICK_MS, OV_TIMER_WHEEL_SLOT_COUNT);
+
+		return instance;
+	}
+
+	TimerWheel::TimerWheel(const char *name, int tick_ms, size_t slot_count, Executor *executor)
+		: _executor((executor != nullptr) ? executor : Executor::GetInstance()),
+		  _tick_ms(std::max(tick_ms, 1)),
+		  _slots(std::max<size_t>(slot_count, 1))
+	{
+		_thread = std::thread(&TimerWheel::TickThread, this);
+
+		// The name of a thread must be shorter than 16 characters
+		char thread_name[16];
+		::snprintf(thread_name, sizeof(thread_name), "%s", name);
+		::pthread_setname_np(_thread.native_handle(), thread_name);
+	}
+
+	TimerWheel::~TimerWheel()
+	{
+		Stop();
+	}
+
+	bool TimerWheel::Schedule(int delay_ms, Executor::Task task, Executor *executor)
+	{
+		if (_stop || (task == nullptr))
+		{
+			return false;
+		}
+
+		// At least one tick, so the task doesn't run before the delay
+		uint64_t ticks = std::max<int64_t>((delay_ms + _tick_ms - 1) / _tick_ms, 1);
+
+		std::lock_guard<std::mutex> lock_guard(_mutex);
+
+		auto expire_tick = _current_tick + ticks;
+		_slots[expire_tick % _slots.size()].push_back({expire_tick, std::move(task), (executor != nullptr) ? executor : _executor});
+
+		return true;
+	}
+
+	void TimerWheel::Stop()
+	{
+		if (_stop.exchange(true))
+		{
+			return;
+		}
+
+		if (_thread.joinable())
+		{
+			_thread.join();
+		}
+
+		std::lock_guard<std::mutex> lock_guard(_mutex);
+
+		for (auto &slot : _slots)
+		{
+			slot.clear();
+		}
+	}
+
+	void TimerWheel::TickThread()
+	{
+		auto tick = std::chrono::milliseconds(_tick_ms);
+		auto next_tick_time = std::chrono::steady_clock::now() + tick;
+
+		std::vector<Timer> expired_list;
+
+		while (_stop == false)
+		{
+			std::this_thread::sleep_until(next_tick_time);
+
+			// If the thread is late (e.g. the system was busy), the missed ticks are processed at once
+			auto now = std::chrono::steady_clock::now();
+
+			{
+				std::lock_guard<std::mutex> lock_guard(_mutex);
+
+				while (next_tick_time <= now)
+				{
+					_current_tick++;
+					next_tick_time += tick;
+
+					auto &slot = _slots[_current_tick % _slots.size()];
+
+					// Timers which are scheduled for the later turns stay in the slot
+					auto expired = std::stable_partition(slot.begin(), slot.end(), [this](const Timer &timer) -> bool {
+						return timer.expire_tick > _current_tick;
+					});
+
+					std::move(expired, slot.end(), std::back_inserter(expired_list));
+					slot.erase(expired, slot.end());
+				}
+			}
+
+			for (auto &timer : expired_list)
+			{
+				timer.executor->Post(std::move(timer.task));
+			}
+
+			expired_list.clear();
+		}
+	}
+}  // namespace ov
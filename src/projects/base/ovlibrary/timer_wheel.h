@@ -0,0 +1,69 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2020 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "./executor.h"
+
+// Resolution of the shared timer wheel
+#define OV_TIMER_WHEEL_TICK_MS 2
+// 2 ms * 1024 = about 2 seconds for one turn (longer timers wait for more turns)
+#define OV_TIMER_WHEEL_SLOT_COUNT 1024
+
+namespace ov
+{
+	// Runs tasks after a delay, with the resolution of a tick.
+	//
+	// One thread advances the wheel, and the expired tasks are posted to an Executor,
+	// so a lot of short timers (e.g. a pacer per session) cost neither a thread nor a heap operation each.
+	// Tasks can't be cancelled, so they should hold a weak reference to the object they use.
+	class TimerWheel
+	{
+	public:
+		// The shared instance, which posts the tasks to Executor::GetInstance()
+		static TimerWheel *GetInstance();
+
+		TimerWheel(const char *name, int tick_ms, size_t slot_count, Executor *executor = nullptr);
+		~TimerWheel();
+
+		// Runs the task after delay_ms (rounded up to the tick). Returns false if the wheel is stopped.
+		// The task is posted to executor if it is not nullptr (e.g. the shard which owns the object), or to the executor of the wheel.
+		bool Schedule(int delay_ms, Executor::Task task, Executor *executor = nullptr);
+
+		int GetTickMs() const
+		{
+			return _tick_ms;
+		}
+
+		void Stop();
+
+	protected:
+		struct Timer
+		{
+			uint64_t expire_tick;
+			Executor::Task task;
+			Executor *executor;
+		};
+
+		void TickThread();
+
+		Executor *_executor = nullptr;
+		int _tick_ms = 0;
+
+		std::mutex _mutex;
+		std::vector<std::vector<Timer>> _slots;
+		uint64_t _current_tick = 0;
+
+		std::thread _thread;
+		std::atomic<bool> _stop{false};
+	};
+}  // namespace ov
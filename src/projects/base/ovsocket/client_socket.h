@@ -23,9 +23,6 @@ namespace ov
 		~ClientSocket() override;
 
 		// 데이터 송신
-		ssize_t Send(const std::shared_ptr<const Data> &data) override;
-		ssize_t Send(const void *data, size_t length) override;
-
 		ssize_t Send(const ov::String &string, bool include_null_char = false);
 
 		template <typename T>
@@ -50,58 +47,10 @@ namespace ov
 		String ToString() const override;
 
 	protected:
-		struct DispatchCommand
-		{
-			enum class Type
-			{
-				Unknown,
-				SendData,
-				Close
-			};
-
-			DispatchCommand(const std::shared_ptr<const ov::Data> &data)
-				: type(Type::SendData),
-				  data(data),
-				  enqueued_time(std::chrono::system_clock::now())
-			{
-			}
-
-			DispatchCommand(Type type)
-				: type(type),
-				  enqueued_time(std::chrono::system_clock::now())
-			{
-			}
-
-			bool IsExpired(int millisecond_time) const
-			{
-				auto delta = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - enqueued_time);
-
-				return (delta.count() >= millisecond_time);
-			}
-
-			Type type = Type::Unknown;
-			std::shared_ptr<const ov::Data> data;
-			std::chrono::time_point<std::chrono::system_clock> enqueued_time;
-		};
-
-		bool StartDispatchThread();
-		bool StopDispatchThread(bool stop_immediately);
-
-		bool SendAsync(const ClientSocket::DispatchCommand &send_item);
-		void DispatchThreadStub(std::shared_ptr<ClientSocket> client_socket);
-		void DispatchThread();
+		bool SetWritableNotification(bool enable) override;
 
 		bool CloseInternal() override;
 
 		ServerSocket *_server_socket = nullptr;
-
-		// TODO(dimiden): If the receiver does not read the data, EAGAIN may occur continuously.
-		//                At this time, it can be blocked, so it creates a thread and processes it.
-		//                I know it's inefficient to use one thread per Socket, and I'll create a send pool later.
-		std::thread _send_thread;
-		ov::Queue<DispatchCommand> _dispatch_queue{nullptr, 100};
-		bool _is_thread_running = false;
-
-		std::shared_ptr<ClientSocket> _instance;
 	};
 }  // namespace ov
@@ -65,7 +65,7 @@ namespace ov
 				if(
 					OV_CHECK_FLAG(event->events, EPOLLERR) ||
 					OV_CHECK_FLAG(event->events, EPOLLHUP) ||
-					(!OV_CHECK_FLAG(event->events, EPOLLIN))
+					((event->events & (EPOLLIN | EPOLLOUT)) == 0)
 					)
 				{
 					// 오류 발생
@@ -75,36 +75,22 @@ namespace ov
 				}
 				else if(epoll_data == static_cast<void *>(this))
 				{
-					logtd("Trying to read UDP packets...");
+					if(OV_CHECK_FLAG(event->events, EPOLLOUT))
+					{
+						// The socket buffer is available, so send the pending datagrams
+						FlushSendQueue();
+					}
 
-					while(true)
+					if(OV_CHECK_FLAG(event->events, EPOLLIN) == false)
 					{
-						std::shared_ptr<Data> data = std::make_shared<ov::Data>(UdpBufferSize);
-
-						// socket에서 이벤트 발생
-						std::shared_ptr<SocketAddress> remote;
-						std::shared_ptr<ov::Error> error = RecvFrom(data, &remote);
-
-						if(data->GetLength() > 0L)
-						{
-							data_callback(this->GetSharedPtrAs<DatagramSocket>(), *(remote.get()), data);
-						}
-
-						if(error != nullptr)
-						{
-							logtw("[#%d] An error occurred: %s", GetSocket(), error->ToString().CStr());
-							break;
-						}
-						else
-						{
-							if(data->GetLength() == 0L)
-							{
-								// 다음 데이터를 기다려야 함
-								break;
-							}
-						}
+						_last_epoll_event_count--;
+						continue;
 					}
 
+					logtd("Trying to read UDP packets...");
+
+					DispatchReadEvent(data_callback);
+
 					logtd("All UDP data are processed");
 				}
 				else
@@ -128,6 +114,141 @@ namespace ov
 		return true;
 	}
 
+#if defined(__APPLE__)
+	bool DatagramSocket::DispatchReadEvent(const DatagramCallback &data_callback)
+	{
+		// macOS does not support recvmmsg()
+		while(true)
+		{
+			std::shared_ptr<Data> data = std::make_shared<ov::Data>(UdpBufferSize);
+
+			// socket에서 이벤트 발생
+			std::shared_ptr<SocketAddress> remote;
+			std::shared_ptr<ov::Error> error = RecvFrom(data, &remote);
+
+			if(data->GetLength() > 0L)
+			{
+				data_callback(this->GetSharedPtrAs<DatagramSocket>(), *(remote.get()), data);
+			}
+
+			if(error != nullptr)
+			{
+				logtw("[#%d] An error occurred: %s", GetSocket(), error->ToString().CStr());
+				return false;
+			}
+
+			if(data->GetLength() == 0L)
+			{
+				// 다음 데이터를 기다려야 함
+				return true;
+			}
+		}
+	}
+#else   // defined(__APPLE__)
+	void DatagramSocket::PrepareRecvBuffers()
+	{
+		if(_recv_buffer_list.empty())
+		{
+			_recv_buffer_list.resize(UdpRecvBatchCount);
+			_recv_message_list.resize(UdpRecvBatchCount);
+			_recv_iovec_list.resize(UdpRecvBatchCount);
+			_recv_address_list.resize(UdpRecvBatchCount);
+		}
+
+		for(int index = 0; index < UdpRecvBatchCount; index++)
+		{
+			auto &buffer = _recv_buffer_list[index];
+
+			if(buffer == nullptr)
+			{
+				buffer = std::make_shared<ov::Data>(UdpBufferSize);
+			}
+
+			// If the callee made a copy of the buffer (ov::Data is COW), GetWritableData() detaches it
+			buffer->SetLength(UdpBufferSize);
+
+			auto &iov = _recv_iovec_list[index];
+			iov.iov_base = buffer->GetWritableData();
+			iov.iov_len = buffer->GetLength();
+
+			auto &message = _recv_message_list[index];
+			message = {};
+			message.msg_hdr.msg_name = &(_recv_address_list[index]);
+			message.msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+			message.msg_hdr.msg_iov = &iov;
+			message.msg_hdr.msg_iovlen = 1;
+		}
+	}
+
+	bool DatagramSocket::DispatchReadEvent(const DatagramCallback &data_callback)
+	{
+		auto socket = this->GetSharedPtrAs<DatagramSocket>();
+
+		while(true)
+		{
+			PrepareRecvBuffers();
+
+			int count = ::recvmmsg(GetId(), _recv_message_list.data(), UdpRecvBatchCount, MSG_DONTWAIT, nullptr);
+
+			if(count < 0)
+			{
+				auto error = Error::CreateErrorFromErrno();
+
+				switch(error->GetCode())
+				{
+					case EAGAIN:
+#if EAGAIN != EWOULDBLOCK
+					case EWOULDBLOCK:
+#endif	// EAGAIN != EWOULDBLOCK
+						// 다음 데이터를 기다려야 함
+						return true;
+
+					case EINTR:
+						continue;
+
+					default:
+						logtw("[#%d] An error occurred: %s", GetId(), error->ToString().CStr());
+						return false;
+				}
+			}
+
+			logtd("[#%d] %d datagrams are received", GetId(), count);
+
+			for(int index = 0; index < count; index++)
+			{
+				auto &buffer = _recv_buffer_list[index];
+				auto &message = _recv_message_list[index];
+
+				if(message.msg_len == 0)
+				{
+					continue;
+				}
+
+				buffer->SetLength(message.msg_len);
+
+				data_callback(socket, SocketAddress(_recv_address_list[index]), buffer);
+
+				if(buffer.use_count() > 1)
+				{
+					// Someone holds the buffer, so it cannot be reused
+					buffer = nullptr;
+				}
+			}
+
+			if(count < UdpRecvBatchCount)
+			{
+				// All datagrams are read
+				return true;
+			}
+		}
+	}
+#endif  // defined(__APPLE__)
+
+	bool DatagramSocket::SetWritableNotification(bool enable)
+	{
+		return ModifyEpoll(this, static_cast<void *>(this), enable);
+	}
+
 	String DatagramSocket::ToString() const
 	{
 		return Socket::ToString("DatagramSocket");
@@ -11,6 +11,8 @@
 #include "socket.h"
 #include "socket_datastructure.h"
 
+#include <vector>
+
 namespace ov
 {
 	class DatagramSocket : public Socket
@@ -37,5 +39,20 @@ namespace ov
 		String ToString() const override;
 
 	protected:
+		bool SetWritableNotification(bool enable) override;
+
+		// Read the datagrams as many as possible, and call data_callback for each datagram
+		bool DispatchReadEvent(const DatagramCallback &data_callback);
+
+#if !defined(__APPLE__)
+		// Prepare the buffers for recvmmsg()
+		void PrepareRecvBuffers();
+
+		// The buffers are reused unless someone holds the buffer after data_callback is called
+		std::vector<std::shared_ptr<Data>> _recv_buffer_list;
+		std::vector<mmsghdr> _recv_message_list;
+		std::vector<iovec> _recv_iovec_list;
+		std::vector<sockaddr_storage> _recv_address_list;
+#endif  // !defined(__APPLE__)
 	};
 }
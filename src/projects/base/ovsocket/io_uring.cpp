@@ -0,0 +1,513 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2020 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "io_uring.h"
+
+#include "socket_private.h"
+
+#if !defined(__APPLE__)
+#	include <poll.h>
+#	include <sys/mman.h>
+#	include <sys/socket.h>
+#	include <sys/syscall.h>
+#	include <sys/utsname.h>
+#	include <unistd.h>
+#endif  // !defined(__APPLE__)
+
+namespace ov
+{
+#if !defined(__APPLE__)
+	IoUring::~IoUring()
+	{
+		Uninitialize();
+	}
+
+	bool IoUring::IsSupported()
+	{
+		utsname name{};
+
+		if (::uname(&name) != 0)
+		{
+			return false;
+		}
+
+		int major = 0;
+		int minor = 0;
+
+		if (::sscanf(name.release, "%d.%d", &major, &minor) != 2)
+		{
+			return false;
+		}
+
+		if (major < 6)
+		{
+			logtw("io_uring backend requires Linux 6.0 or later (current: %s)", name.release);
+			return false;
+		}
+
+		// io_uring may be disabled by the administrator (kernel.io_uring_disabled)
+		io_uring_params params{};
+		int fd = static_cast<int>(::syscall(__NR_io_uring_setup, 1, &params));
+
+		if (fd < 0)
+		{
+			logtw("io_uring is not available: %s", Error::CreateErrorFromErrno()->ToString().CStr());
+			return false;
+		}
+
+		::close(fd);
+
+		return OV_CHECK_FLAG(params.features, IORING_FEAT_SINGLE_MMAP | IORING_FEAT_EXT_ARG);
+	}
+
+	bool IoUring::Initialize(unsigned int entries)
+	{
+		if (IsInitialized())
+		{
+			OV_ASSERT2(false);
+			return false;
+		}
+
+		io_uring_params params{};
+
+		// Multishot requests may generate many completions, so make the CQ larger than the SQ
+		params.flags = IORING_SETUP_CQSIZE;
+		params.cq_entries = entries * 8;
+
+		_ring_fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+
+		if (_ring_fd < 0)
+		{
+			logte("Could not create io_uring: %s", Error::CreateErrorFromErrno()->ToString().CStr());
+			_ring_fd = -1;
+			return false;
+		}
+
+		_sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+		_cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+		// IsSupported() checks IORING_FEAT_SINGLE_MMAP, so the SQ ring and the CQ ring share the memory
+		_sq_ring_size = std::max(_sq_ring_size, _cq_ring_size);
+		_cq_ring_size = 0;
+
+		_sq_ring = ::mmap(nullptr, _sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring_fd, IORING_OFF_SQ_RING);
+
+		if (_sq_ring == MAP_FAILED)
+		{
+			logte("Could not map the ring of io_uring: %s", Error::CreateErrorFromErrno()->ToString().CStr());
+			_sq_ring = nullptr;
+			Uninitialize();
+			return false;
+		}
+
+		_cq_ring = _sq_ring;
+
+		_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+		void *sqes = ::mmap(nullptr, _sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring_fd, IORING_OFF_SQES);
+
+		if (sqes == MAP_FAILED)
+		{
+			logte("Could not map the SQEs of io_uring: %s", Error::CreateErrorFromErrno()->ToString().CStr());
+			Uninitialize();
+			return false;
+		}
+
+		_sqes = static_cast<io_uring_sqe *>(sqes);
+
+		auto sq_ring = static_cast<uint8_t *>(_sq_ring);
+		_sq_head = reinterpret_cast<unsigned int *>(sq_ring + params.sq_off.head);
+		_sq_tail = reinterpret_cast<unsigned int *>(sq_ring + params.sq_off.tail);
+		_sq_mask = *reinterpret_cast<unsigned int *>(sq_ring + params.sq_off.ring_mask);
+		_sq_array = reinterpret_cast<unsigned int *>(sq_ring + params.sq_off.array);
+		_sq_entry_count = params.sq_entries;
+		_sq_pending_count = 0;
+
+		auto cq_ring = static_cast<uint8_t *>(_cq_ring);
+		_cq_head = reinterpret_cast<unsigned int *>(cq_ring + params.cq_off.head);
+		_cq_tail = reinterpret_cast<unsigned int *>(cq_ring + params.cq_off.tail);
+		_cq_mask = *reinterpret_cast<unsigned int *>(cq_ring + params.cq_off.ring_mask);
+		_cqes = reinterpret_cast<io_uring_cqe *>(cq_ring + params.cq_off.cqes);
+
+		logtd("io_uring is created (fd: %d, sq: %u, cq: %u)", _ring_fd, params.sq_entries, params.cq_entries);
+
+		return true;
+	}
+
+	void IoUring::Uninitialize()
+	{
+		if (_sqes != nullptr)
+		{
+			::munmap(_sqes, _sqes_size);
+			_sqes = nullptr;
+		}
+
+		if (_sq_ring != nullptr)
+		{
+			::munmap(_sq_ring, _sq_ring_size);
+			_sq_ring = nullptr;
+			_cq_ring = nullptr;
+		}
+
+		if (_ring_fd != -1)
+		{
+			// The buffer ring is unregistered when the ring is closed
+			::close(_ring_fd);
+			_ring_fd = -1;
+		}
+
+		if (_buffer_ring != nullptr)
+		{
+			::munmap(_buffer_ring, _buffer_ring_size);
+			_buffer_ring = nullptr;
+		}
+
+		if (_buffers != nullptr)
+		{
+			::munmap(_buffers, _buffers_size);
+			_buffers = nullptr;
+		}
+	}
+
+	bool IoUring::RegisterBufferRing(uint16_t group_id, uint16_t count, size_t buffer_size)
+	{
+		OV_ASSERT2(IsInitialized());
+		OV_ASSERT2(_buffer_ring == nullptr);
+
+		if ((count == 0) || ((count & (count - 1)) != 0))
+		{
+			logte("The number of buffers must be a power of 2: %u", count);
+			return false;
+		}
+
+		_buffer_ring_size = count * sizeof(io_uring_buf);
+		_buffer_ring = ::mmap(nullptr, _buffer_ring_size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+
+		if (_buffer_ring == MAP_FAILED)
+		{
+			_buffer_ring = nullptr;
+			logte("Could not allocate the buffer ring: %s", Error::CreateErrorFromErrno()->ToString().CStr());
+			return false;
+		}
+
+		_buffers_size = count * buffer_size;
+		void *buffers = ::mmap(nullptr, _buffers_size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+
+		if (buffers == MAP_FAILED)
+		{
+			logte("Could not allocate the buffers: %s", Error::CreateErrorFromErrno()->ToString().CStr());
+			return false;
+		}
+
+		_buffers = static_cast<uint8_t *>(buffers);
+
+		io_uring_buf_reg reg{};
+		reg.ring_addr = reinterpret_cast<uint64_t>(_buffer_ring);
+		reg.ring_entries = count;
+		reg.bgid = group_id;
+
+		if (::syscall(__NR_io_uring_register, _ring_fd, IORING_REGISTER_PBUF_RING, &reg, 1) != 0)
+		{
+			logte("Could not register the buffer ring: %s", Error::CreateErrorFromErrno()->ToString().CStr());
+			return false;
+		}
+
+		_buffer_size = buffer_size;
+		_buffer_count = count;
+		_buffer_group_id = group_id;
+		_buffer_ring_tail = 0;
+
+		for (uint16_t buffer_id = 0; buffer_id < count; buffer_id++)
+		{
+			RecycleBuffer(buffer_id);
+		}
+
+		return true;
+	}
+
+	const uint8_t *IoUring::GetBuffer(uint16_t buffer_id) const
+	{
+		OV_ASSERT2(buffer_id < _buffer_count);
+
+		return _buffers + (buffer_id * _buffer_size);
+	}
+
+	void IoUring::RecycleBuffer(uint16_t buffer_id)
+	{
+		auto ring = static_cast<io_uring_buf_ring *>(_buffer_ring);
+		// Do not use ring->bufs: __DECLARE_FLEX_ARRAY() of <linux/io_uring.h> places it at the wrong offset in C++
+		auto &buffer = static_cast<io_uring_buf *>(_buffer_ring)[_buffer_ring_tail & (_buffer_count - 1)];
+
+		buffer.addr = reinterpret_cast<uint64_t>(_buffers + (buffer_id * _buffer_size));
+		buffer.len = static_cast<uint32_t>(_buffer_size);
+		buffer.bid = buffer_id;
+
+		_buffer_ring_tail++;
+
+		// Make the buffer visible to the kernel
+		__atomic_store_n(&(ring->tail), _buffer_ring_tail, __ATOMIC_RELEASE);
+	}
+
+	io_uring_sqe *IoUring::GetSubmissionEntry()
+	{
+		unsigned int head = __atomic_load_n(_sq_head, __ATOMIC_ACQUIRE);
+		unsigned int tail = *_sq_tail + _sq_pending_count;
+
+		if ((tail - head) >= _sq_entry_count)
+		{
+			// SQ is full
+			return nullptr;
+		}
+
+		unsigned int index = tail & _sq_mask;
+		io_uring_sqe *sqe = &(_sqes[index]);
+
+		::memset(sqe, 0, sizeof(*sqe));
+		_sq_array[index] = index;
+		_sq_pending_count++;
+
+		return sqe;
+	}
+
+	bool IoUring::SubmitEntries()
+	{
+		unsigned int count = _sq_pending_count;
+
+		__atomic_store_n(_sq_tail, *_sq_tail + count, __ATOMIC_RELEASE);
+		_sq_pending_count = 0;
+
+		while (true)
+		{
+			int result = static_cast<int>(::syscall(__NR_io_uring_enter, _ring_fd, count, 0, 0, nullptr, 0));
+
+			if (result >= 0)
+			{
+				return true;
+			}
+
+			if (errno == EINTR)
+			{
+				continue;
+			}
+
+			logte("Could not submit the requests to io_uring: %s", Error::CreateErrorFromErrno()->ToString().CStr());
+			return false;
+		}
+	}
+
+	bool IoUring::PrepareMultishotAccept(int fd, uint64_t user_data)
+	{
+		std::lock_guard<std::mutex> lock_guard(_submission_mutex);
+
+		io_uring_sqe *sqe = GetSubmissionEntry();
+
+		if (sqe == nullptr)
+		{
+			logte("Could not get a SQE to accept (fd: %d)", fd);
+			return false;
+		}
+
+		sqe->opcode = IORING_OP_ACCEPT;
+		sqe->fd = fd;
+		sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+		sqe->accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+		sqe->user_data = user_data;
+
+		return SubmitEntries();
+	}
+
+	bool IoUring::PrepareMultishotRecv(int fd, uint16_t group_id, uint64_t user_data)
+	{
+		std::lock_guard<std::mutex> lock_guard(_submission_mutex);
+
+		io_uring_sqe *sqe = GetSubmissionEntry();
+
+		if (sqe == nullptr)
+		{
+			logte("Could not get a SQE to receive (fd: %d)", fd);
+			return false;
+		}
+
+		sqe->opcode = IORING_OP_RECV;
+		sqe->fd = fd;
+		sqe->ioprio = IORING_RECV_MULTISHOT;
+		sqe->flags = IOSQE_BUFFER_SELECT;
+		sqe->buf_group = group_id;
+		sqe->user_data = user_data;
+
+		return SubmitEntries();
+	}
+
+	bool IoUring::PreparePollAdd(int fd, uint32_t poll_mask, uint64_t user_data)
+	{
+		std::lock_guard<std::mutex> lock_guard(_submission_mutex);
+
+		io_uring_sqe *sqe = GetSubmissionEntry();
+
+		if (sqe == nullptr)
+		{
+			logte("Could not get a SQE to poll (fd: %d)", fd);
+			return false;
+		}
+
+		sqe->opcode = IORING_OP_POLL_ADD;
+		sqe->fd = fd;
+		sqe->poll32_events = poll_mask;
+		sqe->user_data = user_data;
+
+		return SubmitEntries();
+	}
+
+	bool IoUring::PrepareCancel(int fd)
+	{
+		std::lock_guard<std::mutex> lock_guard(_submission_mutex);
+
+		io_uring_sqe *sqe = GetSubmissionEntry();
+
+		if (sqe == nullptr)
+		{
+			logte("Could not get a SQE to cancel (fd: %d)", fd);
+			return false;
+		}
+
+		sqe->opcode = IORING_OP_ASYNC_CANCEL;
+		sqe->fd = fd;
+		sqe->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+		// The completion of the cancel request has user_data 0
+		sqe->user_data = 0;
+
+		return SubmitEntries();
+	}
+
+	bool IoUring::Wait(int timeout)
+	{
+		if (PeekCompletion() != nullptr)
+		{
+			return true;
+		}
+
+		int result;
+
+		if (timeout == Infinite)
+		{
+			result = static_cast<int>(::syscall(__NR_io_uring_enter, _ring_fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0));
+		}
+		else
+		{
+			__kernel_timespec ts{};
+			ts.tv_sec = timeout / 1000;
+			ts.tv_nsec = (timeout % 1000) * 1000000LL;
+
+			io_uring_getevents_arg arg{};
+			arg.ts = reinterpret_cast<uint64_t>(&ts);
+
+			result = static_cast<int>(::syscall(__NR_io_uring_enter, _ring_fd, 0, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg)));
+		}
+
+		if (result >= 0)
+		{
+			return true;
+		}
+
+		switch (errno)
+		{
+			case ETIME:
+				// timed out
+			case EINTR:
+				// Interruption of system calls and library functions by signal handlers
+				return true;
+
+			default:
+				logte("Could not wait for io_uring: %s", Error::CreateErrorFromErrno()->ToString().CStr());
+				return false;
+		}
+	}
+
+	const io_uring_cqe *IoUring::PeekCompletion() const
+	{
+		unsigned int head = *_cq_head;
+		unsigned int tail = __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE);
+
+		if (head == tail)
+		{
+			return nullptr;
+		}
+
+		return &(_cqes[head & _cq_mask]);
+	}
+
+	void IoUring::ConsumeCompletion()
+	{
+		__atomic_store_n(_cq_head, *_cq_head + 1, __ATOMIC_RELEASE);
+	}
+#else   // !defined(__APPLE__)
+	// macOS does not support io_uring
+	IoUring::~IoUring() = default;
+
+	bool IoUring::IsSupported()
+	{
+		return false;
+	}
+
+	bool IoUring::Initialize(unsigned int entries)
+	{
+		return false;
+	}
+
+	void IoUring::Uninitialize()
+	{
+	}
+
+	bool IoUring::RegisterBufferRing(uint16_t group_id, uint16_t count, size_t buffer_size)
+	{
+		return false;
+	}
+
+	const uint8_t *IoUring::GetBuffer(uint16_t buffer_id) const
+	{
+		return nullptr;
+	}
+
+	void IoUring::RecycleBuffer(uint16_t buffer_id)
+	{
+	}
+
+	bool IoUring::PrepareMultishotAccept(int fd, uint64_t user_data)
+	{
+		return false;
+	}
+
+	bool IoUring::PrepareMultishotRecv(int fd, uint16_t group_id, uint64_t user_data)
+	{
+		return false;
+	}
+
+	bool IoUring::PreparePollAdd(int fd, uint32_t poll_mask, uint64_t user_data)
+	{
+		return false;
+	}
+
+	bool IoUring::PrepareCancel(int fd)
+	{
+		return false;
+	}
+
+	bool IoUring::Wait(int timeout)
+	{
+		return false;
+	}
+
+	const io_uring_cqe *IoUring::PeekCompletion() const
+	{
+		return nullptr;
+	}
+
+	void IoUring::ConsumeCompletion()
+	{
+	}
+#endif  // !defined(__APPLE__)
+}  // namespace ov
@@ -0,0 +1,113 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2020 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+
+#include <mutex>
+
+#if !defined(__APPLE__)
+#	include <linux/io_uring.h>
+#endif  // !defined(__APPLE__)
+
+namespace ov
+{
+#if defined(__APPLE__)
+	struct io_uring_cqe;
+#endif  // defined(__APPLE__)
+
+	// A minimal io_uring wrapper used by ServerSocket (uses the system calls directly instead of liburing)
+	//
+	// - Submission: Prepare*() methods can be called from any thread, each request is submitted immediately
+	// - Completion: Wait()/PeekCompletion()/ConsumeCompletion() must be called from one thread (the dispatch thread)
+	class IoUring
+	{
+	public:
+		IoUring() = default;
+		~IoUring();
+
+		// Check whether the kernel supports the features used by the io_uring backend
+		// (multishot accept/recv and provided buffer rings: Linux 6.0+)
+		static bool IsSupported();
+
+		bool Initialize(unsigned int entries);
+		void Uninitialize();
+
+		bool IsInitialized() const
+		{
+			return _ring_fd != -1;
+		}
+
+		// Register <count> buffers of <buffer_size> bytes which are selected by the kernel when the data is received
+		// (count must be a power of 2)
+		bool RegisterBufferRing(uint16_t group_id, uint16_t count, size_t buffer_size);
+		const uint8_t *GetBuffer(uint16_t buffer_id) const;
+		// Give the buffer back to the kernel (must be called from the dispatch thread)
+		void RecycleBuffer(uint16_t buffer_id);
+
+		bool PrepareMultishotAccept(int fd, uint64_t user_data);
+		bool PrepareMultishotRecv(int fd, uint16_t group_id, uint64_t user_data);
+		bool PreparePollAdd(int fd, uint32_t poll_mask, uint64_t user_data);
+		// Cancel all requests of the fd
+		bool PrepareCancel(int fd);
+
+		// Wait until a completion is available (timeout: milliseconds, Infinite: wait forever)
+		// Returns false if an error occurred (timeout is not an error)
+		bool Wait(int timeout);
+
+		// Returns nullptr if there is no completion
+		const io_uring_cqe *PeekCompletion() const;
+		void ConsumeCompletion();
+
+	protected:
+#if !defined(__APPLE__)
+		// Returns a SQE to fill (_submission_mutex must be locked)
+		io_uring_sqe *GetSubmissionEntry();
+		// Submit the SQEs filled (_submission_mutex must be locked)
+		bool SubmitEntries();
+#endif  // !defined(__APPLE__)
+
+		int _ring_fd = -1;
+
+		std::mutex _submission_mutex;
+
+		// Submission queue
+		void *_sq_ring = nullptr;
+		size_t _sq_ring_size = 0;
+		unsigned int *_sq_head = nullptr;
+		unsigned int *_sq_tail = nullptr;
+		unsigned int _sq_mask = 0;
+		unsigned int *_sq_array = nullptr;
+		unsigned int _sq_entry_count = 0;
+		unsigned int _sq_pending_count = 0;
+
+#if !defined(__APPLE__)
+		io_uring_sqe *_sqes = nullptr;
+#endif  // !defined(__APPLE__)
+		size_t _sqes_size = 0;
+
+		// Completion queue
+		void *_cq_ring = nullptr;
+		size_t _cq_ring_size = 0;
+		unsigned int *_cq_head = nullptr;
+		unsigned int *_cq_tail = nullptr;
+		unsigned int _cq_mask = 0;
+		io_uring_cqe *_cqes = nullptr;
+
+		// Provided buffer ring
+		void *_buffer_ring = nullptr;
+		size_t _buffer_ring_size = 0;
+		uint8_t *_buffers = nullptr;
+		size_t _buffers_size = 0;
+		size_t _buffer_size = 0;
+		uint16_t _buffer_count = 0;
+		uint16_t _buffer_ring_tail = 0;
+		uint16_t _buffer_group_id = 0;
+	};
+}  // namespace ov
@@ -9,10 +9,20 @@
 #include "server_socket.h"
 
 #include <netinet/tcp.h>
+#include <poll.h>
 
 #include "client_socket.h"
 #include "socket_private.h"
 
+// If no data is sent during this time, the closing client is closed without flushing the send queue
+#define CLOSING_CLIENT_SEND_TIMEOUT (60 * 1000)
+
+// Settings of io_uring backend
+#define IO_URING_ENTRY_COUNT 1024
+#define IO_URING_BUFFER_GROUP_ID 1
+// 1024 * TcpBufferSize (4 KB) = 4 MB per ServerSocket
+#define IO_URING_BUFFER_COUNT 1024
+
 namespace ov
 {
 	ServerSocket::~ServerSocket()
@@ -36,19 +46,36 @@ namespace ov
 	{
 		CHECK_STATE(== SocketState::Closed, false);
 
+		if ((_backend == SocketBackend::IoUring) && (type == SocketType::Tcp))
+		{
+			if (IoUring::IsSupported())
+			{
+				_io_uring = std::make_unique<IoUring>();
+			}
+			else
+			{
+				logtw("[%p] io_uring is not supported, epoll will be used for %s", this, address.ToString().CStr());
+			}
+		}
+
 		if (
 			(
 				Create(type) &&
 				MakeNonBlocking() &&
-				PrepareEpoll() &&
-				AddToEpoll(this, static_cast<void *>(this)) &&
+				((_io_uring != nullptr) || (PrepareEpoll() && AddToEpoll(this, static_cast<void *>(this)))) &&
 				SetSocketOptions(type, send_buffer_size, recv_buffer_size) &&
 				Bind(address) &&
-				Listen(backlog)) == false)
+				Listen(backlog) &&
+				((_io_uring == nullptr) || PrepareIoUring())) == false)
 		{
 			// 중간 과정에서 오류가 발생하면 실패 반환
-			RemoveFromEpoll(this);
+			if (_io_uring == nullptr)
+			{
+				RemoveFromEpoll(this);
+			}
+
 			Close();
+			_io_uring = nullptr;
 			return false;
 		}
 
@@ -64,6 +91,11 @@ namespace ov
 		_connection_callback = connection_callback;
 		_data_callback = data_callback;
 
+		if (_io_uring != nullptr)
+		{
+			return DispatchIoUringEvent(timeout);
+		}
+
 		int count = EpollWait(timeout);
 
 		for (int index = 0; index < count; index++)
@@ -91,6 +123,8 @@ namespace ov
 			}
 		}
 
+		CloseExpiredClients();
+
 		// Garbage collection
 		{
 			std::lock_guard<std::shared_mutex> lock(_client_list_mutex);
@@ -110,14 +144,17 @@ namespace ov
 			return nullptr;
 		}
 
+		return AddClient(client_socket, address);
+	}
+
+	std::shared_ptr<ClientSocket> ServerSocket::AddClient(SocketWrapper client_socket, const SocketAddress &address)
+	{
 		std::shared_ptr<ClientSocket> client = std::make_shared<ClientSocket>(this, client_socket, address);
 
 		if (client != nullptr)
 		{
 			logtd("[%p] [#%d] New client is connected: %s", this, _socket.GetSocket(), client->ToString().CStr());
 
-			client->StartDispatchThread();
-
 			_client_list_mutex.lock();
 			_client_list[client.get()] = client;
 			_client_list_mutex.unlock();
@@ -132,8 +169,6 @@ namespace ov
 
 	void ServerSocket::DispatchAccept()
 	{
-		std::shared_ptr<ClientSocket> client = nullptr;
-
 		while (true)
 		{
 			std::shared_ptr<ClientSocket> client = Accept();
@@ -143,35 +178,40 @@ namespace ov
 				break;
 			}
 
-			logtd("[%p] [#%d] Client #%d is connected", this, _socket.GetSocket(), client->GetSocket().GetSocket());
+			DispatchConnected(client);
+		}
+	}
 
-			auto new_state = _connection_callback(client, SocketConnectionState::Connected, nullptr);
+	void ServerSocket::DispatchConnected(const std::shared_ptr<ClientSocket> &client)
+	{
+		logtd("[%p] [#%d] Client #%d is connected", this, _socket.GetSocket(), client->GetSocket().GetSocket());
 
-			switch (new_state)
-			{
-				case SocketConnectionState::Connected:
-					break;
+		auto new_state = _connection_callback(client, SocketConnectionState::Connected, nullptr);
 
-				case SocketConnectionState::Disconnect:
-					logtd("[%p] [#%d] The connection callback requested to disconnect the client #%d",
-						  this, _socket.GetSocket(), client->GetSocket().GetSocket());
-					DisconnectClient(client, new_state);
-					break;
+		switch (new_state)
+		{
+			case SocketConnectionState::Connected:
+				break;
 
-				case SocketConnectionState::Disconnected:
-					logtd("[%p] [#%d] Invalid socket state for client #%d",
-						  this, _socket.GetSocket(), client->GetSocket().GetSocket());
-					OV_ASSERT2(false);
-					DisconnectClient(client, new_state);
-					break;
+			case SocketConnectionState::Disconnect:
+				logtd("[%p] [#%d] The connection callback requested to disconnect the client #%d",
+					  this, _socket.GetSocket(), client->GetSocket().GetSocket());
+				DisconnectClient(client, new_state);
+				break;
 
-				case SocketConnectionState::Error: {
-					auto error = Error::CreateError("Connection", "The connection callback requested to disconnect the client #%d",
-													_socket.GetSocket(), client->GetSocket().GetSocket());
-					logtd("[%p] [#%d] %s", this, _socket.GetSocket(), error->ToString().CStr());
-					DisconnectClient(client, new_state, error);
-					break;
-				}
+			case SocketConnectionState::Disconnected:
+				logtd("[%p] [#%d] Invalid socket state for client #%d",
+					  this, _socket.GetSocket(), client->GetSocket().GetSocket());
+				OV_ASSERT2(false);
+				DisconnectClient(client, new_state);
+				break;
+
+			case SocketConnectionState::Error: {
+				auto error = Error::CreateError("Connection", "The connection callback requested to disconnect the client #%d",
+												_socket.GetSocket(), client->GetSocket().GetSocket());
+				logtd("[%p] [#%d] %s", this, _socket.GetSocket(), error->ToString().CStr());
+				DisconnectClient(client, new_state, error);
+				break;
 			}
 		}
 	}
@@ -187,15 +227,29 @@ namespace ov
 
 			if (item == _client_list.end())
 			{
-				// If the client deleted from another thread as soon as the event occurs at epoll(), it enters here
-				logtd("[%p] [#%d] Could not find a client: %p", this, _socket.GetSocket(), key);
-				return;
+				if (_closing_client_list.find(key) == _closing_client_list.end())
+				{
+					// If the client deleted from another thread as soon as the event occurs at epoll(), it enters here
+					logtd("[%p] [#%d] Could not find a client: %p", this, _socket.GetSocket(), key);
+					return;
+				}
+
+				client = nullptr;
 			}
+			else
+			{
+				client = item->second;
+			}
+		}
 
-			client = item->second;
+		if (client == nullptr)
+		{
+			// The client is waiting for the send queue to be flushed
+			DispatchClosingClientEvents(key, event);
+			return;
 		}
 
-		if (OV_CHECK_FLAG(epoll_events, EPOLLERR) || (!OV_CHECK_FLAG(epoll_events, EPOLLIN)))
+		if (OV_CHECK_FLAG(epoll_events, EPOLLERR) || ((epoll_events & (EPOLLIN | EPOLLOUT)) == 0))
 		{
 			// An error occurred while communiting with the client
 			auto error = Error::CreateError("Epoll", "%s", StringFromEpollEvent(event).CStr());
@@ -209,7 +263,15 @@ namespace ov
 			logtd("[%p] [#%d] Client #%d is disconnected with events: %s", this, _socket.GetSocket(), client->GetSocket().GetSocket(), StringFromEpollEvent(event).CStr());
 			DisconnectClient(client, SocketConnectionState::Disconnected);
 		}
-		else
+		else if (OV_CHECK_FLAG(epoll_events, EPOLLOUT) && (client->FlushSendQueue() < 0L))
+		{
+			// Could not send the pending data
+			auto error = Error::CreateError("Socket", "Could not send the pending data to client #%d", client->GetSocket().GetSocket());
+			logtd("[%p] [#%d] %s", this, _socket.GetSocket(), error->ToString().CStr());
+
+			DisconnectClient(client, SocketConnectionState::Error, error);
+		}
+		else if (OV_CHECK_FLAG(epoll_events, EPOLLIN))
 		{
 			// Data is available that sent by the client
 			auto data = std::make_shared<Data>(TcpBufferSize);
@@ -224,33 +286,7 @@ namespace ov
 
 				if (data->GetLength() > 0L)
 				{
-					auto new_state = _data_callback(client->GetSharedPtrAs<ClientSocket>(), data);
-					switch (new_state)
-					{
-						case SocketConnectionState::Connected:
-							break;
-
-						case SocketConnectionState::Disconnect:
-							logtd("[%p] [#%d] The data callback requested to disconnect the client #%d",
-								  this, _socket.GetSocket(), client->GetSocket().GetSocket());
-							DisconnectClient(client, new_state);
-							break;
-
-						case SocketConnectionState::Disconnected:
-							logtd("[%p] [#%d] Invalid socket state for client #%d",
-								  this, _socket.GetSocket(), client->GetSocket().GetSocket());
-							OV_ASSERT2(false);
-							DisconnectClient(client, new_state);
-							break;
-
-						case SocketConnectionState::Error: {
-							auto error = Error::CreateError("Connection", "The connection callback requested to disconnect the client #%d",
-															_socket.GetSocket(), client->GetSocket().GetSocket());
-							logtd("[%p] [#%d] %s", this, _socket.GetSocket(), error->ToString().CStr());
-							DisconnectClient(client, new_state, error);
-							break;
-						}
-					}
+					DispatchData(client, data);
 				}
 
 				if (client->GetState() == SocketState::Error)
@@ -267,8 +303,7 @@ namespace ov
 					break;
 				}
 
-				// TODO(dimiden): (ClientSocketBlocking) Temporarily comment while processing as blocking
-				// if (data->GetLength() == 0L)
+				if (data->GetLength() == 0L)
 				{
 					// Waiting for next data
 					break;
@@ -277,10 +312,513 @@ namespace ov
 		}
 	}
 
+	void ServerSocket::DispatchData(const std::shared_ptr<ClientSocket> &client, const std::shared_ptr<Data> &data)
+	{
+		auto new_state = _data_callback(client, data);
+
+		switch (new_state)
+		{
+			case SocketConnectionState::Connected:
+				break;
+
+			case SocketConnectionState::Disconnect:
+				logtd("[%p] [#%d] The data callback requested to disconnect the client #%d",
+					  this, _socket.GetSocket(), client->GetSocket().GetSocket());
+				DisconnectClient(client, new_state);
+				break;
+
+			case SocketConnectionState::Disconnected:
+				logtd("[%p] [#%d] Invalid socket state for client #%d",
+					  this, _socket.GetSocket(), client->GetSocket().GetSocket());
+				OV_ASSERT2(false);
+				DisconnectClient(client, new_state);
+				break;
+
+			case SocketConnectionState::Error: {
+				auto error = Error::CreateError("Connection", "The connection callback requested to disconnect the client #%d",
+												_socket.GetSocket(), client->GetSocket().GetSocket());
+				logtd("[%p] [#%d] %s", this, _socket.GetSocket(), error->ToString().CStr());
+				DisconnectClient(client, new_state, error);
+				break;
+			}
+		}
+	}
+
+	void ServerSocket::DispatchClosingClientEvents(const void *key, const epoll_event *event)
+	{
+		std::shared_ptr<ClientSocket> client = nullptr;
+		uint32_t epoll_events = event->events;
+
+		{
+			std::shared_lock<std::shared_mutex> lock(_client_list_mutex);
+			auto item = _closing_client_list.find(key);
+
+			if (item == _closing_client_list.end())
+			{
+				return;
+			}
+
+			client = item->second.client;
+		}
+
+		bool close = false;
+
+		if (OV_CHECK_FLAG(epoll_events, EPOLLERR) || OV_CHECK_FLAG(epoll_events, EPOLLHUP) || OV_CHECK_FLAG(epoll_events, EPOLLRDHUP))
+		{
+			logtd("[%p] [#%d] Closing client #%d is disconnected with events: %s", this, _socket.GetSocket(), client->GetSocket().GetSocket(), StringFromEpollEvent(event).CStr());
+			close = true;
+		}
+		else
+		{
+			if (OV_CHECK_FLAG(epoll_events, EPOLLIN))
+			{
+				// The data sent by the closing client is discarded
+				auto data = std::make_shared<Data>(TcpBufferSize);
+
+				if ((client->Recv(data) != nullptr) || (client->GetState() == SocketState::Error))
+				{
+					close = true;
+				}
+			}
+
+			if ((close == false) && OV_CHECK_FLAG(epoll_events, EPOLLOUT))
+			{
+				auto remained = client->FlushSendQueue();
+
+				if (remained <= 0L)
+				{
+					// All data are sent (or an error occurred)
+					logtd("[%p] [#%d] The send queue of closing client #%d is flushed (result: %zd)", this, _socket.GetSocket(), client->GetSocket().GetSocket(), remained);
+					close = true;
+				}
+				else
+				{
+					std::lock_guard<std::shared_mutex> lock(_client_list_mutex);
+					auto item = _closing_client_list.find(key);
+
+					if (item != _closing_client_list.end())
+					{
+						item->second.stop_watch.Update();
+					}
+				}
+			}
+		}
+
+		if (close)
+		{
+			CloseClosingClient(key);
+		}
+	}
+
+	void ServerSocket::CloseExpiredClients()
+	{
+		std::vector<const void *> expired_list;
+
+		{
+			std::shared_lock<std::shared_mutex> lock(_client_list_mutex);
+
+			for (const auto &item : _closing_client_list)
+			{
+				if (item.second.client->HasPendingData() == false)
+				{
+					// The send queue was flushed before the client is moved to the closing list
+					expired_list.push_back(item.first);
+				}
+				else if (item.second.stop_watch.IsElapsed(CLOSING_CLIENT_SEND_TIMEOUT))
+				{
+					logtw("[%p] [#%d] Could not flush the send queue of client %s in %d ms (%zu bytes remained)",
+						  this, _socket.GetSocket(), item.second.client->ToString().CStr(), CLOSING_CLIENT_SEND_TIMEOUT, item.second.client->GetSendQueueBytes());
+					expired_list.push_back(item.first);
+				}
+			}
+		}
+
+		for (const auto &key : expired_list)
+		{
+			CloseClosingClient(key);
+		}
+	}
+
+	void ServerSocket::CloseClosingClient(const void *key)
+	{
+		std::shared_ptr<ClientSocket> client = nullptr;
+
+		{
+			std::lock_guard<std::shared_mutex> lock(_client_list_mutex);
+			auto item = _closing_client_list.find(key);
+
+			if (item == _closing_client_list.end())
+			{
+				return;
+			}
+
+			client = item->second.client;
+
+			// To keep ClientSocket pointer while DispatchEvent() is running
+			_disconnected_client_list[key] = client;
+			_closing_client_list.erase(item);
+		}
+
+		RemoveFromEpoll(client.get());
+
+		if (client->GetState() != SocketState::Closed)
+		{
+			client->CloseInternal();
+		}
+	}
+
+	bool ServerSocket::PrepareIoUring()
+	{
+		if (
+			(
+				_io_uring->Initialize(IO_URING_ENTRY_COUNT) &&
+				_io_uring->RegisterBufferRing(IO_URING_BUFFER_GROUP_ID, IO_URING_BUFFER_COUNT, TcpBufferSize) &&
+				_io_uring->PrepareMultishotAccept(_socket.GetSocket(), MakeIoUringUserData(0, IoUringRequestType::Accept))) == false)
+		{
+			logte("[%p] [#%d] Could not prepare io_uring", this, _socket.GetSocket());
+			return false;
+		}
+
+		logti("[%p] [#%d] io_uring backend is used", this, _socket.GetSocket());
+
+		return true;
+	}
+
+	bool ServerSocket::DispatchIoUringEvent(int timeout)
+	{
+		if (_io_uring->Wait(timeout) == false)
+		{
+			return false;
+		}
+
+		for (int count = 0; count < EpollMaxEvents; count++)
+		{
+			auto completion = _io_uring->PeekCompletion();
+
+			if (completion == nullptr)
+			{
+				break;
+			}
+
+			// The completion entry may be overwritten by the kernel after ConsumeCompletion()
+			io_uring_cqe cqe = *completion;
+			_io_uring->ConsumeCompletion();
+
+			switch (static_cast<IoUringRequestType>(cqe.user_data & 0xFF))
+			{
+				case IoUringRequestType::None:
+					break;
+
+				case IoUringRequestType::Accept:
+					DispatchIoUringAccept(cqe);
+					break;
+
+				case IoUringRequestType::Recv:
+					DispatchIoUringRecv(cqe);
+					break;
+
+				case IoUringRequestType::Poll:
+					DispatchIoUringPoll(cqe);
+					break;
+			}
+		}
+
+		CloseExpiredClients();
+
+		// Garbage collection
+		{
+			std::lock_guard<std::shared_mutex> lock(_client_list_mutex);
+			_disconnected_client_list.clear();
+		}
+
+		return true;
+	}
+
+	void ServerSocket::DispatchIoUringAccept(const io_uring_cqe &cqe)
+	{
+		if (cqe.res >= 0)
+		{
+			sockaddr_storage remote{};
+			socklen_t remote_length = sizeof(remote);
+
+			::getpeername(cqe.res, reinterpret_cast<sockaddr *>(&remote), &remote_length);
+
+			auto client = AddClient(SocketWrapper(SocketType::Tcp, cqe.res), SocketAddress(remote));
+
+			if (client != nullptr)
+			{
+				DispatchConnected(client);
+			}
+		}
+		else if (cqe.res != -ECANCELED)
+		{
+			logtw("[%p] [#%d] Could not accept the client: %s", this, _socket.GetSocket(), ov::Error::CreateError(-cqe.res, "%s", ::strerror(-cqe.res))->ToString().CStr());
+		}
+
+		if ((OV_CHECK_FLAG(cqe.flags, IORING_CQE_F_MORE) == false) && (GetState() == SocketState::Listening))
+		{
+			// Multishot accept is terminated (e.g. too many open files), so request it again
+			_io_uring->PrepareMultishotAccept(_socket.GetSocket(), MakeIoUringUserData(0, IoUringRequestType::Accept));
+		}
+	}
+
+	void ServerSocket::DispatchIoUringRecv(const io_uring_cqe &cqe)
+	{
+		std::shared_ptr<Data> data = nullptr;
+
+		if (OV_CHECK_FLAG(cqe.flags, IORING_CQE_F_BUFFER))
+		{
+			auto buffer_id = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+
+			if (cqe.res > 0)
+			{
+				data = std::make_shared<Data>(_io_uring->GetBuffer(buffer_id), cqe.res);
+			}
+
+			// The buffer can be reused as soon as the data is copied
+			_io_uring->RecycleBuffer(buffer_id);
+		}
+
+		auto key = GetIoUringClientKey(cqe.user_data >> 8);
+
+		if (key == nullptr)
+		{
+			// The client is already removed
+			return;
+		}
+
+		std::shared_ptr<ClientSocket> client = nullptr;
+		bool is_closing = false;
+
+		{
+			std::shared_lock<std::shared_mutex> lock(_client_list_mutex);
+			auto item = _client_list.find(key);
+
+			if (item != _client_list.end())
+			{
+				client = item->second;
+			}
+			else
+			{
+				auto closing_item = _closing_client_list.find(key);
+
+				if (closing_item == _closing_client_list.end())
+				{
+					return;
+				}
+
+				client = closing_item->second.client;
+				is_closing = true;
+			}
+		}
+
+		if ((cqe.res == 0) || ((cqe.res < 0) && (cqe.res != -ENOBUFS)))
+		{
+			if (is_closing)
+			{
+				CloseClosingClient(key);
+			}
+			else if (cqe.res == 0)
+			{
+				logtd("[%p] [#%d] Client %s is disconnected", this, _socket.GetSocket(), client->ToString().CStr());
+				DisconnectClient(client, SocketConnectionState::Disconnected, nullptr);
+			}
+			else
+			{
+				auto error = Error::CreateError(-cqe.res, "%s", ::strerror(-cqe.res));
+				logtd("[%p] [#%d] An error occurred on client %s: %s", this, _socket.GetSocket(), client->ToString().CStr(), error->ToString().CStr());
+				DisconnectClient(client, SocketConnectionState::Error, error);
+			}
+
+			return;
+		}
+
+		if ((data != nullptr) && (is_closing == false))
+		{
+			// The data sent by the closing client is discarded
+			DispatchData(client, data);
+		}
+
+		if (OV_CHECK_FLAG(cqe.flags, IORING_CQE_F_MORE) == false)
+		{
+			// Multishot recv is terminated (e.g. there is no buffer to receive), so request it again
+			std::lock_guard<std::mutex> lock_guard(_io_uring_client_mutex);
+			auto item = _io_uring_client_list.find(key);
+
+			if (item != _io_uring_client_list.end())
+			{
+				_io_uring->PrepareMultishotRecv(item->second.fd, IO_URING_BUFFER_GROUP_ID, MakeIoUringUserData(item->second.token, IoUringRequestType::Recv));
+			}
+		}
+	}
+
+	void ServerSocket::DispatchIoUringPoll(const io_uring_cqe &cqe)
+	{
+		uint64_t token = cqe.user_data >> 8;
+		const void *key = nullptr;
+
+		{
+			std::lock_guard<std::mutex> lock_guard(_io_uring_client_mutex);
+			auto token_item = _io_uring_token_list.find(token);
+
+			if (token_item == _io_uring_token_list.end())
+			{
+				// The client is already removed
+				return;
+			}
+
+			key = token_item->second;
+			_io_uring_client_list[key].is_poll_requested = false;
+		}
+
+		if (cqe.res == -ECANCELED)
+		{
+			return;
+		}
+
+		// Convert the result to epoll_event to process in the same way as epoll
+		epoll_event event{};
+
+		event.data.ptr = const_cast<void *>(key);
+
+		if (cqe.res < 0)
+		{
+			event.events = EPOLLERR;
+		}
+		else
+		{
+			event.events |= OV_CHECK_FLAG(cqe.res, POLLOUT) ? EPOLLOUT : 0;
+			event.events |= OV_CHECK_FLAG(cqe.res, POLLERR) ? EPOLLERR : 0;
+			event.events |= OV_CHECK_FLAG(cqe.res, POLLHUP) ? EPOLLHUP : 0;
+		}
+
+		DispatchEvents(key, &event);
+
+		std::shared_ptr<ClientSocket> client = nullptr;
+
+		{
+			std::shared_lock<std::shared_mutex> lock(_client_list_mutex);
+			auto item = _client_list.find(key);
+
+			if (item != _client_list.end())
+			{
+				client = item->second;
+			}
+			else
+			{
+				auto closing_item = _closing_client_list.find(key);
+
+				if (closing_item != _closing_client_list.end())
+				{
+					client = closing_item->second.client;
+				}
+			}
+		}
+
+		if ((client != nullptr) && client->HasPendingData())
+		{
+			// Poll request is one-shot, so request it again until the send queue is flushed
+			RequestIoUringPoll(key);
+		}
+	}
+
+	const void *ServerSocket::GetIoUringClientKey(uint64_t token)
+	{
+		std::lock_guard<std::mutex> lock_guard(_io_uring_client_mutex);
+		auto item = _io_uring_token_list.find(token);
+
+		return (item != _io_uring_token_list.end()) ? item->second : nullptr;
+	}
+
+	bool ServerSocket::RequestIoUringPoll(const void *key)
+	{
+		std::lock_guard<std::mutex> lock_guard(_io_uring_client_mutex);
+		auto item = _io_uring_client_list.find(key);
+
+		if (item == _io_uring_client_list.end())
+		{
+			return false;
+		}
+
+		auto &client = item->second;
+
+		if (client.is_poll_requested)
+		{
+			// The previous request is not completed yet
+			return true;
+		}
+
+		client.is_poll_requested = _io_uring->PreparePollAdd(client.fd, POLLOUT, MakeIoUringUserData(client.token, IoUringRequestType::Poll));
+
+		return client.is_poll_requested;
+	}
+
+	bool ServerSocket::AddToEpoll(Socket *socket, void *parameter)
+	{
+		if ((_io_uring == nullptr) || (socket == this))
+		{
+			return Socket::AddToEpoll(socket, parameter);
+		}
+
+		std::lock_guard<std::mutex> lock_guard(_io_uring_client_mutex);
+
+		IoUringClient client{++_last_io_uring_token, socket->GetSocket().GetSocket(), false};
+
+		_io_uring_client_list[parameter] = client;
+		_io_uring_token_list[client.token] = parameter;
+
+		return _io_uring->PrepareMultishotRecv(client.fd, IO_URING_BUFFER_GROUP_ID, MakeIoUringUserData(client.token, IoUringRequestType::Recv));
+	}
+
+	bool ServerSocket::ModifyEpoll(Socket *socket, void *parameter, bool wait_for_writable)
+	{
+		if (_io_uring == nullptr)
+		{
+			return Socket::ModifyEpoll(socket, parameter, wait_for_writable);
+		}
+
+		if (wait_for_writable == false)
+		{
+			// The poll request is one-shot, so it will be completed without any action
+			return true;
+		}
+
+		return RequestIoUringPoll(parameter);
+	}
+
+	bool ServerSocket::RemoveFromEpoll(Socket *socket)
+	{
+		if ((_io_uring == nullptr) || (socket == this))
+		{
+			return Socket::RemoveFromEpoll(socket);
+		}
+
+		int fd = -1;
+
+		{
+			std::lock_guard<std::mutex> lock_guard(_io_uring_client_mutex);
+			auto item = _io_uring_client_list.find(socket);
+
+			if (item == _io_uring_client_list.end())
+			{
+				return true;
+			}
+
+			fd = item->second.fd;
+
+			_io_uring_token_list.erase(item->second.token);
+			_io_uring_client_list.erase(item);
+		}
+
+		// The completions of the cancelled requests are ignored since the token is removed
+		return _io_uring->PrepareCancel(fd);
+	}
+
 	bool ServerSocket::Close()
 	{
 		_client_list_mutex.lock();
 		auto client_list = std::move(_client_list);
+		auto closing_client_list = std::move(_closing_client_list);
 		_client_list_mutex.unlock();
 
 		for (const auto &client : client_list)
@@ -288,6 +826,27 @@ namespace ov
 			client.second->Close();
 		}
 
+		for (const auto &item : closing_client_list)
+		{
+			auto &client = item.second.client;
+
+			if (_io_uring != nullptr)
+			{
+				RemoveFromEpoll(client.get());
+			}
+
+			if (client->GetState() != SocketState::Closed)
+			{
+				client->CloseInternal();
+			}
+		}
+
+		if ((_io_uring != nullptr) && _socket.IsValid())
+		{
+			// Cancel the multishot accept
+			_io_uring->PrepareCancel(_socket.GetSocket());
+		}
+
 		return Socket::Close();
 	}
 
@@ -305,6 +864,8 @@ namespace ov
 		}
 
 		bool remove = false;
+		// If the server requests to disconnect, the data in the send queue should be sent before closing
+		bool flush_before_close = (state == SocketConnectionState::Disconnect) && client_socket->HasPendingData();
 
 		{
 			std::lock_guard<std::shared_mutex> lock(_client_list_mutex);
@@ -314,7 +875,20 @@ namespace ov
 			if (item != _client_list.end())
 			{
 				logtd("[%p] [#%d] Deleting the client %s from list...", this, _socket.GetSocket(), client_socket->ToString().CStr());
-				_disconnected_client_list[item->first] = item->second;
+
+				if (flush_before_close)
+				{
+					logtd("[%p] [#%d] The client %s will be closed after %zu bytes are sent", this, _socket.GetSocket(), client_socket->ToString().CStr(), client_socket->GetSendQueueBytes());
+
+					auto &closing_client = _closing_client_list[item->first];
+					closing_client.client = item->second;
+					closing_client.stop_watch.Start();
+				}
+				else
+				{
+					_disconnected_client_list[item->first] = item->second;
+				}
+
 				_client_list.erase(item);
 
 				remove = true;
@@ -332,6 +906,12 @@ namespace ov
 				_connection_callback(client_socket->GetSharedPtrAs<ClientSocket>(), state, error);
 			}
 
+			if (flush_before_close)
+			{
+				// The client will be closed in DispatchClosingClientEvents() or CloseExpiredClients()
+				return true;
+			}
+
 			if (RemoveFromEpoll(client_socket.get()))
 			{
 				if (client_socket->GetState() != SocketState::Closed)
@@ -367,6 +947,12 @@ namespace ov
 		if (type == SocketType::Tcp)
 		{
 			result &= SetSockOpt<int>(SO_REUSEADDR, 1);
+
+			if (_reuse_port)
+			{
+				// The kernel distributes new connections among the sockets bound to the same address
+				result &= SetSockOpt<int>(SO_REUSEPORT, 1);
+			}
 			// result &= SetSockOpt<int>(IPPROTO_TCP, TCP_NODELAY, 1);
 
 			int current_send_buffer_size;
@@ -8,10 +8,12 @@
 //==============================================================================
 #pragma once
 
+#include "io_uring.h"
 #include "socket.h"
 #include "socket_address.h"
 #include "socket_datastructure.h"
 #include <shared_mutex>
+#include <unordered_map>
 
 namespace ov
 {
@@ -36,6 +38,24 @@ namespace ov
 					 int recv_buffer_size,
 					 int backlog = SOMAXCONN);
 
+		// Allow multiple sockets to bind the same address (SO_REUSEPORT), must be called before Prepare()
+		void SetReusePort(bool reuse_port)
+		{
+			_reuse_port = reuse_port;
+		}
+
+		// Select the event mechanism, must be called before Prepare()
+		// (If io_uring is not available, epoll is used instead)
+		void SetBackend(SocketBackend backend)
+		{
+			_backend = backend;
+		}
+
+		SocketBackend GetBackend() const
+		{
+			return (_io_uring != nullptr) ? SocketBackend::IoUring : SocketBackend::Epoll;
+		}
+
 		virtual bool DispatchEvent(ClientConnectionCallback connection_callback, ClientDataCallback data_callback, int timeout = Infinite);
 
 		virtual std::shared_ptr<ClientSocket> Accept();
@@ -50,11 +70,23 @@ namespace ov
 		virtual bool DisconnectClient(std::shared_ptr<ClientSocket> client_socket, SocketConnectionState state, const std::shared_ptr<Error> &error = nullptr);
 		virtual bool DisconnectClient(ClientSocket *client_socket, SocketConnectionState state, const std::shared_ptr<Error> &error = nullptr);
 
+		// If the backend is io_uring, the requests of the client are registered to io_uring instead of epoll
+		bool AddToEpoll(Socket *socket, void *parameter) override;
+		bool ModifyEpoll(Socket *socket, void *parameter, bool wait_for_writable) override;
+		bool RemoveFromEpoll(Socket *socket) override;
+
 	protected:
 		virtual bool SetSocketOptions(SocketType type, int send_buffer_size, int recv_buffer_size);
 
+		std::shared_ptr<ClientSocket> AddClient(SocketWrapper client_socket, const SocketAddress &address);
+
 		void DispatchAccept();
+		void DispatchConnected(const std::shared_ptr<ClientSocket> &client);
+		void DispatchData(const std::shared_ptr<ClientSocket> &client, const std::shared_ptr<Data> &data);
 		void DispatchEvents(const void *key, const epoll_event *event);
+		void DispatchClosingClientEvents(const void *key, const epoll_event *event);
+		void CloseExpiredClients();
+		void CloseClosingClient(const void *key);
 
 		std::shared_mutex _client_list_mutex;
 		std::map<const void *, std::shared_ptr<ClientSocket>> _client_list;
@@ -62,6 +94,57 @@ namespace ov
 		// (In DispatchEvent(), the client_socket is not referenced as shared_ptr)
 		std::map<const void *, std::shared_ptr<ClientSocket>> _disconnected_client_list;
 
+		struct ClosingClient
+		{
+			std::shared_ptr<ClientSocket> client;
+			// Elapsed time since the last data was sent
+			StopWatch stop_watch;
+		};
+		// The clients requested to close, but the send queue is not flushed yet
+		std::map<const void *, ClosingClient> _closing_client_list;
+
+		bool _reuse_port = false;
+
+		// Related to io_uring backend
+		enum class IoUringRequestType : uint8_t
+		{
+			// The completion of the cancel request
+			None = 0,
+			Accept = 1,
+			Recv = 2,
+			Poll = 3
+		};
+
+		struct IoUringClient
+		{
+			// To ignore the completions of the closed client (the address of ClientSocket can be reused)
+			uint64_t token;
+			int fd;
+			bool is_poll_requested;
+		};
+
+		bool PrepareIoUring();
+		bool DispatchIoUringEvent(int timeout);
+		void DispatchIoUringAccept(const io_uring_cqe &cqe);
+		void DispatchIoUringRecv(const io_uring_cqe &cqe);
+		void DispatchIoUringPoll(const io_uring_cqe &cqe);
+		// Returns the key (ClientSocket *) of the token (nullptr if the client is already removed)
+		const void *GetIoUringClientKey(uint64_t token);
+		bool RequestIoUringPoll(const void *key);
+
+		static uint64_t MakeIoUringUserData(uint64_t token, IoUringRequestType type)
+		{
+			return (token << 8) | static_cast<uint64_t>(type);
+		}
+
+		SocketBackend _backend = SocketBackend::Epoll;
+		std::unique_ptr<IoUring> _io_uring;
+
+		std::mutex _io_uring_client_mutex;
+		uint64_t _last_io_uring_token = 0;
+		std::unordered_map<const void *, IoUringClient> _io_uring_client_list;
+		std::unordered_map<uint64_t, const void *> _io_uring_token_list;
+
 		ClientConnectionCallback _connection_callback = nullptr;
 		ClientDataCallback _data_callback = nullptr;
 	};
@@ -23,6 +23,12 @@
 /// 임시 코드
 #if !defined(__APPLE__)
 #	include <linux/sockios.h>
+#	include <netinet/udp.h>
+#endif
+
+#if !defined(__APPLE__) && !defined(UDP_SEGMENT)
+// Older glibc does not define UDP_SEGMENT (Linux 4.18+)
+#	define UDP_SEGMENT 103
 #endif
 #include <sys/ioctl.h>
 
@@ -140,6 +146,26 @@ public:
 					}
 				}
 				break;
+			case EPOLL_CTL_MOD:
+				// Only toggling EPOLLOUT of the descriptor which is already added is supported
+				if (event == nullptr)
+				{
+					return EINVAL;
+				}
+				{
+					std::lock_guard<decltype(_mutex)> lock(_mutex);
+					auto &epoll_fd_data = _epoll_data[epfd];
+					const auto it = epoll_fd_data.find(fd);
+					if (it == epoll_fd_data.end())
+					{
+						logte("socket %d has not been added to epoll %d", fd, epfd);
+						return EINVAL;
+					}
+					epoll_data = &(it->second);
+				}
+				ke.filter = EVFILT_WRITE;
+				ke.flags = (event->events & EPOLLOUT) ? EV_ADD : EV_DELETE;
+				break;
 		}
 		EV_SET(&ke, fd, ke.filter, ke.flags, 0, 0, epoll_data);
 		int result = kevent(epfd, &ke, 1, nullptr, 0, nullptr);
@@ -1036,6 +1062,51 @@ namespace ov
 		return &(_epoll_events[index]);
 	}
 
+	bool Socket::ModifyEpoll(Socket *socket, void *parameter, bool wait_for_writable)
+	{
+		CHECK_STATE(<= SocketState::Listening, false);
+
+		switch (GetType())
+		{
+			case SocketType::Tcp:
+			case SocketType::Udp:
+			{
+				if (_epoll == InvalidSocket)
+				{
+					logte("[%p] [#%d] Invalid epoll descriptor: %d", this, _socket.GetSocket(), _epoll);
+					OV_ASSERT2(_epoll != InvalidSocket);
+					return false;
+				}
+
+				epoll_event event{};
+
+				event.data.ptr = parameter;
+				event.events = EPOLLIN | EPOLLERR | EPOLLHUP | EPOLLRDHUP | (wait_for_writable ? EPOLLOUT : 0);
+
+				int result = ::epoll_ctl(_epoll, EPOLL_CTL_MOD, socket->_socket.GetSocket(), &event);
+
+				if (result != -1)
+				{
+					return true;
+				}
+
+				logte("[%p] [#%d] Could not modify epoll for descriptor %d (error: %s)", this, _socket.GetSocket(), socket->_socket.GetSocket(), Error::CreateErrorFromErrno()->ToString().CStr());
+
+				break;
+			}
+
+			case SocketType::Srt:
+				// SRT sockets don't use the send queue
+				OV_ASSERT2(false);
+				break;
+
+			default:
+				break;
+		}
+
+		return false;
+	}
+
 	bool Socket::RemoveFromEpoll(Socket *socket)
 	{
 		CHECK_STATE(== SocketState::Listening, false);
@@ -1212,7 +1283,7 @@ namespace ov
 						if (errno == EAGAIN)
 						{
 							// Suppress 'Resource temporarily available' error
-							::usleep(100);
+							// (Non-blocking sockets should use SendBuffered() to keep the rest of the data)
 							return total_sent;
 						}
 						else if (errno == EBADF)
@@ -1293,8 +1364,543 @@ namespace ov
 		return total_sent;
 	}
 
+	ssize_t Socket::SendNonBlocking(const SocketAddress *address, const void *data, size_t length)
+	{
+		int sock = _socket.GetSocket();
+		ssize_t sent = (address != nullptr)
+						   ? ::sendto(sock, data, length, MSG_NOSIGNAL | MSG_DONTWAIT, address->Address(), address->AddressLength())
+						   : ::send(sock, data, length, MSG_NOSIGNAL | MSG_DONTWAIT);
+
+		if (sent >= 0L)
+		{
+			return sent;
+		}
+
+		switch (errno)
+		{
+			case EAGAIN:
+#if EAGAIN != EWOULDBLOCK
+			case EWOULDBLOCK:
+#endif	// EAGAIN != EWOULDBLOCK
+			case EINTR:
+				// The socket buffer is full - try again when EPOLLOUT is raised
+				return 0L;
+
+			case EBADF:
+				// Suppress 'Bad file descriptor' error
+			case EPIPE:
+				// Suppress 'Broken pipe' error
+				break;
+
+			default:
+				logtw("[%p] [#%d] Could not send data: %zd (%s)", this, sock, sent, ov::Error::CreateErrorFromErrno()->ToString().CStr());
+				break;
+		}
+
+		return -1L;
+	}
+
+	bool Socket::EnqueueSendData(const SocketAddress *address, const void *data, size_t length, size_t sent, const std::shared_ptr<const Data> &owner, SendQueueWatermarkCallback *callback)
+	{
+		size_t remained = length - sent;
+
+		if ((_send_queue_bytes + remained) > _send_queue_limit)
+		{
+			logtw("[%p] [#%d] Send queue is full (pending: %zu bytes, limit: %zu bytes, data: %zu bytes)",
+				  this, _socket.GetSocket(), _send_queue_bytes, _send_queue_limit, remained);
+			return false;
+		}
+
+		if (owner != nullptr)
+		{
+			OV_ASSERT2(owner->GetData() == data);
+			_send_queue.emplace_back(owner, sent, address);
+		}
+		else
+		{
+			// Copy only the data that has not been sent
+			_send_queue.emplace_back(std::make_shared<const Data>(static_cast<const uint8_t *>(data) + sent, remained), 0UL, address);
+		}
+
+		_send_queue_bytes += remained;
+
+		logtd("[%p] [#%d] %zu bytes are enqueued (pending: %zu bytes)", this, _socket.GetSocket(), remained, _send_queue_bytes);
+
+		if ((_is_high_watermark_reached == false) && (_send_queue_bytes >= _send_queue_high_watermark))
+		{
+			_is_high_watermark_reached = true;
+			*callback = _watermark_callback;
+		}
+
+		return true;
+	}
+
+	ssize_t Socket::SendBuffered(const SocketAddress *address, const void *data, size_t length, const std::shared_ptr<const Data> &owner)
+	{
+		SendQueueWatermarkCallback callback = nullptr;
+
+		{
+			std::lock_guard<std::mutex> lock_guard(_send_queue_mutex);
+
+			if (_socket.IsValid() == false)
+			{
+				return -1L;
+			}
+
+			size_t sent = 0UL;
+
+			if (_send_queue.empty())
+			{
+				// Nothing is pending, so try to send the data directly
+				ssize_t result = SendNonBlocking(address, data, length);
+
+				if (result < 0L)
+				{
+					return result;
+				}
+
+				sent = static_cast<size_t>(result);
+
+				if (sent == length)
+				{
+					return static_cast<ssize_t>(length);
+				}
+
+				if (SetWritableNotification(true) == false)
+				{
+					logte("[%p] [#%d] Could not wait for the socket to be writable", this, _socket.GetSocket());
+					return (sent > 0UL) ? static_cast<ssize_t>(sent) : -1L;
+				}
+			}
+
+			if (EnqueueSendData(address, data, length, sent, owner, &callback) == false)
+			{
+				return (sent > 0UL) ? static_cast<ssize_t>(sent) : -1L;
+			}
+		}
+
+		if (callback != nullptr)
+		{
+			callback(GetSharedPtr(), true);
+		}
+
+		return static_cast<ssize_t>(length);
+	}
+
+	size_t Socket::SendMultipleNonBlocking(const SocketAddress &address, const std::shared_ptr<const Data> *data_list, size_t count)
+	{
+#if defined(__APPLE__)
+		// macOS does not support sendmmsg() and GSO
+		size_t index = 0;
+
+		for (; index < count; index++)
+		{
+			if (SendNonBlocking(&address, data_list[index]->GetData(), data_list[index]->GetLength()) == 0L)
+			{
+				// The socket buffer is full
+				break;
+			}
+		}
+
+		return index;
+#else   // defined(__APPLE__)
+		size_t processed = 0;
+
+		while (processed < count)
+		{
+			size_t remained = count - processed;
+
+			if (_is_gso_available)
+			{
+				size_t segment_count = GetGsoSegmentCount(data_list + processed, remained);
+
+				if (segment_count > 1)
+				{
+					ssize_t sent = SendGsoNonBlocking(address, data_list + processed, segment_count);
+
+					if (sent > 0L)
+					{
+						processed += segment_count;
+						continue;
+					}
+
+					if (sent == 0L)
+					{
+						// The socket buffer is full
+						break;
+					}
+
+					// Could not use GSO, send the datagrams using sendmmsg()
+				}
+				else
+				{
+					// Send the datagrams until the next GSO candidate appears
+					size_t index = 1;
+
+					while ((index < remained) && (GetGsoSegmentCount(data_list + processed + index, remained - index) <= 1))
+					{
+						index++;
+					}
+
+					remained = index;
+				}
+			}
+
+			size_t sent_count = SendMmsgNonBlocking(address, data_list + processed, remained);
+
+			processed += sent_count;
+
+			if (sent_count < remained)
+			{
+				// The socket buffer is full
+				break;
+			}
+		}
+
+		return processed;
+#endif  // defined(__APPLE__)
+	}
+
+#if !defined(__APPLE__)
+	size_t Socket::SendMmsgNonBlocking(const SocketAddress &address, const std::shared_ptr<const Data> *data_list, size_t count)
+	{
+		mmsghdr message_list[UdpSendBatchCount];
+		iovec iovec_list[UdpSendBatchCount];
+		int sock = _socket.GetSocket();
+		size_t processed = 0;
+
+		while (processed < count)
+		{
+			size_t batch_count = std::min(count - processed, static_cast<size_t>(UdpSendBatchCount));
+
+			for (size_t index = 0; index < batch_count; index++)
+			{
+				auto &data = data_list[processed + index];
+				auto &message = message_list[index];
+
+				iovec_list[index].iov_base = const_cast<void *>(data->GetData());
+				iovec_list[index].iov_len = data->GetLength();
+
+				message = {};
+				message.msg_hdr.msg_name = const_cast<sockaddr *>(address.Address());
+				message.msg_hdr.msg_namelen = address.AddressLength();
+				message.msg_hdr.msg_iov = &(iovec_list[index]);
+				message.msg_hdr.msg_iovlen = 1;
+			}
+
+			int sent = ::sendmmsg(sock, message_list, static_cast<unsigned int>(batch_count), MSG_NOSIGNAL | MSG_DONTWAIT);
+
+			if (sent < 0)
+			{
+				switch (errno)
+				{
+					case EAGAIN:
+#if EAGAIN != EWOULDBLOCK
+					case EWOULDBLOCK:
+#endif	// EAGAIN != EWOULDBLOCK
+					case EINTR:
+						// The socket buffer is full - try again when EPOLLOUT is raised
+						return processed;
+
+					default:
+						// sendmmsg() fails only if the first datagram could not be sent, so drop it and continue
+						logtw("[%p] [#%d] Could not send data: %zu bytes (%s)", this, sock, data_list[processed]->GetLength(), ov::Error::CreateErrorFromErrno()->ToString().CStr());
+						processed++;
+						continue;
+				}
+			}
+
+			// If some datagrams could not be sent, check the rest with the next call
+			// (If the socket buffer is full, the next call will fail with EAGAIN)
+			processed += sent;
+		}
+
+		return processed;
+	}
+
+	size_t Socket::GetGsoSegmentCount(const std::shared_ptr<const Data> *data_list, size_t count)
+	{
+		size_t segment_size = data_list[0]->GetLength();
+		size_t total_bytes = 0;
+		size_t index = 0;
+
+		count = std::min(count, static_cast<size_t>(UdpGsoMaxSegments));
+
+		while (index < count)
+		{
+			size_t length = data_list[index]->GetLength();
+
+			if ((length > segment_size) || (length == 0) || ((total_bytes + length) > UdpGsoMaxBytes))
+			{
+				break;
+			}
+
+			total_bytes += length;
+			index++;
+
+			if (length < segment_size)
+			{
+				// Only the last segment can be shorter than the others
+				break;
+			}
+		}
+
+		return index;
+	}
+
+	ssize_t Socket::SendGsoNonBlocking(const SocketAddress &address, const std::shared_ptr<const Data> *data_list, size_t count)
+	{
+		OV_ASSERT2(count <= static_cast<size_t>(UdpGsoMaxSegments));
+
+		iovec iovec_list[UdpGsoMaxSegments];
+		char control[CMSG_SPACE(sizeof(uint16_t))] = {};
+		msghdr message = {};
+
+		for (size_t index = 0; index < count; index++)
+		{
+			iovec_list[index].iov_base = const_cast<void *>(data_list[index]->GetData());
+			iovec_list[index].iov_len = data_list[index]->GetLength();
+		}
+
+		message.msg_name = const_cast<sockaddr *>(address.Address());
+		message.msg_namelen = address.AddressLength();
+		message.msg_iov = iovec_list;
+		message.msg_iovlen = count;
+		message.msg_control = control;
+		message.msg_controllen = sizeof(control);
+
+		// The kernel splits the payload into <segment size> datagrams
+		cmsghdr *cmsg = CMSG_FIRSTHDR(&message);
+		cmsg->cmsg_level = SOL_UDP;
+		cmsg->cmsg_type = UDP_SEGMENT;
+		cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+		*(reinterpret_cast<uint16_t *>(CMSG_DATA(cmsg))) = static_cast<uint16_t>(data_list[0]->GetLength());
+
+		int sock = _socket.GetSocket();
+		ssize_t sent = ::sendmsg(sock, &message, MSG_NOSIGNAL | MSG_DONTWAIT);
+
+		if (sent >= 0L)
+		{
+			return sent;
+		}
+
+		switch (errno)
+		{
+			case EAGAIN:
+#if EAGAIN != EWOULDBLOCK
+			case EWOULDBLOCK:
+#endif	// EAGAIN != EWOULDBLOCK
+			case EINTR:
+				// The socket buffer is full - try again when EPOLLOUT is raised
+				return 0L;
+
+			case EIO:
+				// The NIC does not support checksum offload
+			case EINVAL:
+			case ENOPROTOOPT:
+			case EOPNOTSUPP:
+				// The kernel does not support UDP_SEGMENT
+				logtw("[%p] [#%d] UDP GSO is not available, fall back to sendmmsg() (%s)", this, sock, ov::Error::CreateErrorFromErrno()->ToString().CStr());
+				_is_gso_available = false;
+				break;
+
+			default:
+				// Let sendmmsg() handle the error of each datagram
+				break;
+		}
+
+		return -1L;
+	}
+#endif  // !defined(__APPLE__)
+
+	ssize_t Socket::SendToBatch(const ov::SocketAddress &address, const std::vector<std::shared_ptr<const Data>> &data_list)
+	{
+		if (data_list.empty())
+		{
+			return 0L;
+		}
+
+		if ((_is_nonblock == false) || (GetType() != SocketType::Udp))
+		{
+			ssize_t count = 0L;
+
+			for (auto &data : data_list)
+			{
+				if (SendTo(address, data) < 0L)
+				{
+					return (count > 0L) ? count : -1L;
+				}
+
+				count++;
+			}
+
+			return count;
+		}
+
+		SendQueueWatermarkCallback callback = nullptr;
+		size_t processed = 0UL;
+
+		{
+			std::lock_guard<std::mutex> lock_guard(_send_queue_mutex);
+
+			if (_socket.IsValid() == false)
+			{
+				return -1L;
+			}
+
+			if (_send_queue.empty())
+			{
+				// Nothing is pending, so try to send the datagrams directly
+				processed = SendMultipleNonBlocking(address, data_list.data(), data_list.size());
+
+				if (processed == data_list.size())
+				{
+					return static_cast<ssize_t>(processed);
+				}
+
+				if (SetWritableNotification(true) == false)
+				{
+					logte("[%p] [#%d] Could not wait for the socket to be writable", this, _socket.GetSocket());
+					return (processed > 0UL) ? static_cast<ssize_t>(processed) : -1L;
+				}
+			}
+
+			// Keep the rest of the datagrams in order
+			for (; processed < data_list.size(); processed++)
+			{
+				auto &data = data_list[processed];
+
+				if (EnqueueSendData(&address, data->GetData(), data->GetLength(), 0UL, data, &callback) == false)
+				{
+					break;
+				}
+			}
+		}
+
+		if (callback != nullptr)
+		{
+			callback(GetSharedPtr(), true);
+		}
+
+		return (processed > 0UL) ? static_cast<ssize_t>(processed) : -1L;
+	}
+
+	ssize_t Socket::FlushSendQueue()
+	{
+		SendQueueWatermarkCallback callback = nullptr;
+		ssize_t remained = 0L;
+
+		{
+			std::lock_guard<std::mutex> lock_guard(_send_queue_mutex);
+
+			if (_socket.IsValid() == false)
+			{
+				return -1L;
+			}
+
+			while (_send_queue.empty() == false)
+			{
+				auto &item = _send_queue.front();
+				size_t length = item.data->GetLength() - item.offset;
+				ssize_t sent = SendNonBlocking(item.address.get(), item.data->GetDataAs<uint8_t>() + item.offset, length);
+
+				if (sent < 0L)
+				{
+					if (item.address != nullptr)
+					{
+						// Just drop the datagram that could not be sent
+						_send_queue_bytes -= length;
+						_send_queue.pop_front();
+						continue;
+					}
+
+					// The stream is broken, so the rest of the data is meaningless
+					_send_queue.clear();
+					_send_queue_bytes = 0UL;
+					SetWritableNotification(false);
+
+					return -1L;
+				}
+
+				item.offset += sent;
+				_send_queue_bytes -= sent;
+
+				if (static_cast<size_t>(sent) < length)
+				{
+					// The socket buffer is full
+					break;
+				}
+
+				_send_queue.pop_front();
+			}
+
+			if (_send_queue.empty())
+			{
+				SetWritableNotification(false);
+			}
+
+			if (_is_high_watermark_reached && (_send_queue_bytes <= _send_queue_low_watermark))
+			{
+				_is_high_watermark_reached = false;
+				callback = _watermark_callback;
+			}
+
+			remained = static_cast<ssize_t>(_send_queue_bytes);
+		}
+
+		if (callback != nullptr)
+		{
+			callback(GetSharedPtr(), false);
+		}
+
+		return remained;
+	}
+
+	bool Socket::SetWritableNotification(bool enable)
+	{
+		// The socket which is not added to epoll cannot use the send queue
+		return false;
+	}
+
+	void Socket::SetSendQueueWatermark(size_t low_watermark, size_t high_watermark, SendQueueWatermarkCallback callback)
+	{
+		OV_ASSERT2(low_watermark <= high_watermark);
+
+		std::lock_guard<std::mutex> lock_guard(_send_queue_mutex);
+
+		_send_queue_low_watermark = low_watermark;
+		_send_queue_high_watermark = high_watermark;
+		_watermark_callback = callback;
+	}
+
+	void Socket::SetSendQueueLimit(size_t limit)
+	{
+		std::lock_guard<std::mutex> lock_guard(_send_queue_mutex);
+
+		_send_queue_limit = limit;
+	}
+
+	size_t Socket::GetSendQueueBytes() const
+	{
+		std::lock_guard<std::mutex> lock_guard(_send_queue_mutex);
+
+		return _send_queue_bytes;
+	}
+
+	bool Socket::HasPendingData() const
+	{
+		std::lock_guard<std::mutex> lock_guard(_send_queue_mutex);
+
+		return (_send_queue.empty() == false);
+	}
+
 	ssize_t Socket::Send(const void *data, size_t length)
 	{
+		if (_is_nonblock && ((GetType() == SocketType::Tcp) || (GetType() == SocketType::Udp)))
+		{
+			return SendBuffered(nullptr, data, length, nullptr);
+		}
+
 		return SendInternal(data, length);
 	}
 
@@ -1307,7 +1913,12 @@ namespace ov
 			return -1LL;
 		}
 
-		return Send(data->GetData(), data->GetLength());
+		if (_is_nonblock && ((GetType() == SocketType::Tcp) || (GetType() == SocketType::Udp)))
+		{
+			return SendBuffered(nullptr, data->GetData(), data->GetLength(), data);
+		}
+
+		return SendInternal(data->GetData(), data->GetLength());
 	}
 
 	ssize_t Socket::SendTo(const ov::SocketAddress &address, const void *data, size_t length)
@@ -1322,6 +1933,11 @@ namespace ov
 			case SocketType::Udp:
 			case SocketType::Tcp:
 			{
+				if (_is_nonblock)
+				{
+					return SendBuffered(&address, data, length, nullptr);
+				}
+
 				while (true)
 				{
 					int result = ::sendto(_socket.GetSocket(), data, length, MSG_NOSIGNAL | (_is_nonblock ? MSG_DONTWAIT : 0), address.Address(), address.AddressLength());
@@ -1367,6 +1983,11 @@ namespace ov
 	{
 		OV_ASSERT2(data != nullptr);
 
+		if (_is_nonblock && (GetType() == SocketType::Udp))
+		{
+			return SendBuffered(&address, data->GetData(), data->GetLength(), data);
+		}
+
 		return SendTo(address, data->GetData(), data->GetLength());
 	}
 
@@ -1584,6 +2205,9 @@ namespace ov
 
 	bool Socket::CloseInternal()
 	{
+		// Prevent the descriptor from being closed while sending the data of the send queue
+		std::lock_guard<std::mutex> lock_guard(_send_queue_mutex);
+
 		[[maybe_unused]] SocketWrapper socket = _socket;
 
 #if USE_FILE_DUMP
@@ -1655,6 +2279,14 @@ namespace ov
 			_socket.Invalidate();
 			_socket.SetValid(false);
 
+			if (_send_queue.empty() == false)
+			{
+				logtd("[%p] [#%d] %zu bytes in the send queue are discarded", this, socket.GetSocket(), _send_queue_bytes);
+
+				_send_queue.clear();
+				_send_queue_bytes = 0UL;
+			}
+
 			// epoll 관련
 			OV_SAFE_FUNC(_epoll, InvalidSocket, ::close, );
 			OV_SAFE_FUNC(_srt_epoll, SRT_INVALID_SOCK, ::srt_epoll_release, );
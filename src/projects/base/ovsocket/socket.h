@@ -9,6 +9,7 @@
 #pragma once
 
 #include "socket_address.h"
+#include "socket_datastructure.h"
 
 #include <netinet/in.h>
 #if defined(__APPLE__)
@@ -34,6 +35,7 @@ static inline int epoll_create1(int)
 // epoll_ctl flags
 constexpr int EPOLL_CTL_ADD = 1;
 constexpr int EPOLL_CTL_DEL = 2;
+constexpr int EPOLL_CTL_MOD = 3;
 
 // epoll_event event values
 constexpr int EPOLLIN  		= 0x0001;
@@ -61,10 +63,13 @@ int epoll_wait(int epfd, struct epoll_event *events, int maxevents, int timeout)
 #endif
 #include <sys/socket.h>
 
+#include <deque>
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <utility>
+#include <vector>
 
 // for SRT
 #include <base/ovlibrary/ovlibrary.h>
@@ -241,6 +246,8 @@ namespace ov
 		virtual bool AddToEpoll(Socket *socket, void *parameter);
 		virtual int EpollWait(int timeout = Infinite);
 		virtual const epoll_event *EpollEvents(int index);
+		// Turn on/off EPOLLOUT notification of the socket (the socket must be added by AddToEpoll())
+		virtual bool ModifyEpoll(Socket *socket, void *parameter, bool wait_for_writable);
 		virtual bool RemoveFromEpoll(Socket *socket);
 
 		std::shared_ptr<SocketAddress> GetLocalAddress() const;
@@ -304,6 +311,10 @@ namespace ov
 		virtual ssize_t SendTo(const ov::SocketAddress &address, const void *data, size_t length);
 		virtual ssize_t SendTo(const ov::SocketAddress &address, const std::shared_ptr<const Data> &data);
 
+		// Send several datagrams to the same destination at once (using sendmmsg() if possible)
+		// Returns the number of datagrams sent or enqueued to the send queue (-1 if an error occurred)
+		virtual ssize_t SendToBatch(const ov::SocketAddress &address, const std::vector<std::shared_ptr<const Data>> &data_list);
+
 		// 데이터 수신
 		// 최대 ByteData의 capacity만큼 데이터를 기록
 		// false가 반환되면 error를 체크해야 함
@@ -314,6 +325,19 @@ namespace ov
 		// nullptr이 반환되면 errno를 체크해야 함
 		virtual std::shared_ptr<ov::Error> RecvFrom(std::shared_ptr<Data> &data, std::shared_ptr<ov::SocketAddress> *address);
 
+		// Send queue of the non-blocking socket
+		//
+		// If the data cannot be sent immediately (EAGAIN), it is kept in the send queue and
+		// flushed by FlushSendQueue() when EPOLLOUT is raised.
+		// The callback is called when the pending bytes exceed high_watermark, and when they drop below low_watermark again.
+		void SetSendQueueWatermark(size_t low_watermark, size_t high_watermark, SendQueueWatermarkCallback callback);
+		void SetSendQueueLimit(size_t limit);
+		size_t GetSendQueueBytes() const;
+		bool HasPendingData() const;
+
+		// Returns the number of bytes remaining in the send queue (-1 if an error occurred)
+		ssize_t FlushSendQueue();
+
 		// 소켓을 닫음
 		virtual bool Close();
 
@@ -325,8 +349,46 @@ namespace ov
 		static String StringFromEpollEvent(const epoll_event *event);
 		static String StringFromEpollEvent(const epoll_event &event);
 
+		struct SendQueueItem
+		{
+			SendQueueItem(const std::shared_ptr<const Data> &data, size_t offset, const SocketAddress *address)
+				: data(data),
+				  offset(offset),
+				  address((address != nullptr) ? std::make_shared<SocketAddress>(*address) : nullptr)
+			{
+			}
+
+			std::shared_ptr<const Data> data;
+			// Number of bytes already sent
+			size_t offset;
+			// Destination of the datagram (nullptr for connected socket)
+			std::shared_ptr<SocketAddress> address;
+		};
+
 		ssize_t SendInternal(const void *data, size_t length);
 		std::shared_ptr<ov::Error> RecvInternal(void *data, size_t length, size_t *received_length);
+
+		// Send the data immediately if possible, otherwise enqueue the rest of the data to the send queue
+		// (If owner is specified, the queue refers to the owner instead of copying the data)
+		ssize_t SendBuffered(const SocketAddress *address, const void *data, size_t length, const std::shared_ptr<const Data> &owner);
+		// Returns the number of bytes sent (0 if the socket buffer is full), or -1 if an error occurred
+		ssize_t SendNonBlocking(const SocketAddress *address, const void *data, size_t length);
+		// Send the datagrams using sendmmsg() until the socket buffer is full
+		// Returns the number of datagrams processed (sent or dropped due to an error)
+		size_t SendMultipleNonBlocking(const SocketAddress &address, const std::shared_ptr<const Data> *data_list, size_t count);
+		// Send the datagrams using sendmmsg() (_send_queue_mutex must be locked)
+		size_t SendMmsgNonBlocking(const SocketAddress &address, const std::shared_ptr<const Data> *data_list, size_t count);
+		// Returns the number of datagrams which can be sent as one GSO send (the last one may be shorter than the others)
+		static size_t GetGsoSegmentCount(const std::shared_ptr<const Data> *data_list, size_t count);
+		// Send the datagrams as one UDP_SEGMENT message
+		// Returns the number of bytes sent, 0 if the socket buffer is full, or -1 if GSO could not be used
+		ssize_t SendGsoNonBlocking(const SocketAddress &address, const std::shared_ptr<const Data> *data_list, size_t count);
+		// Append the data to the send queue (_send_queue_mutex must be locked)
+		// Returns false if the send queue is full
+		bool EnqueueSendData(const SocketAddress *address, const void *data, size_t length, size_t sent, const std::shared_ptr<const Data> &owner, SendQueueWatermarkCallback *callback);
+
+		// Called when EPOLLOUT needs to be turned on (the send queue is filled) or off (the send queue is flushed)
+		virtual bool SetWritableNotification(bool enable);
 		
 		virtual String ToString(const char *class_name) const;
 
@@ -351,5 +413,18 @@ namespace ov
 		int _last_epoll_event_count = 0;
 
 		volatile bool _force_stop = false;
+
+		// Related to send queue
+		mutable std::mutex _send_queue_mutex;
+		std::deque<SendQueueItem> _send_queue;
+		size_t _send_queue_bytes = 0;
+		size_t _send_queue_limit = SendQueueMaxSize;
+		size_t _send_queue_low_watermark = SendQueueLowWatermark;
+		size_t _send_queue_high_watermark = SendQueueHighWatermark;
+		bool _is_high_watermark_reached = false;
+		SendQueueWatermarkCallback _watermark_callback = nullptr;
+
+		// Whether UDP GSO can be used (turned off when the kernel or the NIC rejects it)
+		bool _is_gso_available = true;
 	};
 }  // namespace ov
@@ -223,6 +223,41 @@ namespace ov
 		return (operator !=(socket)) && (operator <(socket) == false);
 	}
 
+	size_t SocketAddress::Hash() const noexcept
+	{
+		// FNV-1a
+		size_t hash = static_cast<size_t>(14695981039346656037ULL);
+
+		auto combine = [&hash](const void *data, size_t length) {
+			auto bytes = static_cast<const uint8_t *>(data);
+
+			for(size_t index = 0; index < length; index++)
+			{
+				hash = (hash ^ bytes[index]) * static_cast<size_t>(1099511628211ULL);
+			}
+		};
+
+		combine(&(_address_storage.ss_family), sizeof(_address_storage.ss_family));
+
+		switch(_address_storage.ss_family)
+		{
+			case AF_INET:
+				combine(&(_address_ipv4->sin_addr), sizeof(_address_ipv4->sin_addr));
+				combine(&(_address_ipv4->sin_port), sizeof(_address_ipv4->sin_port));
+				break;
+
+			case AF_INET6:
+				combine(&(_address_ipv6->sin6_addr), sizeof(_address_ipv6->sin6_addr));
+				combine(&(_address_ipv6->sin6_port), sizeof(_address_ipv6->sin6_port));
+				break;
+
+			default:
+				break;
+		}
+
+		return hash;
+	}
+
 	bool SocketAddress::SetHostname(const char *hostname)
 	{
 		// 문자열로 부터 IP를 계산함
@@ -51,6 +51,9 @@ namespace ov
 		bool operator <(const SocketAddress &socket) const;
 		bool operator >(const SocketAddress &socket) const;
 
+		// Hash of the family, IP address and port (the addresses which are equal have the same hash)
+		size_t Hash() const noexcept;
+
 		void SetFamily(SocketFamily family)
 		{
 			_address_storage.ss_family = static_cast<sa_family_t>(family);
@@ -115,4 +118,17 @@ namespace ov
 		ov::String _hostname;
 		ov::String _ip_address;
 	};
-}
\ No newline at end of file
+}
+
+namespace std
+{
+	// To use ov::SocketAddress as a key of std::unordered_map
+	template <>
+	struct hash<ov::SocketAddress>
+	{
+		size_t operator()(const ov::SocketAddress &address) const noexcept
+		{
+			return address.Hash();
+		}
+	};
+}
@@ -35,6 +35,14 @@ namespace ov
 		Inet6 = AF_INET6,
 	};
 
+	// The mechanism used to wait for the socket events
+	enum class SocketBackend : int8_t
+	{
+		Epoll,
+		// Supported by ServerSocket (TCP) only, other sockets always use epoll
+		IoUring
+	};
+
 	class Socket;
 
 	// For TCP sockets
@@ -50,6 +58,23 @@ namespace ov
 
 	typedef std::function<void(const std::shared_ptr<ov::DatagramSocket> &client, const SocketAddress &remote_address, const std::shared_ptr<Data> &data)> DatagramCallback;
 
+	// Called when the pending bytes of the send queue exceed the high watermark (is_high == true),
+	// or drop below the low watermark again (is_high == false)
+	typedef std::function<void(const std::shared_ptr<ov::Socket> &socket, bool is_high)> SendQueueWatermarkCallback;
+
 	const ssize_t TcpBufferSize = 4096;
 	const ssize_t UdpBufferSize = 4096;
+
+	// Maximum number of datagrams handled by one recvmmsg()/sendmmsg() call
+	const int UdpRecvBatchCount = 32;
+	const int UdpSendBatchCount = 64;
+
+	// Limits of UDP GSO (Generic Segmentation Offload) - see UDP_MAX_SEGMENTS of the kernel
+	const int UdpGsoMaxSegments = 64;
+	const size_t UdpGsoMaxBytes = 65000;
+
+	// Limits of the send queue of non-blocking sockets (in bytes)
+	const size_t SendQueueLowWatermark = 1 * 1024 * 1024;
+	const size_t SendQueueHighWatermark = 4 * 1024 * 1024;
+	const size_t SendQueueMaxSize = 32 * 1024 * 1024;
 }  // namespace ov
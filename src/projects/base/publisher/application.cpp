@@ -168,6 +168,15 @@ namespace pub
 	bool Application::PushIncomingPacket(const std::shared_ptr<info::Session> &session_info,
 										 const std::shared_ptr<const ov::Data> &data)
 	{
+		auto session = std::static_pointer_cast<Session>(session_info);
+		auto &stream = session->GetStream();
+
+		// A sharded session receives in its own worker, not in the application thread
+		if ((stream != nullptr) && stream->IsSessionSharded())
+		{
+			return stream->PushIncomingPacket(session, data);
+		}
+
 		auto packet = std::make_shared<Application::IncomingPacket>(session_info, data);
 		_incoming_packet_queue.Enqueue(std::move(packet));
 
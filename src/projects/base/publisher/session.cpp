@@ -48,6 +48,18 @@ namespace pub
 		return true;
 	}
 
+	bool Session::SendOutgoingBatch(const std::vector<std::pair<uint32_t, std::shared_ptr<const ov::Data>>> &packet_list)
+	{
+		bool result = true;
+
+		for (auto &packet : packet_list)
+		{
+			result = SendOutgoingData(packet.first, packet.second) && result;
+		}
+
+		return result;
+	}
+
 	Session::SessionState Session::GetState()
 	{
 		return _state;
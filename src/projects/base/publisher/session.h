@@ -9,6 +9,9 @@
 
 #include <base/ovlibrary/ovlibrary.h>
 
+#include <utility>
+#include <vector>
+
 namespace pub
 {
 	class Application;
@@ -28,7 +31,10 @@ namespace pub
 		virtual bool Stop();
 
 		// 패킷을 전송한다.
-		virtual bool SendOutgoingData(uint32_t packet_type, const std::shared_ptr<ov::Data> &packet) = 0;
+		virtual bool SendOutgoingData(uint32_t packet_type, const std::shared_ptr<const ov::Data> &packet) = 0;
+		// 여러 패킷을 한번에 전송한다. (packet_type, packet)
+		// 묶어서 전송할 수 있는 Session은 이 함수를 재정의한다.
+		virtual bool SendOutgoingBatch(const std::vector<std::pair<uint32_t, std::shared_ptr<const ov::Data>>> &packet_list);
 		// 상위 Layer에서 Packet을 수신받는다.
 		virtual void OnPacketReceived(const std::shared_ptr<info::Session> &session_info, const std::shared_ptr<const ov::Data> &data) = 0;
 
@@ -56,7 +56,7 @@ namespace pub
 		NodeState GetState();
 
 		// 데이터를 upper에서 받는다. lower node로 보낸다.
-		virtual bool SendData(SessionNodeType from_node, const std::shared_ptr<ov::Data> &data) = 0;
+		virtual bool SendData(SessionNodeType from_node, const std::shared_ptr<const ov::Data> &data) = 0;
 		// 데이터를 lower에서 받는다. upper node로 보낸다.
 		virtual bool OnDataReceived(SessionNodeType from_node, const std::shared_ptr<const ov::Data> &data) = 0;
 
@@ -2,13 +2,23 @@
 #include "application.h"
 #include "publisher_private.h"
 
+#include <cinttypes>
+
 namespace pub
 {
-	StreamWorker::StreamWorker(const std::shared_ptr<Stream> &parent_stream)
-		: _packet_queue(nullptr, 500)
+	StreamWorker::StreamWorker(const std::shared_ptr<Stream> &parent_stream, ov::Executor *executor)
+		: _packet_queue(nullptr, 500, STREAM_WORKER_QUEUE_CAPACITY),
+		  _strand(executor)
 	{
 		_stop_thread_flag = true;
 		_parent = parent_stream;
+
+		_packet_list.reserve(STREAM_WORKER_BATCH_COUNT);
+		_session_packet_list.reserve(STREAM_WORKER_BATCH_COUNT);
+
+		_strand.SetHandler([this]() {
+			ProcessPackets();
+		});
 	}
 
 	StreamWorker::~StreamWorker()
@@ -29,7 +39,6 @@ namespace pub
 		_packet_queue.SetAlias(queue_name.CStr());
 		
 		_stop_thread_flag = false;
-		_worker_thread = std::thread(&StreamWorker::WorkerThread, this);
 
 		return true;
 	}
@@ -42,13 +51,11 @@ namespace pub
 		}
 
 		_stop_thread_flag = true;
-		// Generate Event
+		// Wake up the producer waiting for a free slot
 		_packet_queue.Stop();
-		_queue_event.Notify();
-		if(_worker_thread.joinable())
-		{
-			_worker_thread.join();
-		}
+		// Wait for the running ProcessPackets()
+		_strand.Stop();
+		_packet_queue.Clear();
 
 		std::lock_guard<std::shared_mutex> lock(_session_map_mutex);
 		for (auto const &x : _sessions)
@@ -111,58 +118,74 @@ namespace pub
 		return _sessions[id];
 	}
 
-	void StreamWorker::SendPacket(uint32_t type, std::shared_ptr<ov::Data> packet)
+	void StreamWorker::SendPacket(uint32_t type, const std::shared_ptr<const ov::Data> &packet)
 	{
+		if (_stop_thread_flag)
+		{
+			return;
+		}
+
+		// It is called by the tasks of the shared executor, which also runs _strand, so it must not wait for a free slot
 		auto stream_packet = std::make_shared<pub::StreamWorker::StreamPacket>(type, packet);
-		_packet_queue.Enqueue(std::move(stream_packet));
+		if (_packet_queue.TryEnqueue(std::move(stream_packet)) == false)
+		{
+			auto dropped_count = _dropped_packet_count.fetch_add(1) + 1;
+			if ((dropped_count % STREAM_WORKER_DROP_LOG_INTERVAL) == 1)
+			{
+				logtw("%s/%s/%s StreamWorker queue is full, the packet is dropped (total dropped: %" PRIu64 ")",
+					  _parent->GetApplicationTypeName(), _parent->GetApplicationName(), _parent->GetName().CStr(), dropped_count);
+			}
+		}
 
-		_queue_event.Notify();
+		// The queued packets are sent even if this one is dropped
+		_strand.Notify();
 	}
 
-	std::shared_ptr<StreamWorker::StreamPacket> StreamWorker::PopStreamPacket()
+	bool StreamWorker::PushIncomingPacket(const std::shared_ptr<Session> &session, const std::shared_ptr<const ov::Data> &data)
 	{
-		if (_packet_queue.IsEmpty())
+		if (_stop_thread_flag)
 		{
-			return nullptr;
+			return false;
 		}
 
-		auto data = _packet_queue.Dequeue();
-		if(data.has_value())
+		return _strand.Post([session, data]() {
+			session->OnPacketReceived(session, data);
+		});
+	}
+
+	void StreamWorker::ProcessPackets()
+	{
+		// Queue에 있는 패킷을 최대 STREAM_WORKER_BATCH_COUNT개씩 꺼낸다. 한번에 하나의 batch만 처리하고 다른 작업에 executor를 양보한다.
+		_packet_list.clear();
+		if (_stop_thread_flag || (_packet_queue.DequeueBatch(_packet_list, STREAM_WORKER_BATCH_COUNT, 0) == 0))
 		{
-			return data.value();
+			return;
 		}
 
-		return nullptr;
-	}
+		// Session은 payload를 수정하지 않으므로, 모든 Session이 같은 목록을 공유한다.
+		_session_packet_list.clear();
+		for (auto const &packet : _packet_list)
+		{
+			_session_packet_list.emplace_back(packet->_type, packet->_data);
+		}
 
-	void StreamWorker::WorkerThread()
-	{
-		std::shared_lock<std::shared_mutex> session_lock(_session_map_mutex, std::defer_lock);
-		// Queue Event를 기다린다.
-		while (!_stop_thread_flag)
+		std::shared_lock<std::shared_mutex> session_lock(_session_map_mutex);
+		// 모든 Session에 전송한다.
+		for (auto const &x : _sessions)
 		{
-			// Queue에 이벤트가 들어올때까지 무한 대기 한다.
-			// TODO: 향후 App 재시작 등의 기능을 위해 WaitFor(time) 기능을 구현한다.
-			_queue_event.Wait();
+			auto session = std::static_pointer_cast<Session>(x.second);
 
-			// Queue에서 패킷을 꺼낸다.
-			std::shared_ptr<StreamWorker::StreamPacket> packet = PopStreamPacket();
-			if (packet == nullptr)
-			{
-				continue;
-			}
+			session->SendOutgoingBatch(_session_packet_list);
+		}
+		session_lock.unlock();
 
-			session_lock.lock();
-			// 모든 Session에 전송한다.
-			for (auto const &x : _sessions)
-			{
-				auto session = std::static_pointer_cast<Session>(x.second);
+		// Release the payloads now, not in the next run
+		_packet_list.clear();
+		_session_packet_list.clear();
 
-				// Session will change data
-				std::shared_ptr<ov::Data> session_data = packet->_data->Clone();
-				session->SendOutgoingData(packet->_type, session_data);
-			}
-			session_lock.unlock();
+		if (_packet_queue.IsEmpty() == false)
+		{
+			_strand.Notify();
 		}
 	}
 
@@ -192,11 +215,17 @@ namespace pub
 			worker_count = MAX_STREAM_WORKER_THREAD_COUNT;
 		}
 
+		if (_session_sharding)
+		{
+			// Worker #n runs on the shard #n, and GetWorkerByStreamID() assigns a session to one of them
+			worker_count = ov::Executor::GetShardCount();
+		}
+
 		_worker_count = worker_count;
 		// Create WorkerThread
 		for (uint32_t i = 0; i < _worker_count; i++)
 		{
-			auto stream_worker = std::make_shared<StreamWorker>(GetSharedPtr());
+			auto stream_worker = std::make_shared<StreamWorker>(GetSharedPtr(), _session_sharding ? ov::Executor::GetShard(i) : nullptr);
 						
 			if (stream_worker->Start() == false)
 			{
@@ -301,6 +330,24 @@ namespace pub
 		return GetWorkerByStreamID(id)->GetSession(id);
 	}
 
+	bool Stream::PushIncomingPacket(const std::shared_ptr<Session> &session, const std::shared_ptr<const ov::Data> &data)
+	{
+		if (_session_sharding == false)
+		{
+			return false;
+		}
+
+		std::shared_lock<std::shared_mutex> worker_lock(_stream_worker_lock);
+
+		if (_stream_workers.empty())
+		{
+			// Stopped
+			return false;
+		}
+
+		return _stream_workers[session->GetId() % _stream_workers.size()]->PushIncomingPacket(session, data);
+	}
+
 	const std::map<session_id_t, std::shared_ptr<Session>> Stream::GetAllSessions()
 	{
 		std::shared_lock<std::shared_mutex> session_lock(_session_map_mutex);
@@ -314,6 +361,14 @@ namespace pub
 	}
 
 	bool Stream::BroadcastPacket(uint32_t packet_type, std::shared_ptr<ov::Data> packet)
+	{
+		// The packetizer owns the packet, so take a snapshot once (Clone() doesn't copy the payload, it is copied only if the packetizer modifies it later)
+		std::shared_ptr<const ov::Data> snapshot = packet->Clone();
+
+		return BroadcastPacket(packet_type, snapshot);
+	}
+
+	bool Stream::BroadcastPacket(uint32_t packet_type, const std::shared_ptr<const ov::Data> &packet)
 	{
 		std::shared_lock<std::shared_mutex> worker_lock(_stream_worker_lock);
 		// 모든 StreamWorker에 나눠준다.
@@ -8,13 +8,19 @@
 
 #define MIN_STREAM_WORKER_THREAD_COUNT 2
 #define MAX_STREAM_WORKER_THREAD_COUNT 72
+// Maximum number of packets that StreamWorker sends to a session at once
+#define STREAM_WORKER_BATCH_COUNT 32
+#define STREAM_WORKER_QUEUE_CAPACITY 4096
+// A log is printed once per this number of dropped packets
+#define STREAM_WORKER_DROP_LOG_INTERVAL 1000
 
 namespace pub
 {
 	class StreamWorker
 	{
 	public:
-		StreamWorker(const std::shared_ptr<Stream> &parent_stream);
+		// If executor is nullptr, the shared executor is used
+		StreamWorker(const std::shared_ptr<Stream> &parent_stream, ov::Executor *executor = nullptr);
 		~StreamWorker();
 
 		bool Start();
@@ -24,34 +30,40 @@ namespace pub
 		bool RemoveSession(session_id_t id);
 		std::shared_ptr<Session> GetSession(session_id_t id);
 
-		void SendPacket(uint32_t type, std::shared_ptr<ov::Data> packet);
+		void SendPacket(uint32_t type, const std::shared_ptr<const ov::Data> &packet);
+		// Passes the packet to session->OnPacketReceived() in the strand, so it is serialized with the sending of the session
+		bool PushIncomingPacket(const std::shared_ptr<Session> &session, const std::shared_ptr<const ov::Data> &data);
 
 	private:
-		void WorkerThread();
+		// Sends the queued packets to the sessions. It is called by _strand.
+		void ProcessPackets();
 
 		std::map<session_id_t, std::shared_ptr<Session>> _sessions;
 		std::shared_mutex _session_map_mutex;
-		ov::Semaphore _queue_event;
 
 		class StreamPacket
 		{
 		public:
-			StreamPacket(uint32_t type, std::shared_ptr<ov::Data> data)
+			StreamPacket(uint32_t type, const std::shared_ptr<const ov::Data> &data)
 			{
 				_type = type;
-				_data = data->Clone();
+				_data = data;
 			}
 
 			uint32_t _type;
-			std::shared_ptr<ov::Data> _data;
+			// Shared by all workers and sessions, so it must not be modified
+			std::shared_ptr<const ov::Data> _data;
 		};
 
-		std::shared_ptr<StreamPacket> PopStreamPacket();
-
-		ov::Queue<std::shared_ptr<StreamPacket>> _packet_queue;
+		ov::RingQueue<std::shared_ptr<StreamPacket>> _packet_queue;
+		// Packets dropped because the queue was full
+		std::atomic<uint64_t> _dropped_packet_count{0};
 
 		bool _stop_thread_flag;
-		std::thread _worker_thread;
+		// StreamWorker doesn't have a thread, ProcessPackets() runs on the shared executor
+		ov::Strand _strand;
+		std::vector<std::shared_ptr<StreamPacket>> _packet_list;
+		std::vector<std::pair<uint32_t, std::shared_ptr<const ov::Data>>> _session_packet_list;
 
 		std::shared_ptr<Stream> _parent;
 	};
@@ -69,6 +81,8 @@ namespace pub
 
 		// A child call this function to delivery packet to all sessions
 		bool BroadcastPacket(uint32_t packet_type, std::shared_ptr<ov::Data> packet);
+		// packet must not be modified after it is broadcast (it is not copied)
+		bool BroadcastPacket(uint32_t packet_type, const std::shared_ptr<const ov::Data> &packet);
 
 		// Child must implement this function for packetizing and call BroadcastPacket to delivery to all sessions.
 		virtual void SendVideoFrame(const std::shared_ptr<MediaPacket> &media_packet) = 0;
@@ -77,6 +91,15 @@ namespace pub
 		virtual bool Start(uint32_t worker_count);
 		virtual bool Stop();
 
+		// Returns true if each session is owned by a processor (see SetSessionSharding())
+		bool IsSessionSharded() const
+		{
+			return _session_sharding;
+		}
+
+		// Runs session->OnPacketReceived() in the worker of the session (only when the sessions are sharded)
+		bool PushIncomingPacket(const std::shared_ptr<Session> &session, const std::shared_ptr<const ov::Data> &data);
+
 		uint32_t IssueUniqueSessionId();
 
 		std::shared_ptr<Application> GetApplication();
@@ -85,7 +108,16 @@ namespace pub
 	protected:
 		Stream(const std::shared_ptr<Application> application, const info::Stream &info);
 		virtual ~Stream();
-		
+
+		// Must be called before Start().
+		// A worker is created for each executor shard (one per processor, and worker_count is ignored),
+		// and the incoming packets of a session are processed in its worker too.
+		// So a session is sent, received, protected and retransmitted by one core for its lifetime.
+		void SetSessionSharding(bool session_sharding)
+		{
+			_session_sharding = session_sharding;
+		}
+
 	private:
 		std::shared_ptr<StreamWorker> GetWorkerByStreamID(session_id_t session_id);
 		std::map<session_id_t, std::shared_ptr<Session>> _sessions;
@@ -93,6 +125,7 @@ namespace pub
 
 		uint32_t _worker_count;
 		bool _run_flag;
+		bool _session_sharding = false;
 		
 		std::shared_mutex _stream_worker_lock;
 		std::vector<std::shared_ptr<StreamWorker>>	_stream_workers;
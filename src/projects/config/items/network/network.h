@@ -0,0 +1,52 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2020 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovsocket/socket_datastructure.h>
+
+namespace cfg
+{
+	struct Network : public Item
+	{
+		CFG_DECLARE_GETTER_OF(GetTcpReactorCount, _tcp_reactor_count)
+		CFG_DECLARE_GETTER_OF(GetTcpBackend, _tcp_backend_value)
+
+	protected:
+		void MakeParseList() override
+		{
+			RegisterValue<Optional>("TcpReactorCount", &_tcp_reactor_count);
+			RegisterValue<Optional>("TcpBackend", &_tcp_backend, nullptr, [this]() -> bool {
+				ov::String backend = _tcp_backend.Trim().LowerCaseString();
+
+				if (backend == "epoll")
+				{
+					_tcp_backend_value = ov::SocketBackend::Epoll;
+				}
+				else if (backend == "io_uring")
+				{
+					_tcp_backend_value = ov::SocketBackend::IoUring;
+				}
+				else
+				{
+					return false;
+				}
+
+				return true;
+			});
+		}
+
+		// Number of listening sockets (SO_REUSEPORT) per TCP port, each of them runs its own epoll thread
+		// 0: Use a single listening socket with PhysicalPortWorkers
+		int _tcp_reactor_count = 0;
+
+		// Event mechanism of TCP server ports (epoll or io_uring, which is experimental and only accepts/receives)
+		ov::String _tcp_backend = "epoll";
+		ov::SocketBackend _tcp_backend_value = ov::SocketBackend::Epoll;
+	};
+}  // namespace cfg
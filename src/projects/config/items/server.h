@@ -9,6 +9,7 @@
 #pragma once
 
 #include "bind/bind.h"
+#include "network/network.h"
 #include "p2p/p2p.h"
 #include "virtual_hosts/virtual_hosts.h"
 namespace cfg
@@ -32,6 +33,8 @@ namespace cfg
 		CFG_DECLARE_REF_GETTER_OF(GetIp, _ip)
 		CFG_DECLARE_REF_GETTER_OF(GetBind, _bind)
 
+		CFG_DECLARE_REF_GETTER_OF(GetNetwork, _network)
+
 		CFG_DECLARE_REF_GETTER_OF(GetP2P, _p2p)
 
 		CFG_DECLARE_REF_GETTER_OF(GetVirtualHostList, _virtual_hosts.GetVirtualHostList())
@@ -77,6 +80,8 @@ namespace cfg
 			RegisterValue("IP", &_ip);
 			RegisterValue("Bind", &_bind);
 
+			RegisterValue<Optional>("Network", &_network);
+
 			RegisterValue<Optional>("P2P", &_p2p);
 
 			RegisterValue<Optional>("VirtualHosts", &_virtual_hosts);
@@ -92,6 +97,8 @@ namespace cfg
 		ov::String _ip;
 		bind::Bind _bind;
 
+		Network _network;
+
 		P2P _p2p;
 
 		VirtualHosts _virtual_hosts;
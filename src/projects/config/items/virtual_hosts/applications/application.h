@@ -37,6 +37,8 @@ namespace cfg
 		CFG_DECLARE_REF_GETTER_OF(GetProviders, _providers)
 		CFG_DECLARE_REF_GETTER_OF(GetPublishers, _publishers)
 		CFG_DECLARE_GETTER_OF(GetThreadCount, _publishers.GetThreadCount())
+		// Number of dispatchers that deliver the packets of the streams in parallel (0: number of processors)
+		CFG_DECLARE_GETTER_OF(GetMediaRouterDispatcherCount, _media_router_dispatcher_count)
 
 		bool HasEncodeWithCodec(const ov::String &profile_name,
 								cfg::StreamProfileUse use,
@@ -89,6 +91,7 @@ namespace cfg
 				return true;
 			});
 
+			RegisterValue<Optional>("MediaRouterDispatcherCount", &_media_router_dispatcher_count);
 			RegisterValue<Optional>("Origin", &_origin);
 			RegisterValue<Optional>("Decode", &_decode);
 			RegisterValue<Optional>("Encodes", &_encodes);
@@ -100,6 +103,7 @@ namespace cfg
 		ov::String _name;
 		ov::String _type;
 		ApplicationType _type_value;
+		int _media_router_dispatcher_count = 0;
 
 		Origin _origin;
 		Decode _decode;
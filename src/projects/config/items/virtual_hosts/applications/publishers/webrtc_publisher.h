@@ -16,14 +16,35 @@ namespace cfg
 	{
 		CFG_DECLARE_OVERRIDED_GETTER_OF(GetType, PublisherType::Webrtc)
 
+		// Pacing rate / bitrate of the session (0 disables pacing, which is the default)
+		CFG_DECLARE_GETTER_OF(GetPacingMultiplier, _pacing_multiplier)
+		// Maximum time (ms) a packet can be held by the pacer
+		CFG_DECLARE_GETTER_OF(GetMaxPacingDelay, _max_pacing_delay)
+		// Whether each session is owned by one processor (ThreadCount is ignored)
+		CFG_DECLARE_GETTER_OF(IsSessionSharding, _session_sharding)
+		// Whether the amount of FEC follows the packet loss of each session (otherwise FEC is always sent at the lowest level, opt-in)
+		CFG_DECLARE_GETTER_OF(IsAdaptiveFec, _adaptive_fec)
+		// Whether the adaptive FEC is turned off for the sessions without packet loss (they are recovered by retransmissions, opt-in)
+		CFG_DECLARE_GETTER_OF(IsDisableFecOnCleanPath, _disable_fec_on_clean_path)
+
 	protected:
 		void MakeParseList() override
 		{
 			Publisher::MakeParseList();
 
 			RegisterValue<Optional>("Timeout", &_timeout);
+			RegisterValue<Optional>("PacingMultiplier", &_pacing_multiplier);
+			RegisterValue<Optional>("MaxPacingDelay", &_max_pacing_delay);
+			RegisterValue<Optional>("SessionSharding", &_session_sharding);
+			RegisterValue<Optional>("AdaptiveFec", &_adaptive_fec);
+			RegisterValue<Optional>("DisableFecOnCleanPath", &_disable_fec_on_clean_path);
 		}
 
 		int _timeout = 0;
+		float _pacing_multiplier = 0.0f;
+		int _max_pacing_delay = 100;
+		bool _session_sharding = false;
+		bool _adaptive_fec = false;
+		bool _disable_fec_on_clean_path = false;
 	};
 }  // namespace cfg
\ No newline at end of file
@@ -38,3 +38,8 @@ std::shared_ptr<const HttpResponse> HttpClient::GetResponse() const
 {
 	return _response;
 }
+
+bool HttpClient::IsSendQueueCongested() const
+{
+	return _is_send_queue_congested;
+}
@@ -8,6 +8,7 @@
 //==============================================================================
 #pragma once
 
+#include <atomic>
 #include <mutex>
 #include "http_request.h"
 #include "http_response.h"
@@ -32,9 +33,15 @@ public:
 	std::shared_ptr<const HttpRequest> GetRequest() const;
 	std::shared_ptr<const HttpResponse> GetResponse() const;
 
+	// Whether the send queue of the socket is over the high watermark (the responses are not sent as fast as they are made)
+	bool IsSendQueueCongested() const;
+
 protected:
 	std::shared_ptr<HttpServer> _server = nullptr;
 
 	std::shared_ptr<HttpRequest> _request = nullptr;
 	std::shared_ptr<HttpResponse> _response = nullptr;
+
+	// Updated by the watermark callback of the socket (see HttpServer::ProcessConnect())
+	std::atomic<bool> _is_send_queue_congested{false};
 };
@@ -10,7 +10,10 @@
 #include "http_client.h"
 #include "http_private.h"
 
+#include <strings.h>
+
 #include <algorithm>
+#include <cstring>
 
 HttpRequest::HttpRequest(const std::shared_ptr<ov::ClientSocket> &client_socket, const std::shared_ptr<HttpRequestInterceptor> &interceptor)
 	: _client_socket(client_socket),
@@ -48,144 +51,176 @@ ssize_t HttpRequest::ProcessData(const std::shared_ptr<const ov::Data> &data)
 		return 0L;
 	}
 
-	const char NewLines[] = "\r\n\r\n";
-	// Exclude null character
-	const int NewLinesLength = OV_COUNTOF(NewLines) - 1;
+	size_t previous_length = 0;
+
+	if (_header_data == nullptr)
+	{
+		// Most requests are received at once, so refer to the data without copying it
+		_header_data = data;
+	}
+	else
+	{
+		// The header is split into several packets - accumulate the data
+		if (_header_data != _header_buffer)
+		{
+			if (_header_buffer == nullptr)
+			{
+				_header_buffer = std::make_shared<ov::Data>();
+			}
 
-	ssize_t used_length = data->GetLength();
+			_header_buffer->Append(_header_data);
+			_header_data = _header_buffer;
+		}
 
-	// Since the header has not been parsed yet, try to parse the header every time data comes in
-	ssize_t previous_length = _request_string.GetLength();
+		previous_length = _header_buffer->GetLength();
+		_header_buffer->Append(data);
+	}
 
-	// ov::String is binary-safe
-	_request_string.Append(data->GetDataAs<char>(), data->GetLength());
-	ssize_t newline_position = _request_string.IndexOf(&(NewLines[0]));
+	// Only the bytes received this time are scanned
+	_parse_status = ParseMessage();
 
-	if (newline_position >= 0)
+	switch (_parse_status)
 	{
-		// If the parser find "\r\n\r\n", start parsing
-		_request_string.SetLength(newline_position);
+		case HttpStatusCode::OK:
+			// Calculate some informations such as Content length
+			PostProcess();
 
-		// Used length =
-		//             [Length of string after finding "\r\n\r\n"] -
-		//             [Length of string before finding] +
-		//             [Length of string "\r\n\r\n"]
-		used_length = _request_string.GetLength() - previous_length + NewLinesLength;
+			// Used length = [Offset of the byte next to "\r\n\r\n"] - [Length of data before this packet]
+			return static_cast<ssize_t>(_scan_offset - previous_length);
 
-		_is_header_found = true;
-		_parse_status = ParseMessage();
+		case HttpStatusCode::PartialContent:
+			// Need more data
+			return data->GetLength();
 
-		if (_parse_status == HttpStatusCode::OK)
-		{
-			// Calculate some informations such as Content length
-			PostProcess();
-		}
-		else
-		{
+		default:
 			// An error occurred during parsing
-			used_length = -1L;
 			_parse_status = HttpStatusCode::BadRequest;
-		}
+			return -1L;
 	}
-	else
+}
+
+HttpStatusCode HttpRequest::ParseMessage()
+{
+	// RFC7230 - 3. Message Format
+	// HTTP-message   = start-line
+	//                  *( header-field CRLF )
+	//                  CRLF
+	//                  [ message-body ]
+	auto buffer = _header_data->GetDataAs<char>();
+	auto length = _header_data->GetLength();
+
+	while (_scan_offset < length)
 	{
-		// Need more data
+		char character = buffer[_scan_offset];
+		_scan_offset++;
+
+		if (character != '\n')
+		{
+			// Check if data consists of non-binary data (HTAB, CR, SP, VCHAR and obs-text are allowed)
+			if (((character >= 0x00) && (character < 0x20) && (character != '\t') && (character != '\r')) || (character == 0x7F))
+			{
+				logtw("Binary data found in the header (offset: %zu)", _scan_offset - 1);
+				return HttpStatusCode::BadRequest;
+			}
+
+			continue;
+		}
 
-		// Check if data consists of non-binary data
-		auto data_to_check = data->GetDataAs<char>();
-		auto remained = data->GetLength();
+		// A line is found: [_line_offset, _scan_offset - 1)
+		size_t line_end = _scan_offset - 1;
 
-		while (remained > 0)
+		if ((line_end == _line_offset) || (buffer[line_end - 1] != '\r'))
 		{
-			char character = *data_to_check;
+			logtw("Invalid line ending (offset: %zu)", line_end);
+			return HttpStatusCode::BadRequest;
+		}
 
-			// isprint(): 32 <= character <= 126
-			// isspace(): 9 <= character <= 13
-			// reference: https://en.cppreference.com/w/cpp/string/byte/isprint
-			if (::isprint(character) || ::isspace(character))
-			{
-				character++;
-				remained--;
+		size_t line_offset = _line_offset;
+		_line_offset = _scan_offset;
 
-				continue;
-			}
-			else
-			{
-				// Binary data found
-				used_length = -1;
-				_parse_status = HttpStatusCode::BadRequest;
-				break;
-			}
+		// Exclude "\r"
+		auto status_code = ParseLine(line_offset, line_end - 1 - line_offset);
+
+		if (status_code != HttpStatusCode::PartialContent)
+		{
+			return status_code;
 		}
 	}
 
-	return used_length;
+	return HttpStatusCode::PartialContent;
 }
 
-HttpStatusCode HttpRequest::ParseMessage()
+HttpStatusCode HttpRequest::ParseLine(size_t offset, size_t length)
 {
-	// RFC7230 - 3. Message Format
-	// HTTP-message   = start-line
-	//                  *( header-field CRLF )
-	//                  CRLF
-	//                  [ message-body ]
-
 	// RFC7230 - 3.1. Start Line
 	// start-line     = request-line / status-line
+	if (_is_request_line_parsed == false)
+	{
+		auto status_code = ParseRequestLine(_header_data->GetDataAs<char>() + offset, length);
 
-	// Tokenize by "\r\n"
-	std::vector<ov::String> tokens = _request_string.Split("\r\n");
-
-	HttpStatusCode status_code;
+		if (status_code != HttpStatusCode::OK)
+		{
+			return status_code;
+		}
 
-	status_code = ParseRequestLine(tokens[0]);
-	tokens.erase(tokens.begin());
+		_is_request_line_parsed = true;
+		return HttpStatusCode::PartialContent;
+	}
 
-	if (status_code == HttpStatusCode::OK)
+	if (length == 0)
 	{
-		for (const ov::String &token : tokens)
-		{
-			status_code = ParseHeader(token);
+		// An empty line - end of the header
+		_is_header_found = true;
 
-			if (status_code != HttpStatusCode::OK)
-			{
-				break;
-			}
-		}
-	}
+		logtd("Request Headers: %zu:", _header_field_list.size());
 
-	logtd("Request Headers: %ld:", _request_header.size());
+		std::for_each(_header_field_list.begin(), _header_field_list.end(), [this](const HeaderField &field) -> void {
+			logtd("\t>> %s: %s", GetHeaderFieldName(field).CStr(), GetHeaderFieldValue(field).CStr());
+		});
 
-	std::for_each(_request_header.begin(), _request_header.end(), [](const auto &pair) -> void {
-		logtd("\t>> %s: %s", pair.first.CStr(), pair.second.CStr());
-	});
+		return HttpStatusCode::OK;
+	}
+
+	auto status_code = ParseHeader(offset, length);
 
-	return status_code;
+	return (status_code == HttpStatusCode::OK) ? HttpStatusCode::PartialContent : status_code;
 }
 
-#define HTTP_COMPARE_METHOD(text, value_if_matches) \
-	if (method == text)                             \
-	{                                               \
-		_method = value_if_matches;                 \
+#define HTTP_COMPARE_METHOD(text, value_if_matches)                                        \
+	if ((method_length == (OV_COUNTOF(text) - 1)) && (::memcmp(line, text, method_length) == 0)) \
+	{                                                                                      \
+		_method = value_if_matches;                                                        \
 	}
 
-HttpStatusCode HttpRequest::ParseRequestLine(const ov::String &line)
+HttpStatusCode HttpRequest::ParseRequestLine(const char *line, size_t length)
 {
 	// RFC7230 - 3.1.1. Request Line
 	// request-line   = method SP request-target SP HTTP-version CRLF
-	ssize_t first_space_index = line.IndexOf(' ');
-	ssize_t last_space_index = line.IndexOfRev(' ');
+	auto first_space = static_cast<const char *>(::memchr(line, ' ', length));
+	const char *last_space = nullptr;
+
+	// memrchr() is not available on every platform
+	for (auto current = line + length; current > line; current--)
+	{
+		if (*(current - 1) == ' ')
+		{
+			last_space = current - 1;
+			break;
+		}
+	}
 
-	if ((first_space_index < 0) || (last_space_index < 0) || (first_space_index == last_space_index))
+	if ((first_space == nullptr) || (last_space == nullptr) || (first_space == last_space))
 	{
-		logtw("Invalid space index: first: %d, last: %d, line: %s", first_space_index, last_space_index, line.CStr());
+		logtw("Invalid space index: first: %zd, last: %zd, line: %.*s",
+			  (first_space != nullptr) ? (first_space - line) : -1L, (last_space != nullptr) ? (last_space - line) : -1L,
+			  static_cast<int>(length), line);
 		return HttpStatusCode::BadRequest;
 	}
 
 	_method = HttpMethod::Unknown;
 
 	// RFC7231 - 4. Request Methods
-	ov::String method = line.Left(static_cast<size_t>(first_space_index));
+	auto method_length = static_cast<size_t>(first_space - line);
 
 	HTTP_COMPARE_METHOD("GET", HttpMethod::Get);
 	HTTP_COMPARE_METHOD("HEAD", HttpMethod::Head);
@@ -198,7 +233,7 @@ HttpStatusCode HttpRequest::ParseRequestLine(const ov::String &line)
 
 	if (_method == HttpMethod::Unknown)
 	{
-		logtw("Unknown method: %s", method.CStr());
+		logtw("Unknown method: %.*s", static_cast<int>(method_length), line);
 		return HttpStatusCode::MethodNotAllowed;
 	}
 
@@ -207,18 +242,18 @@ HttpStatusCode HttpRequest::ParseRequestLine(const ov::String &line)
 	//            / absolute-form
 	//            / authority-form
 	//            / asterisk-form
-	_request_target = line.Substring(first_space_index + 1, static_cast<size_t>(last_space_index - first_space_index - 1));
+	_request_target = ov::String(first_space + 1, static_cast<size_t>(last_space - first_space - 1));
 
 	// RFC7230 - 2.6. Protocol Versioning
 	// HTTP-version  = HTTP-name "/" DIGIT "." DIGIT
 	// HTTP-name     = %x48.54.54.50 ; "HTTP", case-sensitive
-	_http_version = line.Substring(last_space_index + 1);
+	_http_version = ov::String(last_space + 1, static_cast<size_t>((line + length) - (last_space + 1)));
 
-	logtd("Method: [%s], uri: [%s], version: [%s]", method.CStr(), _request_target.CStr(), _http_version.CStr());
+	logtd("Method: [%.*s], uri: [%s], version: [%s]", static_cast<int>(method_length), line, _request_target.CStr(), _http_version.CStr());
 	return HttpStatusCode::OK;
 }
 
-HttpStatusCode HttpRequest::ParseHeader(const ov::String &line)
+HttpStatusCode HttpRequest::ParseHeader(size_t offset, size_t length)
 {
 	// RFC7230 - 3.2.  Header Fields
 	// header-field   = field-name ":" OWS field-value OWS
@@ -244,24 +279,95 @@ HttpStatusCode HttpRequest::ParseHeader(const ov::String &line)
 	// the obs-fold rule) unless the message is intended for packaging
 	// within the message/http media type.
 
-	ssize_t colon_index = line.IndexOf(':');
+	auto line = _header_data->GetDataAs<char>() + offset;
+	auto colon = static_cast<const char *>(::memchr(line, ':', length));
 
-	if (colon_index == -1)
+	if (colon == nullptr)
 	{
-		logtw("Invalid header (could not find colon): %s", line.CStr());
+		logtw("Invalid header (could not find colon): %.*s", static_cast<int>(length), line);
 		return HttpStatusCode::BadRequest;
 	}
 
-	// Convert all header names to uppercase
-	ov::String field_name = line.Left(static_cast<size_t>(colon_index)).UpperCaseString();
+	HeaderField field;
+
+	field.name_offset = offset;
+	field.name_length = static_cast<size_t>(colon - line);
+
 	// Eliminate OWS(optional white space) to simplify processing
-	ov::String field_value = line.Substring(colon_index + 1).Trim();
+	size_t value_offset = field.name_length + 1;
+	size_t value_end = length;
+
+	while ((value_offset < value_end) && ((line[value_offset] == ' ') || (line[value_offset] == '\t')))
+	{
+		value_offset++;
+	}
 
-	_request_header[field_name] = field_value;
+	while ((value_end > value_offset) && ((line[value_end - 1] == ' ') || (line[value_end - 1] == '\t')))
+	{
+		value_end--;
+	}
+
+	field.value_offset = offset + value_offset;
+	field.value_length = value_end - value_offset;
+
+	_header_field_list.push_back(field);
 
 	return HttpStatusCode::OK;
 }
 
+const HttpRequest::HeaderField *HttpRequest::FindHeaderField(const ov::String &key) const noexcept
+{
+	if (_header_data == nullptr)
+	{
+		return nullptr;
+	}
+
+	auto buffer = _header_data->GetDataAs<char>();
+	auto key_length = key.GetLength();
+
+	// If the same field appears more than once, the last one is used
+	for (auto field = _header_field_list.crbegin(); field != _header_field_list.crend(); ++field)
+	{
+		if ((field->name_length == key_length) && (::strncasecmp(buffer + field->name_offset, key.CStr(), key_length) == 0))
+		{
+			return &(*field);
+		}
+	}
+
+	return nullptr;
+}
+
+ov::String HttpRequest::GetHeaderFieldName(const HeaderField &field) const
+{
+	// Convert all header names to uppercase
+	return ov::String(_header_data->GetDataAs<char>() + field.name_offset, field.name_length).UpperCaseString();
+}
+
+ov::String HttpRequest::GetHeaderFieldValue(const HeaderField &field) const
+{
+	return ov::String(_header_data->GetDataAs<char>() + field.value_offset, field.value_length);
+}
+
+const std::map<ov::String, ov::String, ov::CaseInsensitiveComparator> &HttpRequest::GetRequestHeader() const noexcept
+{
+	if (_is_request_header_built == false)
+	{
+		_request_header.clear();
+
+		if (_header_data != nullptr)
+		{
+			for (const auto &field : _header_field_list)
+			{
+				_request_header[GetHeaderFieldName(field)] = GetHeaderFieldValue(field);
+			}
+		}
+
+		_is_request_header_built = true;
+	}
+
+	return _request_header;
+}
+
 ov::String HttpRequest::GetHeader(const ov::String &key) const noexcept
 {
 	return GetHeader(key, "");
@@ -269,19 +375,19 @@ ov::String HttpRequest::GetHeader(const ov::String &key) const noexcept
 
 ov::String HttpRequest::GetHeader(const ov::String &key, ov::String default_value) const noexcept
 {
-	auto item = _request_header.find(key.UpperCaseString());
+	auto field = FindHeaderField(key);
 
-	if (item == _request_header.cend())
+	if (field == nullptr)
 	{
 		return std::move(default_value);
 	}
 
-	return item->second;
+	return GetHeaderFieldValue(*field);
 }
 
 const bool HttpRequest::IsHeaderExists(const ov::String &key) const noexcept
 {
-	return _request_header.find(key.UpperCaseString()) != _request_header.cend();
+	return FindHeaderField(key) != nullptr;
 }
 
 void HttpRequest::PostProcess()
@@ -93,10 +93,8 @@ public:
 		return _request_body;
 	}
 
-	const std::map<ov::String, ov::String, ov::CaseInsensitiveComparator> &GetRequestHeader() const noexcept
-	{
-		return _request_header;
-	}
+	// The map is built from the parsed header fields when it is requested for the first time
+	const std::map<ov::String, ov::String, ov::CaseInsensitiveComparator> &GetRequestHeader() const noexcept;
 
 	ov::String GetHeader(const ov::String &key) const noexcept;
 	ov::String GetHeader(const ov::String &key, ov::String default_value) const noexcept;
@@ -136,7 +134,17 @@ public:
 		_parse_status = HttpStatusCode::PartialContent;
 
 		_is_header_found = false;
-		_request_string = "";
+		_header_data = nullptr;
+		if (_header_buffer != nullptr)
+		{
+			// Keep the allocated memory to parse the next request of the keep-alive connection
+			_header_buffer->SetLength(0);
+		}
+		_scan_offset = 0;
+		_line_offset = 0;
+		_is_request_line_parsed = false;
+		_header_field_list.clear();
+		_is_request_header_built = false;
 		_request_header.clear();
 
 		_method = HttpMethod::Unknown;
@@ -156,9 +164,25 @@ protected:
 		return _request_body;
 	}
 
+	// Location of the header field in _header_data
+	// (offsets are used instead of pointers since _header_buffer may be reallocated while appending data)
+	struct HeaderField
+	{
+		size_t name_offset;
+		size_t name_length;
+		size_t value_offset;
+		size_t value_length;
+	};
+
+	// Scan the bytes which are not scanned yet, and parse the lines found
 	HttpStatusCode ParseMessage();
-	HttpStatusCode ParseRequestLine(const ov::String &line);
-	HttpStatusCode ParseHeader(const ov::String &line);
+	HttpStatusCode ParseLine(size_t offset, size_t length);
+	HttpStatusCode ParseRequestLine(const char *line, size_t length);
+	HttpStatusCode ParseHeader(size_t offset, size_t length);
+
+	const HeaderField *FindHeaderField(const ov::String &key) const noexcept;
+	ov::String GetHeaderFieldName(const HeaderField &field) const;
+	ov::String GetHeaderFieldValue(const HeaderField &field) const;
 
 	void PostProcess();
 
@@ -178,9 +202,21 @@ protected:
 
 	// request 헤더
 	bool _is_header_found = false;
-	// 헤더 영역을 추출해내기 위해 임시로 사용되는 문자열 버퍼
-	ov::String _request_string;
-	std::map<ov::String, ov::String, ov::CaseInsensitiveComparator> _request_header;
+	// The data that contains the header
+	// (refers to the received data directly if the whole header is received at once, otherwise _header_buffer)
+	std::shared_ptr<const ov::Data> _header_data;
+	// Used to accumulate the data when the header is split into several packets
+	std::shared_ptr<ov::Data> _header_buffer;
+	// Offset of the next byte to scan in _header_data
+	size_t _scan_offset = 0;
+	// Offset of the line being scanned in _header_data
+	size_t _line_offset = 0;
+	bool _is_request_line_parsed = false;
+	std::vector<HeaderField> _header_field_list;
+
+	// Built from _header_field_list by GetRequestHeader()
+	mutable bool _is_request_header_built = false;
+	mutable std::map<ov::String, ov::String, ov::CaseInsensitiveComparator> _request_header;
 
 	// 자주 사용하는 헤더 값은 미리 저장해놓음
 	ssize_t _content_length = 0L;
@@ -55,6 +55,19 @@ bool HttpResponse::SetHeader(const ov::String &key, const ov::String &value)
 	return true;
 }
 
+bool HttpResponse::SetPrebuiltHeader(const std::shared_ptr<const ov::Data> &header)
+{
+	if (_is_header_sent)
+	{
+		logtw("Cannot modify header: Header is sent");
+		return false;
+	}
+
+	_prebuilt_header = header;
+
+	return true;
+}
+
 const ov::String &HttpResponse::GetHeader(const ov::String &key)
 {
 	auto item = _response_header.find(key);
@@ -113,9 +126,9 @@ uint32_t HttpResponse::SendHeaderIfNeeded()
 	std::shared_ptr<ov::Data> response = std::make_shared<ov::Data>();
 	ov::ByteStream stream(response.get());
 
-	if (_chunked_transfer == false)
+	if ((_chunked_transfer == false) && (_status_code != HttpStatusCode::NotModified))
 	{
-		// Calculate the content length
+		// Calculate the content length (304 doesn't have the content)
 		SetHeader("Content-Length", ov::Converter::ToString(_response_data_size));
 	}
 
@@ -132,6 +145,11 @@ uint32_t HttpResponse::SendHeaderIfNeeded()
 		stream.Append("\r\n", 2);
 	});
 
+	if (_prebuilt_header != nullptr)
+	{
+		stream.Append(_prebuilt_header);
+	}
+
 	stream.Append("\r\n", 2);
 
 	if (Send(response))
@@ -56,6 +56,8 @@ public:
 
 	bool SetHeader(const ov::String &key, const ov::String &value);
 	const ov::String &GetHeader(const ov::String &key);
+	// Header fields which are serialized already ("<name>: <value>\r\n"...), they are sent after the fields of SetHeader()
+	bool SetPrebuiltHeader(const std::shared_ptr<const ov::Data> &header);
 
 	// Enqueue the data into the queue (This data will be sent when SendResponse() is called)
 	// Can be used for response with content-length
@@ -111,6 +113,7 @@ protected:
 	bool _is_header_sent = false;
 
 	std::map<ov::String, ov::String> _response_header;
+	std::shared_ptr<const ov::Data> _prebuilt_header;
 
 	// FIXME(dimiden): It is supposed to be synchronized whenever a packet is sent, but performance needs to be improved
 	std::recursive_mutex _response_mutex;
@@ -248,6 +248,18 @@ std::shared_ptr<HttpClient> HttpServer::ProcessConnect(const std::shared_ptr<ov:
 
 	_client_list[remote.get()] = http_client;
 
+	// The publishers can throttle the client while its responses are piled up in the send queue
+	std::weak_ptr<HttpClient> weak_client = http_client;
+	client_socket->SetSendQueueWatermark(ov::SendQueueLowWatermark, ov::SendQueueHighWatermark, [weak_client](const std::shared_ptr<ov::Socket> &socket, bool is_high) {
+		auto client = weak_client.lock();
+
+		if (client != nullptr)
+		{
+			logtd("The send queue of the HTTP client(%s) is %s the watermark (%zu bytes)", socket->ToString().CStr(), is_high ? "over" : "under", socket->GetSendQueueBytes());
+			client->_is_send_queue_congested = is_high;
+		}
+	});
+
 	return std::move(http_client);
 }
 
@@ -12,6 +12,7 @@
 #include <base/ovlibrary/log_write.h>
 #include <config/config_manager.h>
 #include <mediarouter/mediarouter.h>
+#include <modules/physical_port/physical_port_manager.h>
 #include <monitoring/monitoring.h>
 #include <orchestrator/orchestrator.h>
 #include <providers/providers.h>
@@ -144,6 +145,11 @@ int main(int argc, char *argv[])
 	}
 
 	orchestrator->ApplyOriginMap(host_info_list);
+
+	// Socket settings must be applied before any port is created
+	auto &network_config = server_config->GetNetwork();
+	PhysicalPortManager::Instance()->SetTcpReactorCount(network_config.GetTcpReactorCount());
+	PhysicalPortManager::Instance()->SetTcpBackend(network_config.GetTcpBackend());
 	// Create an HTTP Manager for Segment Publishers
 	std::map<int, std::shared_ptr<HttpServer>> http_server_manager;
 
@@ -25,13 +25,31 @@ std::shared_ptr<MediaRouteApplication> MediaRouteApplication::Create(const info:
 }
 
 MediaRouteApplication::MediaRouteApplication(const info::Application &application_info)
-	: _application_info(application_info),
-	_indicator(nullptr, 100)
+	: _application_info(application_info)
 {
-	logti("Created media route application. application id(%u), (%s)"
-		, _application_info.GetId(), _application_info.GetName().CStr());
+	// 0 means the number of processors
+	size_t dispatcher_count = std::max(_application_info.GetConfig().GetMediaRouterDispatcherCount(), 0);
+
+	if (dispatcher_count == 0)
+	{
+		dispatcher_count = ov::Platform::GetProcessorCount();
+	}
 
-	_indicator.SetAlias(ov::String::FormatString("%s - MediaRouter Indicator Queue", _application_info.GetName().CStr()));
+	dispatcher_count = std::min<size_t>(dispatcher_count, MEDIAROUTE_MAX_DISPATCHER_COUNT);
+
+	auto queue_capacity = std::max<size_t>(MEDIAROUTE_INDICATOR_QUEUE_CAPACITY / dispatcher_count, MEDIAROUTE_INDICATOR_QUEUE_MIN_CAPACITY);
+
+	for (size_t index = 0; index < dispatcher_count; index++)
+	{
+		auto dispatcher = std::make_unique<Dispatcher>(queue_capacity);
+
+		dispatcher->indicator.SetAlias(ov::String::FormatString("%s - MediaRouter Indicator Queue #%zu", _application_info.GetName().CStr(), index));
+
+		_dispatcher_list.push_back(std::move(dispatcher));
+	}
+
+	logti("Created media route application. application id(%u), (%s), dispatchers(%zu)"
+		, _application_info.GetId(), _application_info.GetName().CStr(), dispatcher_count);
 }
 
 MediaRouteApplication::~MediaRouteApplication()
@@ -42,17 +60,15 @@ MediaRouteApplication::~MediaRouteApplication()
 
 bool MediaRouteApplication::Start()
 {
-	try
-	{
-		_kill_flag = false;
+	_kill_flag = false;
 
-		_thread = std::thread(&MediaRouteApplication::MessageLooper, this);
-	}
-	catch (const std::system_error &e)
+	for (auto &dispatcher : _dispatcher_list)
 	{
-		_kill_flag = true;
-		logte("Failed to start media route application thread.");
-		return false;
+		auto dispatcher_ptr = dispatcher.get();
+
+		dispatcher->strand.SetHandler([this, dispatcher_ptr]() {
+			ProcessIndicators(dispatcher_ptr);
+		});
 	}
 
 	return true;
@@ -62,12 +78,14 @@ bool MediaRouteApplication::Stop()
 {
 	_kill_flag = true;
 	
-	_indicator.Stop();
-	_indicator.Clear();
-
-	if(_thread.joinable())
+	for (auto &dispatcher : _dispatcher_list)
 	{
-		_thread.join();
+		dispatcher->indicator.Stop();
+
+		// Wait for the running ProcessIndicators()
+		dispatcher->strand.Stop();
+
+		dispatcher->indicator.Clear();
 	}
 
 	// TODO: Delete All Stream
@@ -495,7 +513,17 @@ bool MediaRouteApplication::OnReceiveBuffer(
 		}
 	}
 	
-	_indicator.Enqueue(std::make_shared<BufferIndicator>(indicator, stream_info->GetId()));
+	// This may be called by a task of the executor (e.g. an encoder), so it must not wait for ProcessIndicators() which runs on the same executor.
+	// If the queue is full, the packets are delivered by the next indicator of the stream, since all packets of a stream are processed at once.
+	auto dispatcher = GetDispatcher(stream_info->GetId());
+
+	if(dispatcher->indicator.TryEnqueue(BufferIndicator(indicator, stream_info->GetId())) == false)
+	{
+		logtw("Indicator queue is full, the packet will be delivered later. application(%s), stream(%s)"
+				, _application_info.GetName().CStr(), stream_info->GetName().CStr());
+	}
+
+	dispatcher->strand.Notify();
 
 	return true;
 }
@@ -530,15 +558,14 @@ std::shared_ptr<MediaRouteStream> MediaRouteApplication::GetStream(
 	return nullptr;
 }
 
-void MediaRouteApplication::MessageLooper()
+void MediaRouteApplication::ProcessIndicators(Dispatcher *dispatcher)
 {
-	while (!_kill_flag)
+	for (int count = 0; (count < MEDIAROUTE_INDICATOR_BATCH_COUNT) && (_kill_flag == false); count++)
 	{
-		auto msg = _indicator.Dequeue(100);
+		auto msg = dispatcher->indicator.TryDequeue();
 		if (msg.has_value() == false)
 		{
-			// It may be called due to a normal stop signal.
-			continue;
+			return;
 		}
 		auto &indicator = msg.value();
 
@@ -546,17 +573,17 @@ void MediaRouteApplication::MessageLooper()
 		std::shared_ptr<MediaRouteStream> stream = nullptr;
 
 		std::shared_lock<std::shared_mutex> lock(_streams_lock);
-		switch(indicator->_inout)
+		switch(indicator._inout)
 		{
 			case BufferIndicator::BUFFER_INDICATOR_INCOMING_STREAM:
 			{
-				auto it = _streams_incoming.find(indicator->_stream_id);
+				auto it = _streams_incoming.find(indicator._stream_id);
 				stream = (it != _streams_incoming.end()) ? it->second : nullptr;
 			} break;
 
 			case BufferIndicator::BUFFER_INDICATOR_OUTGOING_STREAM:
 			{
-				auto it = _streams_outgoing.find(indicator->_stream_id);
+				auto it = _streams_outgoing.find(indicator._stream_id);
 				stream = (it != _streams_outgoing.end()) ? it->second : nullptr;			
 			} break;
 			
@@ -570,7 +597,7 @@ void MediaRouteApplication::MessageLooper()
 
 		if (stream == nullptr)
 		{
-			logtw("Not found stream - strem_id(%u)", indicator->_stream_id);
+			logtw("Not found stream - strem_id(%u)", indicator._stream_id);
 			continue;
 		}
 
@@ -594,7 +621,7 @@ void MediaRouteApplication::MessageLooper()
 				auto observer_type = observer->GetObserverType();
 
 				// Provider (from incoming stream) -> MediaRouter -> Transcoder
-				if(indicator->_inout == BufferIndicator::BUFFER_INDICATOR_INCOMING_STREAM)
+				if(indicator._inout == BufferIndicator::BUFFER_INDICATOR_INCOMING_STREAM)
 				{
 					if(observer_type == MediaRouteApplicationObserver::ObserverType::Transcoder)
 					{
@@ -604,7 +631,7 @@ void MediaRouteApplication::MessageLooper()
 					}
 				}
 				// Transcoder or RelayClient (from outgoing stream) -> MediaRouter -> Publisher
-				else if(indicator->_inout == BufferIndicator::BUFFER_INDICATOR_OUTGOING_STREAM)
+				else if(indicator._inout == BufferIndicator::BUFFER_INDICATOR_OUTGOING_STREAM)
 				{
 					if(observer_type == MediaRouteApplicationObserver::ObserverType::Publisher)
 					{
@@ -616,5 +643,9 @@ void MediaRouteApplication::MessageLooper()
 		}
 	}
 
-	logtd("MessageLooper thread has been stopped");
+	if (dispatcher->indicator.IsEmpty() == false)
+	{
+		// Give the worker to the other tasks, and continue in the next run
+		dispatcher->strand.Notify();
+	}
 }
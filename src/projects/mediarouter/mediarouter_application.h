@@ -23,6 +23,15 @@
 
 #include <config/items/items.h>
 
+// Every packet pushed by a provider/transcoder adds an indicator, so keep enough room for bursts of many streams
+// (The capacity is divided by the dispatchers, but each of them has at least MEDIAROUTE_INDICATOR_QUEUE_MIN_CAPACITY)
+#define MEDIAROUTE_INDICATOR_QUEUE_CAPACITY 8192
+#define MEDIAROUTE_INDICATOR_QUEUE_MIN_CAPACITY 1024
+// Maximum number of indicators that are processed in a run of the strand
+#define MEDIAROUTE_INDICATOR_BATCH_COUNT 64
+// Maximum number of dispatchers per application
+#define MEDIAROUTE_MAX_DISPATCHER_COUNT 64
+
 class ApplicationInfo;
 class Stream;
 class RelayServer;
@@ -44,7 +53,6 @@ public:
 	bool Stop();
 
 	volatile bool _kill_flag;
-	std::thread _thread;
 
 public:
 	// Register/unregister connector from provider
@@ -119,8 +127,6 @@ public:
 
 
 public:
-	void MessageLooper();
-
 	class BufferIndicator
 	{
 	public:
@@ -142,5 +148,27 @@ public:
 	};
 
 protected:
-	ov::Queue<std::shared_ptr<BufferIndicator>> _indicator;
+	// Streams are distributed to the dispatchers by stream id.
+	// The packets of a stream are always delivered by the same dispatcher in order,
+	// and the dispatchers deliver the packets of different streams in parallel on the shared executor.
+	struct Dispatcher
+	{
+		explicit Dispatcher(size_t queue_capacity)
+			: indicator(nullptr, 100, queue_capacity)
+		{
+		}
+
+		ov::RingQueue<BufferIndicator> indicator;
+		ov::Strand strand;
+	};
+
+	// Delivers the packets of the streams in the indicator queue of the dispatcher. It is called by the strand of the dispatcher.
+	void ProcessIndicators(Dispatcher *dispatcher);
+
+	Dispatcher *GetDispatcher(uint32_t stream_id)
+	{
+		return _dispatcher_list[stream_id % _dispatcher_list.size()].get();
+	}
+
+	std::vector<std::unique_ptr<Dispatcher>> _dispatcher_list;
 };
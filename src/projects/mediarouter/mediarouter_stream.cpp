@@ -204,49 +204,40 @@ bool MediaRouteStream::ParseTrackInfo(std::shared_ptr<MediaTrack> &media_track,
 		case MediaCodecId::H264:
 			if(media_packet->GetBitstreamFormat() == common::BitstreamFormat::H264_ANNEXB)
 			{
-				// Analyzes NALU packets and extracts track information for SPS/PPS types.
+				// Extracts track information from SPS, which is found while building the NAL unit index in ParseAdditionalData()
 				auto payload_data = media_packet->GetData()->GetDataAs<uint8_t>();
-				auto frag_hdr = media_packet->GetFragHeader();
-				if(frag_hdr == nullptr)
+				auto &nal_unit_index = media_packet->GetNalUnitIndex();
+				if(nal_unit_index == nullptr)
 				{
-					logte("Could not find fragment header");
+					logte("Could not find NAL unit index");
 					return false;
 				}
 
-				for (size_t i = 0; i < frag_hdr->GetCount(); ++i) 
+				auto sps_unit = nal_unit_index->Find(static_cast<uint8_t>(H264NalUnitType::Sps));
+				if(sps_unit != nullptr)
 				{
-					const uint8_t* buffer = &payload_data[frag_hdr->fragmentation_offset[i]];
-					size_t length = frag_hdr->fragmentation_length[i];
+					const uint8_t* buffer = &payload_data[sps_unit->offset];
+					size_t length = sps_unit->length;
 
-					H264NalUnitHeader header;
-					if(H264Parser::ParseNalUnitHeader(buffer, length, header) == false)
+					H264SPS sps;
+					if(H264Parser::ParseSPS(buffer, length, sps) == false)
 					{
-						logte("Could not parse H264 Nal unit header");
+						logte("Could not parse H264 SPS unit");
 						return false;
-					}
-					
-					if(header.GetNalUnitType() == H264NalUnitType::Sps)
-					{
-						H264SPS sps;
-						if(H264Parser::ParseSPS(buffer, length, sps) == false)
-						{
-							logte("Could not parse H264 SPS unit");
-							return false;
 
-						}
+					}
 
-						media_track->SetWidth(sps.GetWidth());
-						media_track->SetHeight(sps.GetHeight());
-						media_track->SetTimeBase(1, 90000);
+					media_track->SetWidth(sps.GetWidth());
+					media_track->SetHeight(sps.GetHeight());
+					media_track->SetTimeBase(1, 90000);
 
-						logtd("%s", sps.GetInfoString().CStr());
-						logtd("[%d] Convert timebase (%d/%d) to (%d/%d)"
-							, media_track->GetId()
-							, _incoming_tiembase[media_track->GetId()].GetNum(), _incoming_tiembase[media_track->GetId()].GetDen()
-							, media_track->GetTimeBase().GetNum(), media_track->GetTimeBase().GetDen());
+					logtd("%s", sps.GetInfoString().CStr());
+					logtd("[%d] Convert timebase (%d/%d) to (%d/%d)"
+						, media_track->GetId()
+						, _incoming_tiembase[media_track->GetId()].GetNum(), _incoming_tiembase[media_track->GetId()].GetDen()
+						, media_track->GetTimeBase().GetNum(), media_track->GetTimeBase().GetDen());
 
-						SetParseTrackInfo(media_track, true);
-					}
+					SetParseTrackInfo(media_track, true);
 				}
 			}
 			break;
@@ -254,48 +245,39 @@ bool MediaRouteStream::ParseTrackInfo(std::shared_ptr<MediaTrack> &media_track,
 		case MediaCodecId::H265:
 			if(media_packet->GetBitstreamFormat() == common::BitstreamFormat::H265_ANNEXB)
 			{
-				// Analyzes NALU packets and extracts track information for SPS/PPS types.
+				// Extracts track information from SPS, which is found while building the NAL unit index in ParseAdditionalData()
 				auto payload_data = media_packet->GetData()->GetDataAs<uint8_t>();
-				auto frag_hdr = media_packet->GetFragHeader();
-				if(frag_hdr == nullptr)
+				auto &nal_unit_index = media_packet->GetNalUnitIndex();
+				if(nal_unit_index == nullptr)
 				{
-					logte("Could not find fragment header");
+					logte("Could not find NAL unit index");
 					return false;
 				}
-				
-				for (size_t i = 0; i < frag_hdr->GetCount(); ++i) 
+
+				auto sps_unit = nal_unit_index->Find(static_cast<uint8_t>(H265NALUnitType::SPS));
+				if(sps_unit != nullptr)
 				{
-					const uint8_t* buffer = &payload_data[frag_hdr->fragmentation_offset[i]];
-					size_t length = frag_hdr->fragmentation_length[i];
+					const uint8_t* buffer = &payload_data[sps_unit->offset];
+					size_t length = sps_unit->length;
 
-					H265NalUnitHeader header;
-					if(H265Parser::ParseNalUnitHeader(buffer, length, header) == false)
+					H265SPS sps;
+					if(H265Parser::ParseSPS(buffer, length, sps) == false)
 					{
-						logte("Could not parse H265 Nal unit header");
+						logte("Could not parse H265 SPS Unit");
 						return false;
 					}
 
-					if(header.GetNalUnitType() == H265NALUnitType::SPS)
-					{
-						H265SPS sps;
-						if(H265Parser::ParseSPS(buffer, length, sps) == false)
-						{
-							logte("Could not parse H265 SPS Unit");
-							return false;
-						}
-
-						media_track->SetWidth(sps.GetWidth());
-						media_track->SetHeight(sps.GetHeight());
-						media_track->SetTimeBase(1, 90000);
-
-						logtd("%s", sps.GetInfoString().CStr());					
-						logtd("[%d] Convert timebase (%d/%d) to (%d/%d)"
-							, media_track->GetId()
-							, _incoming_tiembase[media_track->GetId()].GetNum(), _incoming_tiembase[media_track->GetId()].GetDen()
-							, media_track->GetTimeBase().GetNum(), media_track->GetTimeBase().GetDen());
-
-						SetParseTrackInfo(media_track, true);
-					}
+					media_track->SetWidth(sps.GetWidth());
+					media_track->SetHeight(sps.GetHeight());
+					media_track->SetTimeBase(1, 90000);
+
+					logtd("%s", sps.GetInfoString().CStr());					
+					logtd("[%d] Convert timebase (%d/%d) to (%d/%d)"
+						, media_track->GetId()
+						, _incoming_tiembase[media_track->GetId()].GetNum(), _incoming_tiembase[media_track->GetId()].GetDen()
+						, media_track->GetTimeBase().GetNum(), media_track->GetTimeBase().GetDen());
+
+					SetParseTrackInfo(media_track, true);
 				}
 
 			} break;
@@ -356,6 +338,7 @@ bool MediaRouteStream::ParseAdditionalData(
 	switch(media_track->GetCodecId())
 	{
 		case MediaCodecId::H264:
+		case MediaCodecId::H265:
 		{
 			if(media_packet->GetFragHeader()->GetCount() == 0)
 			{
@@ -369,31 +352,30 @@ bool MediaRouteStream::ParseAdditionalData(
 				media_packet->SetFragHeader(nal_parser.GetFragmentHeader());
 			}
 
-			if(H264Parser::CheckKeyframe(media_packet->GetData()->GetDataAs<uint8_t>(), media_packet->GetData()->GetLength()) == true)
+			// Build the NAL unit index once, and the publishers reuse it
+			auto nal_unit_index = media_packet->GetNalUnitIndex();
+			if(nal_unit_index == nullptr)
 			{
-				media_packet->SetFlag(MediaPacketFlag::Key);
-			}
+				auto data = media_packet->GetData()->GetDataAs<uint8_t>();
+				auto length = media_packet->GetData()->GetLength();
 
-		} break;		
-		case MediaCodecId::H265:
-		{
-			if(media_packet->GetFragHeader()->GetCount() == 0)
-			{
-				NalUnitFragmentHeader nal_parser;
-				if(NalUnitFragmentHeader::Parse(media_packet->GetData(), nal_parser) == false)
+				nal_unit_index = (media_track->GetCodecId() == MediaCodecId::H264)
+									 ? H264Parser::CreateNalUnitIndex(data, length, *media_packet->GetFragHeader())
+									 : H265Parser::CreateNalUnitIndex(data, length, *media_packet->GetFragHeader());
+
+				if(nal_unit_index == nullptr)
 				{
-					logte("failed to parse fragment header");
+					logte("Invalid fragment header");
 					return false;
 				}
 
-				media_packet->SetFragHeader(nal_parser.GetFragmentHeader());
+				media_packet->SetNalUnitIndex(nal_unit_index);
 			}
 
-			if(H265Parser::CheckKeyframe(media_packet->GetData()->GetDataAs<uint8_t>(), media_packet->GetData()->GetLength()) == true)
+			if(nal_unit_index->has_keyframe)
 			{
 				media_packet->SetFlag(MediaPacketFlag::Key);
 			}
-			
 		} break;
 
 		case MediaCodecId::Aac: 
@@ -430,7 +412,7 @@ bool MediaRouteStream::ConvertToDefaultBitstream(std::shared_ptr<MediaTrack> &me
 					return false;
 				}
 
-				if(H264AvccToAnnexB::Convert(media_packet->GetPacketType(), media_packet->GetData(), media_track->GetCodecExtradata()) == false)
+				if(H264AvccToAnnexB::Convert(media_packet, media_track->GetCodecExtradata()) == false)
 				{
 					logte("Failed to change bitstream format ");
 					return false;
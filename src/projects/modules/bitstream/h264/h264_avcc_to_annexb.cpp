@@ -3,6 +3,9 @@
 #include "h264_decoder_configuration_record.h"
 #include "h264_parser.h"
 
+#include <base/ovlibrary/byte_io.h>
+#include <modules/bitstream/nalu/nal_unit_fragment_header.h>
+
 
 #define OV_LOG_TAG "H264AvccToAnnexB"
 
@@ -115,3 +118,102 @@ bool H264AvccToAnnexB::Convert(common::PacketType type, const std::shared_ptr<ov
 
 	return true;
 }
+
+bool H264AvccToAnnexB::Convert(const std::shared_ptr<MediaPacket> &packet, const std::vector<uint8_t> &extradata)
+{
+	if(packet->GetPacketType() != common::PacketType::NALU)
+	{
+		return Convert(packet->GetPacketType(), packet->GetData(), extradata);
+	}
+
+	auto &data = packet->GetData();
+	size_t length = data->GetLength();
+
+	// The buffer is copied only if it is shared with others
+	auto buffer = data->GetWritableDataAs<uint8_t>();
+	if((buffer == nullptr) && (length > 0))
+	{
+		logte("Could not get writable buffer");
+		return false;
+	}
+
+	FragmentationHeader fragment_header;
+	bool has_idr = false;
+	bool has_sps = false;
+	bool has_pps = false;
+	size_t offset = 0;
+
+	while(offset < length)
+	{
+		if((length - offset) < sizeof(START_CODE))
+		{
+			logte("Not enough data to parse NAL");
+			return false;
+		}
+
+		size_t nal_length = ByteReader<uint32_t>::ReadBigEndian(buffer + offset);
+
+		// The length prefix has the same size as the start code, so the start code can be written over it
+		::memcpy(buffer + offset, START_CODE, sizeof(START_CODE));
+		offset += sizeof(START_CODE);
+
+		if(nal_length > (length - offset))
+		{
+			logte("NAL length (%zu) is greater than buffer length (%zu)", nal_length, length - offset);
+			return false;
+		}
+
+		if(nal_length > 0)
+		{
+			switch(static_cast<H264NalUnitType>(buffer[offset] & 0x1F))
+			{
+				case H264NalUnitType::IdrSlice:
+					has_idr = true;
+					break;
+				case H264NalUnitType::Sps:
+					has_sps = true;
+					break;
+				case H264NalUnitType::Pps:
+					has_pps = true;
+					break;
+				default:
+					break;
+			}
+		}
+
+		fragment_header.fragmentation_offset.push_back(offset);
+		fragment_header.fragmentation_length.push_back(nal_length);
+
+		offset += nal_length;
+	}
+
+	// Decoders need SPS/PPS only to start decoding from an IDR frame
+	if(has_idr && ((has_sps && has_pps) == false) && (extradata.empty() == false))
+	{
+		if(data->Insert(extradata.data(), 0, extradata.size()) == false)
+		{
+			logte("Could not insert parameter sets");
+			return false;
+		}
+
+		NalUnitFragmentHeader parameter_sets;
+		NalUnitFragmentHeader::Parse(extradata.data(), extradata.size(), parameter_sets);
+
+		auto header = parameter_sets._fragment_header;
+
+		for(size_t index = 0; index < fragment_header.GetCount(); index++)
+		{
+			header.fragmentation_offset.push_back(fragment_header.fragmentation_offset[index] + extradata.size());
+			header.fragmentation_length.push_back(fragment_header.fragmentation_length[index]);
+		}
+
+		fragment_header = std::move(header);
+		has_sps = true;
+	}
+
+	packet->SetFragHeader(&fragment_header);
+	// Same as H264Parser::CheckKeyframe()
+	packet->SetFlag((has_idr || has_sps) ? MediaPacketFlag::Key : MediaPacketFlag::NoFlag);
+
+	return true;
+}
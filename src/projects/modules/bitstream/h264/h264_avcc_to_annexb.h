@@ -9,4 +9,9 @@ class H264AvccToAnnexB
 public:
 	static bool GetExtradata(const common::PacketType type, const std::shared_ptr<ov::Data> &data, std::vector<uint8_t> &extradata);
 	static bool Convert(common::PacketType type, const std::shared_ptr<ov::Data> &data, const std::vector<uint8_t> &extradata);
+
+	// Rewrites the 4-byte length prefixes of a NALU packet to start codes in place, and inserts the parameter sets
+	// (extradata) only before an IDR frame that doesn't have them. The offsets of NAL units and the keyframe flag are
+	// recorded on the packet, so they don't need to be parsed again.
+	static bool Convert(const std::shared_ptr<MediaPacket> &packet, const std::vector<uint8_t> &extradata);
 };
@@ -1,43 +1,84 @@
 #include "h264_parser.h"
 
+#include <modules/bitstream/nalu/nal_unit_fragment_header.h>
+#include <modules/bitstream/nalu/nal_unit_start_code_scanner.h>
+
 bool H264Parser::CheckKeyframe(const uint8_t *bitstream, size_t length)
 {
-    size_t offset = 0;
-    while(offset < length)
-    {
-        size_t remaining = length - offset;
-        const uint8_t* data = bitstream + offset;
-
-        if((remaining >= 3 && data[0] == 0x00 && data[1] == 0x00 && data[2] == 0x01) || 
-            (remaining >= 4 && data[0] == 0x00 && data[1] == 0x00 && data[2] == 0x00 && data[3] == 0x01))
-        {
-            if(data[2] == 0x01)
-            {
-                offset += 3;
-            }
-            else
-            {
-                offset += 4;
-            }
-
-			if(length - offset > H264_NAL_UNIT_HEADER_SIZE)
-			{
-				H264NalUnitHeader header;
-				ParseNalUnitHeader(bitstream+offset, H264_NAL_UNIT_HEADER_SIZE, header);
+	size_t offset = 0;
+	size_t start_code_offset = 0;
+	size_t start_code_length = 0;
 
-				if(header.GetNalUnitType() == H264NalUnitType::IdrSlice ||
-				header.GetNalUnitType() == H264NalUnitType::Sps)
-				{
-					return true;
-				}
+	while(NalUnitStartCodeScanner::Find(bitstream, length, offset, start_code_offset, start_code_length))
+	{
+		offset = start_code_offset + start_code_length;
+
+		if(length - offset > H264_NAL_UNIT_HEADER_SIZE)
+		{
+			H264NalUnitHeader header;
+			ParseNalUnitHeader(bitstream+offset, H264_NAL_UNIT_HEADER_SIZE, header);
+
+			if(header.GetNalUnitType() == H264NalUnitType::IdrSlice ||
+			header.GetNalUnitType() == H264NalUnitType::Sps)
+			{
+				return true;
 			}
 		}
-		else
+	}
+	return false;
+}
+
+std::shared_ptr<NalUnitIndex> H264Parser::CreateNalUnitIndex(const uint8_t *bitstream, size_t length, const FragmentationHeader &fragment_header)
+{
+	auto index = std::make_shared<NalUnitIndex>();
+	bool has_sps = false;
+	bool has_pps = false;
+
+	index->nal_units.reserve(fragment_header.GetCount());
+
+	for(size_t i = 0; i < fragment_header.GetCount(); i++)
+	{
+		NalUnitIndex::NalUnit nal_unit;
+
+		nal_unit.offset = fragment_header.fragmentation_offset[i];
+		nal_unit.length = fragment_header.fragmentation_length[i];
+
+		if((nal_unit.offset >= length) || (nal_unit.length > (length - nal_unit.offset)))
 		{
-			offset ++;
+			return nullptr;
 		}
+
+		nal_unit.start_code_length = NalUnitFragmentHeader::GetStartCodeLength(bitstream, nal_unit.offset);
+
+		if(nal_unit.length >= H264_NAL_UNIT_HEADER_SIZE)
+		{
+			// forbidden_zero_bit(1) nal_ref_idc(2) nal_unit_type(5)
+			nal_unit.type = bitstream[nal_unit.offset] & 0x1F;
+
+			switch(static_cast<H264NalUnitType>(nal_unit.type))
+			{
+				case H264NalUnitType::IdrSlice:
+					index->has_keyframe = true;
+					break;
+				case H264NalUnitType::Sps:
+					// Same as CheckKeyframe()
+					index->has_keyframe = true;
+					has_sps = true;
+					break;
+				case H264NalUnitType::Pps:
+					has_pps = true;
+					break;
+				default:
+					break;
+			}
+		}
+
+		index->nal_units.push_back(nal_unit);
 	}
-	return false;
+
+	index->has_parameter_sets = has_sps && has_pps;
+
+	return index;
 }
 
 bool H264Parser::ParseNalUnitHeader(const uint8_t *nalu, size_t length, H264NalUnitHeader &header)
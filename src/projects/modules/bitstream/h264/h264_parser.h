@@ -2,6 +2,7 @@
 
 #include <modules/bitstream/nalu/nal_unit_bitstream_parser.h>
 #include <base/ovlibrary/ovlibrary.h>
+#include <base/mediarouter/media_buffer.h>
 #include <cstdint>
 
 #include "h264_nal_unit_types.h"
@@ -99,6 +100,9 @@ public:
     static bool ParseNalUnitHeader(const uint8_t *nalu, size_t length, H264NalUnitHeader &header);
     static bool ParseSPS(const uint8_t *nalu, size_t length, H264SPS &sps);
 
+    // Creates the index of the NAL units in the fragment header, and finds keyframe/parameter sets without scanning the bitstream
+    static std::shared_ptr<NalUnitIndex> CreateNalUnitIndex(const uint8_t *bitstream, size_t length, const FragmentationHeader &fragment_header);
+
 private:
     static bool ParseNalUnitHeader(NalUnitBitstreamParser &parser, H264NalUnitHeader &header);
 };
@@ -5,45 +5,90 @@
 #include "h265_parser.h"
 #include "h265_types.h"
 
+#include <modules/bitstream/nalu/nal_unit_fragment_header.h>
+#include <modules/bitstream/nalu/nal_unit_start_code_scanner.h>
+
 bool H265Parser::CheckKeyframe(const uint8_t *bitstream, size_t length)
 {
 	size_t offset = 0;
-    while(offset < length)
-    {
-        size_t remaining = length - offset;
-        const uint8_t* data = bitstream + offset;
-
-        if((remaining >= 3 && data[0] == 0x00 && data[1] == 0x00 && data[2] == 0x01) || 
-            (remaining >= 4 && data[0] == 0x00 && data[1] == 0x00 && data[2] == 0x00 && data[3] == 0x01))
-        {
-            if(data[2] == 0x01)
-            {
-                offset += 3;
-            }
-            else
-            {
-                offset += 4;
-            }
-
-			if(length - offset > H265_NAL_UNIT_HEADER_SIZE)
-			{
-				H265NalUnitHeader header;
-				ParseNalUnitHeader(bitstream+offset, H265_NAL_UNIT_HEADER_SIZE, header);
+	size_t start_code_offset = 0;
+	size_t start_code_length = 0;
 
-				if(header.GetNalUnitType() == H265NALUnitType::IDR_W_RADL ||
-				header.GetNalUnitType() == H265NALUnitType::CRA_NUT ||
-				header.GetNalUnitType() == H265NALUnitType::BLA_W_RADL) 
-				{
-					return true;
-				}
+	while(NalUnitStartCodeScanner::Find(bitstream, length, offset, start_code_offset, start_code_length))
+	{
+		offset = start_code_offset + start_code_length;
+
+		if(length - offset > H265_NAL_UNIT_HEADER_SIZE)
+		{
+			H265NalUnitHeader header;
+			ParseNalUnitHeader(bitstream+offset, H265_NAL_UNIT_HEADER_SIZE, header);
+
+			if(header.GetNalUnitType() == H265NALUnitType::IDR_W_RADL ||
+			header.GetNalUnitType() == H265NALUnitType::CRA_NUT ||
+			header.GetNalUnitType() == H265NALUnitType::BLA_W_RADL) 
+			{
+				return true;
 			}
 		}
-		else
+	}
+	return false;
+}
+
+std::shared_ptr<NalUnitIndex> H265Parser::CreateNalUnitIndex(const uint8_t *bitstream, size_t length, const FragmentationHeader &fragment_header)
+{
+	auto index = std::make_shared<NalUnitIndex>();
+	bool has_vps = false;
+	bool has_sps = false;
+	bool has_pps = false;
+
+	index->nal_units.reserve(fragment_header.GetCount());
+
+	for(size_t i = 0; i < fragment_header.GetCount(); i++)
+	{
+		NalUnitIndex::NalUnit nal_unit;
+
+		nal_unit.offset = fragment_header.fragmentation_offset[i];
+		nal_unit.length = fragment_header.fragmentation_length[i];
+
+		if((nal_unit.offset >= length) || (nal_unit.length > (length - nal_unit.offset)))
 		{
-			offset ++;
+			return nullptr;
 		}
+
+		nal_unit.start_code_length = NalUnitFragmentHeader::GetStartCodeLength(bitstream, nal_unit.offset);
+
+		if(nal_unit.length >= H265_NAL_UNIT_HEADER_SIZE)
+		{
+			// forbidden_zero_bit(1) nal_unit_type(6) nuh_layer_id(6) nuh_temporal_id_plus1(3)
+			nal_unit.type = (bitstream[nal_unit.offset] >> 1) & 0x3F;
+
+			auto type = static_cast<H265NALUnitType>(nal_unit.type);
+
+			// IRAP pictures (BLA_W_LP ~ IRAP_VCL23)
+			if((type >= H265NALUnitType::BLA_W_LP) && (type <= H265NALUnitType::IRAP_VCL23))
+			{
+				index->has_keyframe = true;
+			}
+			else if(type == H265NALUnitType::VPS)
+			{
+				has_vps = true;
+			}
+			else if(type == H265NALUnitType::SPS)
+			{
+				has_sps = true;
+			}
+			else if(type == H265NALUnitType::PPS)
+			{
+				has_pps = true;
+			}
+		}
+
+		index->nal_units.push_back(nal_unit);
 	}
-	return false;
+
+	index->has_parameter_sets = has_vps && has_sps && has_pps;
+
+	return index;
 }
 
 bool H265Parser::ParseNalUnitHeader(const uint8_t *nalu, size_t length, H265NalUnitHeader &header)
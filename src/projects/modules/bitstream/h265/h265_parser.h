@@ -5,6 +5,7 @@
 #pragma once
 
 #include <base/ovlibrary/ovlibrary.h>
+#include <base/mediarouter/media_buffer.h>
 #include <modules/bitstream/nalu/nal_unit_bitstream_parser.h>
 #include <cstdint>
 
@@ -149,6 +150,9 @@ public:
     static bool ParseNalUnitHeader(const uint8_t *nalu, size_t length, H265NalUnitHeader &header);
     static bool ParseSPS(const uint8_t *nalu, size_t length, H265SPS &sps);
 
+    // Creates the index of the NAL units in the fragment header, and finds keyframe/parameter sets without scanning the bitstream
+    static std::shared_ptr<NalUnitIndex> CreateNalUnitIndex(const uint8_t *bitstream, size_t length, const FragmentationHeader &fragment_header);
+
 private:
     static bool ParseNalUnitHeader(NalUnitBitstreamParser &parser, H265NalUnitHeader &header);
     static bool ProcessProfileTierLevel(uint32_t max_sub_layers_minus1, NalUnitBitstreamParser &parser, ProfileTierLevel &profile);
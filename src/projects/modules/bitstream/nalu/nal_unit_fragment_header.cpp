@@ -1,4 +1,5 @@
 #include "nal_unit_fragment_header.h"
+#include "nal_unit_start_code_scanner.h"
 
 
 NalUnitFragmentHeader::NalUnitFragmentHeader()
@@ -22,32 +23,13 @@ bool NalUnitFragmentHeader::Parse(const uint8_t *bitstream, size_t length, NalUn
 
 	std::vector<std::pair<size_t, size_t>> offset_list;
 
-	while ( data_offset < length )
-	{
-		size_t remain_data_size = length - data_offset;
-		const uint8_t* data = bitstream + data_offset;
+	size_t start_code_offset = 0;
+	size_t start_code_length = 0;
 
-		if (remain_data_size >= 3 &&
-				0x00 == data[0] &&
-				0x00 == data[1] &&
-				0x01 == data[2])
-		{
-			offset_list.emplace_back(data_offset, 3); // Offset, SIZEOF(START_CODE[3])
-			data_offset += 3;
-		}
-		else if (remain_data_size >= 4 &&
-				 0x00 == data[0] &&
-				 0x00 == data[1] &&
-				 0x00 == data[2] &&
-				 0x01 == data[3])
-		{
-			offset_list.emplace_back(data_offset, 4); // Offset, SIZEOF(START_CODE[4])
-			data_offset += 4;
-		}
-		else
-		{
-			data_offset += 1;
-		}
+	while (NalUnitStartCodeScanner::Find(bitstream, length, data_offset, start_code_offset, start_code_length))
+	{
+		offset_list.emplace_back(start_code_offset, start_code_length); // Offset, SIZEOF(START_CODE)
+		data_offset = start_code_offset + start_code_length;
 	}
 
 	fragment_hdr._fragment_header.Clear();
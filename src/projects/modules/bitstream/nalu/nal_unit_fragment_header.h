@@ -15,6 +15,17 @@ public:
 	static bool Parse(const std::shared_ptr<ov::Data> &data, NalUnitFragmentHeader &fragment_hdr);
 	static bool Parse(const uint8_t *bitstream, size_t length, NalUnitFragmentHeader &fragment_hdr);
 
+	// Returns the length of the start code in front of the NAL unit at nal_offset (0 if there is no start code)
+	static uint8_t GetStartCodeLength(const uint8_t *bitstream, size_t nal_offset)
+	{
+		if ((nal_offset < 3) || (bitstream[nal_offset - 3] != 0x00) || (bitstream[nal_offset - 2] != 0x00) || (bitstream[nal_offset - 1] != 0x01))
+		{
+			return 0;
+		}
+
+		return ((nal_offset >= 4) && (bitstream[nal_offset - 4] == 0x00)) ? 4 : 3;
+	}
+
 	const FragmentationHeader *GetFragmentHeader() const
 	{
 		return &_fragment_header;
@@ -1,51 +1,28 @@
 #include "nal_unit_splitter.h"
+#include "nal_unit_start_code_scanner.h"
 
 std::shared_ptr<NalUnitList> NalUnitSplitter::Parse(const uint8_t* bitstream, size_t bitstream_length)
 {
     auto nal_unit_list = std::make_shared<NalUnitList>();
 
     size_t offset = 0;
-    size_t start_pos = 0, end_pos = 0;
-    while(offset < bitstream_length)
+    size_t start_pos = 0;
+    size_t start_code_offset = 0, start_code_length = 0;
+    while(NalUnitStartCodeScanner::Find(bitstream, bitstream_length, offset, start_code_offset, start_code_length))
     {
-        size_t remaining = bitstream_length - offset;
-        const uint8_t* data = bitstream + offset;
-
-        if((remaining >= 3 && data[0] == 0x00 && data[1] == 0x00 && data[2] == 0x01) || 
-            (remaining >= 4 && data[0] == 0x00 && data[1] == 0x00 && data[2] == 0x00 && data[3] == 0x01))
+        if(start_pos != 0)
         {
-            end_pos = offset;
+            nal_unit_list->_nal_list.emplace_back(std::make_shared<ov::Data>(bitstream + start_pos, start_code_offset - start_pos));
+        }
 
-            if(data[2] == 0x01)
-            {
-                offset += 3;
-            }
-            else
-            {
-                offset += 4;
-            }
+        offset = start_code_offset + start_code_length;
+        start_pos = offset;
+    }
 
-            if(start_pos == 0)
-            {
-                start_pos = offset;
-            }
-            else
-            {
-                nal_unit_list->_nal_list.emplace_back(std::make_shared<ov::Data>(bitstream + start_pos, end_pos - start_pos));
-                start_pos = offset;
-            }
-        }
-        else
-        {
-            offset ++;
-        }
-        
-        // last nal unit
-        if(offset == bitstream_length && start_pos != 0)
-        {
-            end_pos = offset;
-            nal_unit_list->_nal_list.emplace_back(std::make_shared<ov::Data>(bitstream + start_pos, end_pos - start_pos));
-        }
+    // last nal unit
+    if(start_pos != 0)
+    {
+        nal_unit_list->_nal_list.emplace_back(std::make_shared<ov::Data>(bitstream + start_pos, bitstream_length - start_pos));
     }
     
     return nal_unit_list;
@@ -0,0 +1,163 @@
+#include "nal_unit_start_code_scanner.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#	define NAL_UNIT_START_CODE_SCANNER_X86 1
+#	include <immintrin.h>
+#endif
+
+// Returns the offset of the first 00 00 01 in [offset, length), or length
+static size_t FindScalar(const uint8_t *bitstream, size_t length, size_t offset)
+{
+	while ((offset + 2) < length)
+	{
+		auto third = bitstream[offset + 2];
+
+		if (third > 0x01)
+		{
+			// A start code can't begin at offset, offset + 1 or offset + 2, because each of them needs 0x00 or 0x01 here
+			offset += 3;
+		}
+		else if (third == 0x01)
+		{
+			if ((bitstream[offset] == 0x00) && (bitstream[offset + 1] == 0x00))
+			{
+				return offset;
+			}
+
+			offset += 3;
+		}
+		else
+		{
+			offset += 1;
+		}
+	}
+
+	return length;
+}
+
+#if NAL_UNIT_START_CODE_SCANNER_X86
+__attribute__((target("sse2"))) static size_t FindSse2(const uint8_t *bitstream, size_t length, size_t offset)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i one = _mm_set1_epi8(1);
+
+	// Compares 16 positions at once: bitstream[i] == 0 && bitstream[i + 1] == 0 && bitstream[i + 2] == 1
+	while ((offset + 16 + 2) <= length)
+	{
+		auto first = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bitstream + offset));
+		auto second = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bitstream + offset + 1));
+		auto third = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bitstream + offset + 2));
+
+		auto match = _mm_and_si128(_mm_and_si128(_mm_cmpeq_epi8(first, zero), _mm_cmpeq_epi8(second, zero)), _mm_cmpeq_epi8(third, one));
+		auto mask = static_cast<uint32_t>(_mm_movemask_epi8(match));
+
+		if (mask != 0)
+		{
+			return offset + __builtin_ctz(mask);
+		}
+
+		offset += 16;
+	}
+
+	return FindScalar(bitstream, length, offset);
+}
+
+__attribute__((target("avx2"))) static size_t FindAvx2(const uint8_t *bitstream, size_t length, size_t offset)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i one = _mm256_set1_epi8(1);
+
+	while ((offset + 32 + 2) <= length)
+	{
+		auto first = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bitstream + offset));
+		auto second = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bitstream + offset + 1));
+		auto third = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bitstream + offset + 2));
+
+		auto match = _mm256_and_si256(_mm256_and_si256(_mm256_cmpeq_epi8(first, zero), _mm256_cmpeq_epi8(second, zero)), _mm256_cmpeq_epi8(third, one));
+		auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(match));
+
+		if (mask != 0)
+		{
+			return offset + __builtin_ctz(mask);
+		}
+
+		offset += 32;
+	}
+
+	return FindScalar(bitstream, length, offset);
+}
+#endif  // NAL_UNIT_START_CODE_SCANNER_X86
+
+using FindFunction = size_t (*)(const uint8_t *bitstream, size_t length, size_t offset);
+
+struct StartCodeScannerImplementation
+{
+	FindFunction find;
+	const char *name;
+};
+
+static StartCodeScannerImplementation SelectImplementation()
+{
+#if NAL_UNIT_START_CODE_SCANNER_X86
+	__builtin_cpu_init();
+
+	if (__builtin_cpu_supports("avx2"))
+	{
+		return {FindAvx2, "avx2"};
+	}
+
+	if (__builtin_cpu_supports("sse2"))
+	{
+		return {FindSse2, "sse2"};
+	}
+#endif
+
+	return {FindScalar, "scalar"};
+}
+
+static const StartCodeScannerImplementation &GetImplementation()
+{
+	// Selected once, when it is used for the first time
+	static const StartCodeScannerImplementation implementation = SelectImplementation();
+
+	return implementation;
+}
+
+size_t NalUnitStartCodeScanner::FindThreeBytePattern(const uint8_t *bitstream, size_t length, size_t offset)
+{
+	if ((bitstream == nullptr) || (offset >= length))
+	{
+		return length;
+	}
+
+	return GetImplementation().find(bitstream, length, offset);
+}
+
+bool NalUnitStartCodeScanner::Find(const uint8_t *bitstream, size_t length, size_t offset, size_t &start_code_offset, size_t &start_code_length)
+{
+	auto position = FindThreeBytePattern(bitstream, length, offset);
+
+	if (position >= length)
+	{
+		return false;
+	}
+
+	// 00 00 00 01 is found as 00 00 01 after the first 00
+	if ((position > offset) && (bitstream[position - 1] == 0x00))
+	{
+		start_code_offset = position - 1;
+		start_code_length = 4;
+	}
+	else
+	{
+		start_code_offset = position;
+		start_code_length = 3;
+	}
+
+	return true;
+}
+
+const char *NalUnitStartCodeScanner::GetImplementationName()
+{
+	return GetImplementation().name;
+}
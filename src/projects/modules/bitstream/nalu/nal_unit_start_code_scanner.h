@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Finds Annex B start codes (00 00 01 / 00 00 00 01) in H.264/H.265 bitstreams.
+//
+// Scans 32 bytes (AVX2) or 16 bytes (SSE2) at a time, depending on the CPU the process runs on,
+// and falls back to a scalar loop that skips 3 bytes at a time on the other CPUs.
+class NalUnitStartCodeScanner
+{
+public:
+	// Finds the first start code at or after offset.
+	// Returns false if there is no start code.
+	//   start_code_offset: offset of the start code (the first 00)
+	//   start_code_length: 4 if the start code is 00 00 00 01, 3 if it is 00 00 01
+	static bool Find(const uint8_t *bitstream, size_t length, size_t offset, size_t &start_code_offset, size_t &start_code_length);
+
+	// Returns the offset of the first 00 00 01 at or after offset (length if there is none)
+	static size_t FindThreeBytePattern(const uint8_t *bitstream, size_t length, size_t offset);
+
+	// Name of the implementation selected for this CPU ("avx2", "sse2" or "scalar")
+	static const char *GetImplementationName();
+};
@@ -0,0 +1,95 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2020 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "dtls_handshake_pool.h"
+
+#include <algorithm>
+#include <chrono>
+
+#define OV_LOG_TAG "DTLS.Pool"
+
+DtlsHandshakePool *DtlsHandshakePool::GetInstance()
+{
+	// Never destroyed, like ov::Executor::GetInstance()
+	static auto instance = new DtlsHandshakePool();
+
+	return instance;
+}
+
+DtlsHandshakePool::DtlsHandshakePool()
+{
+	// The other half of the processors keeps sending the media while many handshakes are running
+	auto thread_count = std::max(ov::Platform::GetProcessorCount() / 2, DTLS_HANDSHAKE_POOL_MIN_THREAD_COUNT);
+
+	_executor = new ov::Executor("OvDtls", thread_count);
+}
+
+bool DtlsHandshakePool::Post(ov::Strand &strand, ov::Executor::Task task)
+{
+	auto pending_count = _pending_count.fetch_add(1) + 1;
+
+	if (pending_count > DTLS_HANDSHAKE_POOL_MAX_PENDING_COUNT)
+	{
+		_pending_count.fetch_sub(1);
+		_dropped_count.fetch_add(1);
+
+		LogStatsIfNeeded();
+
+		return false;
+	}
+
+	auto max_pending_count = _max_pending_count.load();
+	while ((pending_count > max_pending_count) && (_max_pending_count.compare_exchange_weak(max_pending_count, pending_count) == false))
+	{
+	}
+
+	// Released when the task runs, or when the task is destroyed without running (the strand is stopped)
+	auto pending_guard = std::make_shared<PendingGuard>(_pending_count);
+
+	return strand.Post([pending_guard, task = std::move(task)]() mutable {
+		pending_guard.reset();
+
+		task();
+	});
+}
+
+void DtlsHandshakePool::OnHandshakeCompleted(int64_t elapsed_us)
+{
+	_completed_count.fetch_add(1);
+	_total_handshake_us.fetch_add(elapsed_us);
+
+	auto max_handshake_us = _max_handshake_us.load();
+	while ((elapsed_us > max_handshake_us) && (_max_handshake_us.compare_exchange_weak(max_handshake_us, elapsed_us) == false))
+	{
+	}
+
+	LogStatsIfNeeded();
+}
+
+int64_t DtlsHandshakePool::GetAverageHandshakeUs() const
+{
+	auto completed_count = _completed_count.load();
+
+	return (completed_count == 0) ? 0 : (_total_handshake_us / static_cast<int64_t>(completed_count));
+}
+
+void DtlsHandshakePool::LogStatsIfNeeded()
+{
+	auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	auto last_stats_time_ms = _last_stats_time_ms.load();
+
+	if (((now_ms - last_stats_time_ms) < DTLS_HANDSHAKE_POOL_STATS_INTERVAL_MS) ||
+		(_last_stats_time_ms.compare_exchange_strong(last_stats_time_ms, now_ms) == false))
+	{
+		return;
+	}
+
+	logts("Stats for DTLS handshake pool: pending: %zu (max: %zu), completed: %llu, dropped: %llu, handshake: avg %lld us, max %lld us",
+		  _pending_count.load(), _max_pending_count.exchange(_pending_count.load()),
+		  static_cast<unsigned long long>(_completed_count.load()), static_cast<unsigned long long>(_dropped_count.load()),
+		  static_cast<long long>(GetAverageHandshakeUs()), static_cast<long long>(_max_handshake_us.load()));
+}
@@ -0,0 +1,95 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2020 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+
+// At least this many threads run the handshakes (the pool uses half of the processors)
+#define DTLS_HANDSHAKE_POOL_MIN_THREAD_COUNT	2
+// Handshake packets over this are dropped, and the peers retransmit them later
+#define DTLS_HANDSHAKE_POOL_MAX_PENDING_COUNT	4096
+// Interval of the statistics log
+#define DTLS_HANDSHAKE_POOL_STATS_INTERVAL_MS	5000
+
+// Runs the DTLS handshakes (ECDHE, signing) of all sessions on a bounded number of threads.
+//
+// Handshakes used to run on the thread which delivers the packets of the sessions, so a lot of viewers
+// joining at once delayed the RTP/RTCP of the sessions which were already established.
+// Each DtlsTransport posts its handshake packets to its own strand on this pool, so they are still processed in order.
+class DtlsHandshakePool
+{
+public:
+	static DtlsHandshakePool *GetInstance();
+
+	ov::Executor *GetExecutor()
+	{
+		return _executor;
+	}
+
+	// strand must run on GetExecutor(). Returns false if the packet is dropped (too many packets are pending, or the strand is stopped)
+	bool Post(ov::Strand &strand, ov::Executor::Task task);
+
+	// elapsed_us: time spent in the handshake of a session (without the waiting for the peer)
+	void OnHandshakeCompleted(int64_t elapsed_us);
+
+	size_t GetPendingCount() const
+	{
+		return _pending_count;
+	}
+
+	uint64_t GetCompletedCount() const
+	{
+		return _completed_count;
+	}
+
+	uint64_t GetDroppedCount() const
+	{
+		return _dropped_count;
+	}
+
+	int64_t GetAverageHandshakeUs() const;
+
+	int64_t GetMaxHandshakeUs() const
+	{
+		return _max_handshake_us;
+	}
+
+protected:
+	// Decreases the pending count once, when it is destroyed
+	class PendingGuard
+	{
+	public:
+		explicit PendingGuard(std::atomic<size_t> &pending_count)
+			: _pending_count(pending_count)
+		{
+		}
+
+		~PendingGuard()
+		{
+			_pending_count.fetch_sub(1);
+		}
+
+	private:
+		std::atomic<size_t> &_pending_count;
+	};
+
+	DtlsHandshakePool();
+
+	void LogStatsIfNeeded();
+
+	ov::Executor *_executor = nullptr;
+
+	std::atomic<size_t> _pending_count{0};
+	std::atomic<size_t> _max_pending_count{0};
+	std::atomic<uint64_t> _completed_count{0};
+	std::atomic<uint64_t> _dropped_count{0};
+	std::atomic<int64_t> _total_handshake_us{0};
+	std::atomic<int64_t> _max_handshake_us{0};
+
+	std::atomic<int64_t> _last_stats_time_ms{0};
+};
@@ -22,7 +22,7 @@ DtlsIceTransport::~DtlsIceTransport()
 }
 
 // Implement SessionNode Interface
-bool DtlsIceTransport::SendData(pub::SessionNodeType from_node, const std::shared_ptr<ov::Data> &data)
+bool DtlsIceTransport::SendData(pub::SessionNodeType from_node, const std::shared_ptr<const ov::Data> &data)
 {
 	if(GetState() != SessionNode::NodeState::Started)
 	{
@@ -30,12 +30,102 @@ bool DtlsIceTransport::SendData(pub::SessionNodeType from_node, const std::share
 		return false;
 	}
 
+	if(_pacer != nullptr)
+	{
+		_pacer->Enqueue(data);
+
+		{
+			std::lock_guard<std::mutex> lock_guard(_batch_mutex);
+
+			if(_is_batch_started)
+			{
+				// Paced by FlushBatch()
+				return true;
+			}
+		}
+
+		return _pacer->Process();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock_guard(_batch_mutex);
+
+		if(_is_batch_started)
+		{
+			_batch_list.push_back(data);
+			return true;
+		}
+	}
+
 	logtd("DtlsIceTransport Send by ice port : %d", data->GetLength());
 	_ice_port->Send(GetSession(), data);
 
 	return true;
 }
 
+void DtlsIceTransport::BeginBatch()
+{
+	std::lock_guard<std::mutex> lock_guard(_batch_mutex);
+
+	_is_batch_started = true;
+}
+
+bool DtlsIceTransport::FlushBatch()
+{
+	std::vector<std::shared_ptr<const ov::Data>> batch_list;
+
+	{
+		std::lock_guard<std::mutex> lock_guard(_batch_mutex);
+
+		_is_batch_started = false;
+		batch_list.swap(_batch_list);
+	}
+
+	if(_pacer != nullptr)
+	{
+		return _pacer->Process();
+	}
+
+	if(batch_list.empty())
+	{
+		return true;
+	}
+
+	logtd("DtlsIceTransport Send %zu packets by ice port", batch_list.size());
+
+	return _ice_port->Send(GetSession(), batch_list);
+}
+
+void DtlsIceTransport::EnablePacing(double multiplier, int max_queue_delay_ms, ov::Executor *executor)
+{
+	auto ice_port = _ice_port;
+	auto session = GetSession();
+
+	// The pacer sends the packets from the timer too, so it must not keep the session alive
+	std::weak_ptr<pub::Session> weak_session = session;
+
+	_pacer = std::make_shared<RtpPacer>([ice_port, weak_session](const std::vector<std::shared_ptr<const ov::Data>> &packet_list) -> bool {
+		auto session = weak_session.lock();
+		if(session == nullptr)
+		{
+			return false;
+		}
+
+		logtd("DtlsIceTransport Send %zu paced packets by ice port", packet_list.size());
+		return ice_port->Send(session, packet_list);
+	}, multiplier, max_queue_delay_ms, executor);
+}
+
+bool DtlsIceTransport::Stop()
+{
+	if(_pacer != nullptr)
+	{
+		_pacer->Stop();
+	}
+
+	return SessionNode::Stop();
+}
+
 bool DtlsIceTransport::OnDataReceived(pub::SessionNodeType from_node, const std::shared_ptr<const ov::Data> &data)
 {
 	if(GetState() != SessionNode::NodeState::Started)
@@ -12,6 +12,10 @@
 
 #include <base/publisher/session_node.h>
 #include "modules/ice/ice_port.h"
+#include "modules/rtp_rtcp/rtp_pacer.h"
+
+#include <mutex>
+#include <vector>
 
 
 class DtlsIceTransport : public pub::SessionNode
@@ -22,10 +26,26 @@ public:
 
 	// Implement SessionNode Interface
 	// 데이터를 upper에서 받는다. lower node로 보낸다.
-	bool SendData(pub::SessionNodeType from_node, const std::shared_ptr<ov::Data> &data) override;
+	bool SendData(pub::SessionNodeType from_node, const std::shared_ptr<const ov::Data> &data) override;
 	// 데이터를 lower에서 받는다. upper node로 보낸다.
 	bool OnDataReceived(pub::SessionNodeType from_node, const std::shared_ptr<const ov::Data> &data) override;
 
+	// BeginBatch() 이후 SendData()로 들어온 데이터는 모아두었다가 FlushBatch()에서 한번에 전송한다.
+	void BeginBatch();
+	bool FlushBatch();
+
+	// Packets are paced by RtpPacer instead of being sent at once. It must be called before Start().
+	// executor: where the delayed packets are sent (nullptr means the shared executor)
+	void EnablePacing(double multiplier, int max_queue_delay_ms, ov::Executor *executor = nullptr);
+
+	bool Stop() override;
+
 private:
 	std::shared_ptr<IcePort> _ice_port;
+
+	std::mutex _batch_mutex;
+	bool _is_batch_started = false;
+	std::vector<std::shared_ptr<const ov::Data>> _batch_list;
+
+	std::shared_ptr<RtpPacer> _pacer;
 };
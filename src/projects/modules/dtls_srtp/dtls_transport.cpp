@@ -2,11 +2,13 @@
 
 #include <utility>
 #include <algorithm>
+#include <chrono>
 
 #define OV_LOG_TAG              "DTLS"
 
 DtlsTransport::DtlsTransport(uint32_t id, std::shared_ptr<pub::Session> session)
-	: SessionNode(id, pub::SessionNodeType::Dtls, std::move(session))
+	: SessionNode(id, pub::SessionNodeType::Dtls, std::move(session)),
+	  _handshake_strand(DtlsHandshakePool::GetInstance()->GetExecutor())
 {
 	_state = SSL_NONE;
 	_peer_cerificate_verified = false;
@@ -19,6 +21,9 @@ DtlsTransport::~DtlsTransport()
 
 bool DtlsTransport::Stop()
 {
+	// Waits for the handshake running on the pool, and discards the pending packets
+	_handshake_strand.Stop();
+
 	std::lock_guard<std::mutex> lock(_tls_lock);
 
 	_tls.Uninitialize();
@@ -172,16 +177,29 @@ bool DtlsTransport::VerifyPeerCertificate()
 	return true;
 }
 
-bool DtlsTransport::SendData(pub::SessionNodeType from_node, const std::shared_ptr<ov::Data> &data)
+bool DtlsTransport::SendData(pub::SessionNodeType from_node, const std::shared_ptr<const ov::Data> &data)
 {
-	std::lock_guard<std::mutex> lock(_tls_lock);
-
 	if(GetState() != SessionNode::NodeState::Started)
 	{
 		logtd("SessionNode has not started, so the received data has been canceled.");
 		return false;
 	}
 
+	// Since SRTP is already encrypted, it is sent directly to ICE.
+	// It doesn't take _tls_lock, so the media is not blocked by a DTLS packet which is being processed.
+	if((_state == SSL_CONNECTED) && (from_node == pub::SessionNodeType::Srtp))
+	{
+		auto node = GetLowerNode(pub::SessionNodeType::Ice);
+		if(node == nullptr)
+		{
+			return false;
+		}
+		//logtd("DtlsTransport Send next node : %d", data->GetLength());
+		return node->SendData(GetNodeType(), data);
+	}
+
+	std::lock_guard<std::mutex> lock(_tls_lock);
+
 	switch(_state)
 	{
 		case SSL_NONE:
@@ -189,18 +207,7 @@ bool DtlsTransport::SendData(pub::SessionNodeType from_node, const std::shared_p
 		case SSL_CONNECTING:
 			break;
 		case SSL_CONNECTED:
-			// Since SRTP is already encrypted, it is sent directly to ICE.
-			if(from_node == pub::SessionNodeType::Srtp)
-			{
-				auto node = GetLowerNode(pub::SessionNodeType::Ice);
-				if(node == nullptr)
-				{
-					return false;
-				}
-				//logtd("DtlsTransport Send next node : %d", data->GetLength());
-				return node->SendData(GetNodeType(), data);
-			}
-			else
+			if(from_node != pub::SessionNodeType::Srtp)
 			{
 				// If it is not SRTP, it must be encrypted in DTLS.
 				// TODO: Currently, SCTP is not supported, so there is no need to encrypt, 
@@ -228,8 +235,6 @@ bool DtlsTransport::SendData(pub::SessionNodeType from_node, const std::shared_p
 // IcePort -> Publisher ->[queue] Application {thread}-> Session -> DtlsTransport -> SRTP || SCTP
 bool DtlsTransport::OnDataReceived(pub::SessionNodeType from_node, const std::shared_ptr<const ov::Data> &data)
 {
-	std::lock_guard<std::mutex> lock(_tls_lock);
-
 	if(GetState() != SessionNode::NodeState::Started)
 	{
 		logtd("SessionNode has not started, so the received data has been canceled.");
@@ -248,30 +253,11 @@ bool DtlsTransport::OnDataReceived(pub::SessionNodeType from_node, const std::sh
 			if(IsDtlsPacket(data))
 			{
 				logtd("Receive DTLS packet");
-				// Packet을 Queue에 쌓는다.
-				SaveDtlsPacket(data);
 
-				if(_state == SSL_CONNECTING)
-				{
-					ContinueSSL();
-				}
-				else
+				// A handshake takes milliseconds of CPU (ECDHE, signing), so it runs on the pool, not on the thread which delivers the packets
+				if(DtlsHandshakePool::GetInstance()->Post(_handshake_strand, [this, data]() { ProcessDtlsPacket(data); }) == false)
 				{
-					char buffer[MAX_DTLS_PACKET_LEN];
-
-					// SSL -> Read() -> TakeDtlsPacket() -> Decrypt -> buffer
-					[[maybe_unused]] int ssl_error = _tls.Read(buffer, sizeof(buffer), nullptr);
-
-					int pending = _tls.Pending();
-					if(pending >= 0)
-					{
-						logtd("Short DTLS read. Flushing %d bytes", pending);
-						_tls.FlushInput();
-					}
-
-					// TODO: Currently, SCTP is not supported, so there is no need to encrypt, 
-					// and it will be developed if it supports data channels in the future.
-					logtd("Unknown dtls packet received (%d)", ssl_error);
+					logtd("DTLS packet is dropped, because the handshake pool is busy");
 				}
 
 				return true;
@@ -302,6 +288,53 @@ bool DtlsTransport::OnDataReceived(pub::SessionNodeType from_node, const std::sh
 	return false;
 }
 
+void DtlsTransport::ProcessDtlsPacket(const std::shared_ptr<const ov::Data> &data)
+{
+	std::lock_guard<std::mutex> lock(_tls_lock);
+
+	if(GetState() != SessionNode::NodeState::Started)
+	{
+		// Stopped while the packet was waiting in the pool
+		return;
+	}
+
+	// Packet을 Queue에 쌓는다.
+	SaveDtlsPacket(data);
+
+	if(_state == SSL_CONNECTING)
+	{
+		auto start_time = std::chrono::steady_clock::now();
+
+		ContinueSSL();
+
+		_handshake_elapsed_us += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time).count();
+
+		if(_state == SSL_CONNECTED)
+		{
+			logtd("(%u) DTLS handshake is completed (%lld us)", GetSession()->GetId(), static_cast<long long>(_handshake_elapsed_us));
+			DtlsHandshakePool::GetInstance()->OnHandshakeCompleted(_handshake_elapsed_us);
+		}
+	}
+	else
+	{
+		char buffer[MAX_DTLS_PACKET_LEN];
+
+		// SSL -> Read() -> TakeDtlsPacket() -> Decrypt -> buffer
+		[[maybe_unused]] int ssl_error = _tls.Read(buffer, sizeof(buffer), nullptr);
+
+		int pending = _tls.Pending();
+		if(pending >= 0)
+		{
+			logtd("Short DTLS read. Flushing %d bytes", pending);
+			_tls.FlushInput();
+		}
+
+		// TODO: Currently, SCTP is not supported, so there is no need to encrypt, 
+		// and it will be developed if it supports data channels in the future.
+		logtd("Unknown dtls packet received (%d)", ssl_error);
+	}
+}
+
 ssize_t DtlsTransport::Read(ov::Tls *tls, void *buffer, size_t length)
 {
 	std::shared_ptr<const ov::Data> data = TakeDtlsPacket();
@@ -6,6 +6,7 @@
 
 #include "modules/ice/ice_port.h"
 #include "srtp_transport.h"
+#include "dtls_handshake_pool.h"
 
 #define DTLS_RECORD_HEADER_LEN                  13
 #define MAX_DTLS_PACKET_LEN                     2048
@@ -33,7 +34,7 @@ public:
 	// Implementation of SessionNode
 	//--------------------------------------------------------------------
 	// Receive data from upper node, and send data to lower node.
-	bool SendData(pub::SessionNodeType from_node, const std::shared_ptr<ov::Data> &data);
+	bool SendData(pub::SessionNodeType from_node, const std::shared_ptr<const ov::Data> &data);
 	// Receive data from lower node, and send data to upper node.
 	bool OnDataReceived(pub::SessionNodeType from_node, const std::shared_ptr<const ov::Data> &data);
 
@@ -55,6 +56,8 @@ protected:
 	bool VerifyPeerCertificate();
 
 private:
+	// Runs on _handshake_strand
+	void ProcessDtlsPacket(const std::shared_ptr<const ov::Data> &data);
 	bool ContinueSSL();
 	bool IsDtlsPacket(const std::shared_ptr<const ov::Data> data);
 	bool IsRtpPacket(const std::shared_ptr<const ov::Data> data);
@@ -73,8 +76,11 @@ private:
 		SSL_CLOSED
 	};
 
-	SSLState _state;
+	// SRTP packets are sent without _tls_lock after the handshake is completed
+	std::atomic<SSLState> _state;
 	bool _peer_cerificate_verified;
+	// Time spent in ContinueSSL() until the handshake is completed
+	int64_t _handshake_elapsed_us = 0;
 	std::shared_ptr<info::Session> _session_info;
 	std::shared_ptr<IcePort> _ice_port;
 	std::shared_ptr<SrtpTransport> _srtp_transport;
@@ -92,4 +98,8 @@ private:
 	std::mutex _tls_lock;
 
 	ov::Tls _tls;
+
+	// DTLS packets of this session are processed on DtlsHandshakePool in order.
+	// It is declared last, so it is stopped (waits for the running task) before the other members are destroyed.
+	ov::Strand _handshake_strand;
 };
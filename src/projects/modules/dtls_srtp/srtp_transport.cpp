@@ -9,6 +9,8 @@
 #include "srtp_transport.h"
 #include "dtls_transport.h"
 
+#include <base/ovlibrary/byte_io.h>
+
 #define OV_LOG_TAG "SRTP"
 
 SrtpTransport::SrtpTransport(uint32_t node_id, std::shared_ptr<pub::Session> session)
@@ -23,20 +25,32 @@ SrtpTransport::~SrtpTransport()
 
 bool SrtpTransport::Stop()
 {
-	if(_send_session != nullptr)
+	auto send_session = std::atomic_load(&_send_session);
+	if(send_session != nullptr)
 	{
-		_send_session->Release();
+		send_session->Release();
 	}
 
-	if(_recv_session != nullptr)
+	auto recv_session = std::atomic_load(&_recv_session);
+	if(recv_session != nullptr)
 	{
-		_recv_session->Release();
+		recv_session->Release();
 	}
 
 	return SessionNode::Stop();
 }
 
-bool SrtpTransport::SendData(pub::SessionNodeType from_node, const std::shared_ptr<ov::Data> &data)
+bool SrtpTransport::SendData(pub::SessionNodeType from_node, const std::shared_ptr<const ov::Data> &data)
+{
+	return Protect(from_node, data, nullptr);
+}
+
+bool SrtpTransport::SendRtpPacket(const std::shared_ptr<const ov::Data> &data, const RtpPacketRewrite &rewrite)
+{
+	return Protect(pub::SessionNodeType::Rtp, data, &rewrite);
+}
+
+bool SrtpTransport::Protect(pub::SessionNodeType from_node, const std::shared_ptr<const ov::Data> &data, const RtpPacketRewrite *rewrite)
 {
 	if(GetState() != SessionNode::NodeState::Started)
 	{
@@ -44,21 +58,44 @@ bool SrtpTransport::SendData(pub::SessionNodeType from_node, const std::shared_p
 		return false;
 	}
 
-	if(!_send_session)
+	auto send_session = std::atomic_load(&_send_session);
+	if(!send_session)
 	{
 		return false;
 	}
+
+	// data is shared with the other sessions, so it is protected in a scratch buffer of this session
+	std::unique_lock<std::mutex> lock(_scratch_mutex);
+
+	auto protected_data = GetScratchBuffer(data->GetLength() + SRTP_MAX_TRAILER_LEN);
+	if(protected_data == nullptr || !protected_data->Append(data->GetData(), data->GetLength()))
+	{
+		return false;
+	}
+
+	if((rewrite != nullptr) && (protected_data->GetLength() >= FIXED_HEADER_SIZE))
+	{
+		auto buffer = protected_data->GetWritableDataAs<uint8_t>();
+
+		ByteWriter<uint16_t>::WriteBigEndian(buffer + 2, ByteReader<uint16_t>::ReadBigEndian(buffer + 2) + rewrite->sequence_number_offset);
+
+		if((rewrite->sn_base_position > 0) && ((rewrite->sn_base_position + 2) <= protected_data->GetLength()))
+		{
+			auto sn_base = buffer + rewrite->sn_base_position;
+			ByteWriter<uint16_t>::WriteBigEndian(sn_base, ByteReader<uint16_t>::ReadBigEndian(sn_base) + rewrite->sn_base_offset);
+		}
+	}
 	
 	if(from_node == pub::SessionNodeType::Rtp)
 	{
-		if(!_send_session->ProtectRtp(data))
+		if(!send_session->ProtectRtp(protected_data))
 		{
 			return false;
 		}
 	}
 	else if(from_node == pub::SessionNodeType::Rtcp)
 	{
-		 if(!_send_session->ProtectRtcp(data))
+		 if(!send_session->ProtectRtcp(protected_data))
 		 {
 			return false;
 		 }
@@ -68,6 +105,8 @@ bool SrtpTransport::SendData(pub::SessionNodeType from_node, const std::shared_p
 		return false;
 	}
 
+	lock.unlock();
+
 	// To DTLS transport
 	auto node = GetLowerNode();
 	if(!node)
@@ -75,8 +114,48 @@ bool SrtpTransport::SendData(pub::SessionNodeType from_node, const std::shared_p
 		return false;
 	}
 	
-	logtd("SrtpTransport Send next node : %d", data->GetLength());
-	return node->SendData(GetNodeType(), data);
+	logtd("SrtpTransport Send next node : %d", protected_data->GetLength());
+	return node->SendData(GetNodeType(), protected_data);
+}
+
+std::shared_ptr<ov::Data> SrtpTransport::GetScratchBuffer(size_t capacity)
+{
+	std::shared_ptr<ov::Data> buffer;
+	auto count = _scratch_buffer_list.size();
+
+	// Buffers are handed out in order, so the next one is the most likely to be released already
+	for(size_t i = 0; i < count; i++)
+	{
+		auto &candidate = _scratch_buffer_list[(_scratch_buffer_index + i) % count];
+
+		if(candidate.use_count() == 1)
+		{
+			// Pairs with the release of the last reference in the other thread
+			std::atomic_thread_fence(std::memory_order_acquire);
+			buffer = candidate;
+			_scratch_buffer_index = (_scratch_buffer_index + i + 1) % count;
+			break;
+		}
+	}
+
+	if(buffer == nullptr)
+	{
+		buffer = std::make_shared<ov::Data>(capacity);
+
+		if(count < SRTP_SCRATCH_BUFFER_COUNT)
+		{
+			_scratch_buffer_list.push_back(buffer);
+		}
+		// Otherwise, the lower nodes are holding all the buffers (e.g. the socket is congested), so this one is not kept
+	}
+
+	// SetLength(0) keeps the memory of the buffer (Clear() would allocate a new one)
+	if(!buffer->SetLength(0) || !buffer->Reserve(capacity))
+	{
+		return nullptr;
+	}
+
+	return buffer;
 }
 
 bool SrtpTransport::OnDataReceived(pub::SessionNodeType from_node, const std::shared_ptr<const ov::Data> &data)
@@ -87,13 +166,14 @@ bool SrtpTransport::OnDataReceived(pub::SessionNodeType from_node, const std::sh
 		return false;
 	}
 
-	if(_recv_session == nullptr)
+	auto recv_session = std::atomic_load(&_recv_session);
+	if(recv_session == nullptr)
 	{
 		return false;
 	}
 
 	auto decode_data = data->Clone();
-    if(!_recv_session->UnprotectRtcp(decode_data))
+    if(!recv_session->UnprotectRtcp(decode_data))
     {
         logtd("stcp unprotected fail");
         return false;
@@ -111,39 +191,42 @@ bool SrtpTransport::OnDataReceived(pub::SessionNodeType from_node, const std::sh
 }
 
 // Initialize SRTP
+// It is called by the DTLS handshake pool while the other threads send and receive,
+// so the sessions are published after they are keyed
 bool SrtpTransport::SetKeyMeterial(uint64_t crypto_suite, std::shared_ptr<ov::Data> server_key, std::shared_ptr<ov::Data> client_key)
 {
-	if(_send_session || _recv_session)
+	if(std::atomic_load(&_send_session) || std::atomic_load(&_recv_session))
 	{
 		return false;
 	}
 
 	logtd("Try to set key meterial");
 
-	_send_session = std::make_shared<SrtpAdapter>();
-	if(_send_session == nullptr)
+	auto send_session = std::make_shared<SrtpAdapter>();
+	if(send_session == nullptr)
 	{
 		logte("Create srtp adapter failed");
 		return false;
 	}
 
-	if(!_send_session->SetKey(ssrc_any_outbound, crypto_suite, server_key))
+	if(!send_session->SetKey(ssrc_any_outbound, crypto_suite, server_key))
 	{
 		return false;
 	}
 
-	_recv_session = std::make_shared<SrtpAdapter>();
-	if(_recv_session == nullptr)
+	auto recv_session = std::make_shared<SrtpAdapter>();
+	if(recv_session == nullptr)
 	{
-		_send_session.reset();
-		_send_session = nullptr;
 		return false;
 	}
 
-	if(!_recv_session->SetKey(ssrc_any_inbound, crypto_suite, client_key))
+	if(!recv_session->SetKey(ssrc_any_inbound, crypto_suite, client_key))
 	{
 		return false;
 	}
 
+	std::atomic_store(&_recv_session, recv_session);
+	std::atomic_store(&_send_session, send_session);
+
 	return true;
-}
\ No newline at end of file
+}
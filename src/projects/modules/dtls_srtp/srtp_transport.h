@@ -13,6 +13,10 @@
 #include "modules/rtp_rtcp/rtp_rtcp.h"
 #include "srtp_adapter.h"
 
+// Maximum number of scratch buffers that a session keeps for SRTP protection.
+// A buffer is reused after the lower nodes (batch list, socket send queue) release it.
+#define SRTP_SCRATCH_BUFFER_COUNT 64
+
 class SrtpTransport : public pub::SessionNode
 {
 public:
@@ -22,7 +26,9 @@ public:
 	bool Stop() override;
 
 	// 데이터를 upper에서 받는다. lower node로 보낸다.
-	bool SendData(pub::SessionNodeType from_node, const std::shared_ptr<ov::Data> &data) override;
+	bool SendData(pub::SessionNodeType from_node, const std::shared_ptr<const ov::Data> &data) override;
+	// Sends an RTP packet with the sequence numbers rewritten in the protected copy, so data is not modified
+	bool SendRtpPacket(const std::shared_ptr<const ov::Data> &data, const RtpPacketRewrite &rewrite);
 
 	// 데이터를 lower에서 받는다. upper node로 보낸다.
 	bool OnDataReceived(pub::SessionNodeType from_node, const std::shared_ptr<const ov::Data> &data) override;
@@ -32,6 +38,16 @@ public:
 						std::shared_ptr<ov::Data> server_key, std::shared_ptr<ov::Data> client_key);
 
 private:
+	bool Protect(pub::SessionNodeType from_node, const std::shared_ptr<const ov::Data> &data, const RtpPacketRewrite *rewrite);
+
+	// Returns a buffer that nobody else refers to, to protect the packet without modifying the source
+	std::shared_ptr<ov::Data> GetScratchBuffer(size_t capacity);
+
+	// Set by the DTLS handshake pool, so they are accessed with std::atomic_load()/std::atomic_store()
 	std::shared_ptr<SrtpAdapter>		_send_session;
 	std::shared_ptr<SrtpAdapter>		_recv_session;
+
+	std::mutex							_scratch_mutex;
+	std::vector<std::shared_ptr<ov::Data>>	_scratch_buffer_list;
+	size_t								_scratch_buffer_index = 0;
 };
@@ -156,13 +156,11 @@ bool IcePort::Close()
 
 ov::String IcePort::GenerateUfrag()
 {
-	std::lock_guard<std::mutex> lock_guard(_user_mapping_table_mutex);
-
 	while (true)
 	{
 		ov::String ufrag = ov::Random::GenerateString(6);
 
-		if (_user_mapping_table.find(ufrag) == _user_mapping_table.end())
+		if (_user_mapping_table.Contains(ufrag) == false)
 		{
 			logtd("Generated ufrag: %s", ufrag.CStr());
 
@@ -220,64 +218,51 @@ void IcePort::AddSession(const std::shared_ptr<info::Session> &session_info, std
 	const ov::String &local_ufrag = offer_sdp->GetIceUfrag();
 	const ov::String &remote_ufrag = peer_sdp->GetIceUfrag();
 
-	{
-		std::lock_guard<std::mutex> lock_guard(_user_mapping_table_mutex);
-
-		auto item = _user_mapping_table.find(local_ufrag);
+	[[maybe_unused]] session_id_t session_id = session_info->GetId();
 
-		[[maybe_unused]] session_id_t session_id = session_info->GetId();
+	{
+		std::shared_ptr<IcePortInfo> old_info;
 
-		if (item != _user_mapping_table.end())
+		if (_user_mapping_table.Find(local_ufrag, &old_info))
 		{
-			OV_ASSERT(false, "Duplicated ufrag: %s:%s, session_id: %d (old session_id: %d)", local_ufrag.CStr(), remote_ufrag.CStr(), session_id, item->second->session_info->GetId());
+			OV_ASSERT(false, "Duplicated ufrag: %s:%s, session_id: %d (old session_id: %d)", local_ufrag.CStr(), remote_ufrag.CStr(), session_id, old_info->session_info->GetId());
 		}
+	}
 
-		logtd("Trying to add session: %d (ufrag: %s:%s)...", session_id, local_ufrag.CStr(), remote_ufrag.CStr());
+	logtd("Trying to add session: %d (ufrag: %s:%s)...", session_id, local_ufrag.CStr(), remote_ufrag.CStr());
 
-		// 나중에 STUN Binding request를 대비하여 관련 정보들을 넣어놓음
-		std::shared_ptr<IcePortInfo> info = std::make_shared<IcePortInfo>();
+	// 나중에 STUN Binding request를 대비하여 관련 정보들을 넣어놓음
+	std::shared_ptr<IcePortInfo> info = std::make_shared<IcePortInfo>();
 
-		info->session_info = session_info;
-		info->offer_sdp = offer_sdp;
-		info->peer_sdp = peer_sdp;
-		info->remote = nullptr;
-		info->address = ov::SocketAddress();
-		info->state = IcePortConnectionState::Closed;
+	info->session_info = session_info;
+	info->offer_sdp = offer_sdp;
+	info->peer_sdp = peer_sdp;
+	info->remote = nullptr;
+	info->address = ov::SocketAddress();
+	info->state = IcePortConnectionState::Closed;
+	info->integrity_key.SetKey(offer_sdp->GetIcePwd());
 
-		info->UpdateBindingTime();
+	info->UpdateBindingTime();
 
-		_user_mapping_table[local_ufrag] = info;
-	}
+	_user_mapping_table.Set(local_ufrag, info);
 
-	SetIceState(_user_mapping_table[local_ufrag], IcePortConnectionState::New);
+	SetIceState(info, IcePortConnectionState::New);
 }
 
 bool IcePort::RemoveSession(const session_id_t session_id)
 {
 	std::shared_ptr<IcePortInfo> ice_port_info;
 
+	if (_session_table.Find(session_id, &ice_port_info) == false)
 	{
-		std::lock_guard<std::mutex> lock_guard(_ice_port_info_mutex);
-
-		auto item = _session_table.find(session_id);
-
-		if (item == _session_table.end())
-		{
-			logtw("Could not find session: %d", session_id);
-
-			return false;
-		}
-
-		ice_port_info = item->second;
+		logtw("Could not find session: %d", session_id);
 
-		_session_table.erase(item);
-		_ice_port_info.erase(ice_port_info->address);
+		return false;
 	}
 
-	{
-		std::lock_guard<std::mutex> lock_guard(_user_mapping_table_mutex);
-		_user_mapping_table.erase(ice_port_info->offer_sdp->GetIceUfrag());
-	}
+	_session_table.Erase(session_id);
+	_ice_port_info.Erase(ice_port_info->address);
+	_user_mapping_table.Erase(ice_port_info->offer_sdp->GetIceUfrag());
 
 	return true;
 }
@@ -304,22 +289,26 @@ bool IcePort::Send(const std::shared_ptr<info::Session> &session_info, const std
 
 	std::shared_ptr<IcePortInfo> ice_port_info;
 
+	if (_session_table.Find(session_info->GetId(), &ice_port_info) == false)
 	{
-		std::lock_guard<std::mutex> lock_guard(_ice_port_info_mutex);
+		// logtw("ClientSocket not found for session #%d", session_info->GetId());
+		return false;
+	}
 
-		auto item = _session_table.find(session_info->GetId());
+	// logtd("Sending data to remote for session #%d", session_info->GetId());
+	return ice_port_info->remote->SendTo(ice_port_info->address, data) >= 0;
+}
 
-		if (item == _session_table.end())
-		{
-			// logtw("ClientSocket not found for session #%d", session_info->GetId());
-			return false;
-		}
+bool IcePort::Send(const std::shared_ptr<info::Session> &session_info, const std::vector<std::shared_ptr<const ov::Data>> &data_list)
+{
+	std::shared_ptr<IcePortInfo> ice_port_info;
 
-		ice_port_info = item->second;
+	if (_session_table.Find(session_info->GetId(), &ice_port_info) == false)
+	{
+		return false;
 	}
 
-	// logtd("Sending data to remote for session #%d", session_info->GetId());
-	return ice_port_info->remote->SendTo(ice_port_info->address, data) >= 0;
+	return ice_port_info->remote->SendToBatch(ice_port_info->address, data_list) >= 0;
 }
 
 void IcePort::OnConnected(const std::shared_ptr<ov::Socket> &remote)
@@ -334,10 +323,18 @@ void IcePort::OnDataReceived(const std::shared_ptr<ov::Socket> &remote, const ov
 	// TODO: 지금은 data 안에 하나의 STUN 메시지만 있을 것으로 간주하고 작성되어 있음
 	// TODO: TCP의 경우, 데이터가 많이 들어올 수 있기 때문에 별도 처리 필요
 
+	if (ProcessConsentCheck(remote, address, data))
+	{
+		return;
+	}
+
+	// RFC 7983: The first byte of STUN is 0~3 (DTLS: 20~63, RTP/RTCP: 128~191), so the media is not parsed as STUN
+	bool is_stun_packet = (data->GetLength() > 0) && (data->GetDataAs<uint8_t>()[0] <= 3);
+
 	ov::ByteStream stream(data.get());
 	StunMessage message;
 
-	if (message.Parse(stream))
+	if (is_stun_packet && message.Parse(stream))
 	{
 		// STUN 패킷이 맞음
 		logtd("Received message:\n%s", message.ToString().CStr());
@@ -385,18 +382,7 @@ void IcePort::OnDataReceived(const std::shared_ptr<ov::Socket> &remote, const ov
 
 		std::shared_ptr<IcePortInfo> ice_port_info;
 
-		{
-			std::lock_guard<std::mutex> lock_guard(_ice_port_info_mutex);
-
-			auto item = _ice_port_info.find(address);
-
-			if (item != _ice_port_info.end())
-			{
-				ice_port_info = item->second;
-			}
-		}
-
-		if (ice_port_info == nullptr)
+		if (_ice_port_info.Find(address, &ice_port_info) == false)
 		{
 			// 포트 정보가 없음
 			// 이전 단계에서 관련 정보가 저장되어 있어야 함
@@ -418,38 +404,64 @@ void IcePort::OnDataReceived(const std::shared_ptr<ov::Socket> &remote, const ov
 
 void IcePort::CheckTimedoutItem()
 {
-	std::vector<std::shared_ptr<IcePortInfo>> delete_list;
+	auto delete_list = _user_mapping_table.EraseIf([](const ov::String &ufrag, const std::shared_ptr<IcePortInfo> &info) -> bool {
+		return info->IsExpired();
+	});
 
+	for (auto &deleted_ice_port : delete_list)
 	{
-		std::lock_guard<std::mutex> lock_guard(_user_mapping_table_mutex);
+		logtd("Client %s(session id: %d) is expired", deleted_ice_port->address.ToString().CStr(), deleted_ice_port->session_info->GetId());
+		SetIceState(deleted_ice_port, IcePortConnectionState::Disconnected);
 
-		for (auto item = _user_mapping_table.begin(); item != _user_mapping_table.end();)
-		{
-			if (item->second->IsExpired())
-			{
-				logtd("Client %s(session id: %d) is expired", item->second->address.ToString().CStr(), item->second->session_info->GetId());
-				SetIceState(item->second, IcePortConnectionState::Disconnected);
+		_session_table.Erase(deleted_ice_port->session_info->GetId());
+		_ice_port_info.Erase(deleted_ice_port->address);
+	}
+}
 
-				delete_list.push_back(item->second);
+bool IcePort::ProcessConsentCheck(const std::shared_ptr<ov::Socket> &remote, const ov::SocketAddress &address, const std::shared_ptr<const ov::Data> &data)
+{
+	auto buffer = data->GetDataAs<uint8_t>();
+	auto length = data->GetLength();
 
-				item = _user_mapping_table.erase(item);
-			}
-			else
-			{
-				++item;
-			}
-		}
+	if (StunFastPath::IsBindingRequest(buffer, length) == false)
+	{
+		return false;
 	}
 
+	std::shared_ptr<IcePortInfo> ice_port_info;
+
+	if ((_ice_port_info.Find(address, &ice_port_info) == false) || (ice_port_info->state != IcePortConnectionState::Connected))
 	{
-		std::lock_guard<std::mutex> lock_guard(_ice_port_info_mutex);
+		// Connectivity checks (before the session is connected) are processed by StunMessage
+		return false;
+	}
+
+	uint8_t response[OV_STUN_FAST_PATH_RESPONSE_LENGTH];
+	size_t response_length = 0;
 
-		for (auto &deleted_ice_port : delete_list)
+	{
+		std::lock_guard<std::mutex> lock_guard(ice_port_info->integrity_key_mutex);
+
+		if (StunFastPath::ValidateBindingRequest(buffer, length, ice_port_info->offer_sdp->GetIceUfrag(), ice_port_info->integrity_key) == false)
 		{
-			_session_table.erase(deleted_ice_port->session_info->GetId());
-			_ice_port_info.erase(deleted_ice_port->address);
+			logtd("Could not validate the consent check from %s. Passing it to StunMessage...", address.ToString().CStr());
+			return false;
 		}
+
+		response_length = StunFastPath::WriteBindingResponse(buffer, address, ice_port_info->integrity_key, response, sizeof(response));
+	}
+
+	if (response_length == 0)
+	{
+		// IPv6
+		return false;
 	}
+
+	ice_port_info->UpdateBindingTime();
+
+	remote->SendTo(address, response, response_length);
+
+	return true;
 }
 
 bool IcePort::ProcessBindingRequest(const std::shared_ptr<ov::Socket> &remote, const ov::SocketAddress &address, const StunMessage &request_message)
@@ -468,18 +480,10 @@ bool IcePort::ProcessBindingRequest(const std::shared_ptr<ov::Socket> &remote, c
 
 	std::shared_ptr<IcePortInfo> ice_port_info;
 
+	if (_user_mapping_table.Find(local_ufrag, &ice_port_info) == false)
 	{
-		std::lock_guard<std::mutex> lock_guard(_user_mapping_table_mutex);
-
-		auto info = _user_mapping_table.find(local_ufrag);
-
-		if (info == _user_mapping_table.end())
-		{
-			logtd("User not found: %s (AddSession() needed)", local_ufrag.CStr());
-			return false;
-		}
-
-		ice_port_info = info->second;
+		logtd("User not found: %s (AddSession() needed)", local_ufrag.CStr());
+		return false;
 	}
 
 	if (ice_port_info->peer_sdp->GetIceUfrag() != remote_ufrag)
@@ -499,18 +503,9 @@ bool IcePort::ProcessBindingRequest(const std::shared_ptr<ov::Socket> &remote, c
 
 		SetIceState(ice_port_info, IcePortConnectionState::Failed);
 
-		{
-			std::lock_guard<std::mutex> lock_guard(_user_mapping_table_mutex);
-
-			_user_mapping_table.erase(local_ufrag);
-		}
-
-		{
-			std::lock_guard<std::mutex> lock_guard(_ice_port_info_mutex);
-
-			_ice_port_info.erase(ice_port_info->address);
-			_session_table.erase(ice_port_info->session_info->GetId());
-		}
+		_user_mapping_table.Erase(local_ufrag);
+		_ice_port_info.Erase(ice_port_info->address);
+		_session_table.Erase(ice_port_info->session_info->GetId());
 
 		return false;
 	}
@@ -557,20 +552,15 @@ bool IcePort::SendBindingResponse(const std::shared_ptr<ov::Socket> &remote, con
 	remote->SendTo(address, serialized);
 
 	// client mapping 정보를 저장해놓음
+	if (_session_table.Insert(info->session_info->GetId(), info))
 	{
-		std::lock_guard<std::mutex> lock_guard(_ice_port_info_mutex);
+		logtd("Add the client to the port list: %s", address.ToString().CStr());
 
-		if (_session_table.find(info->session_info->GetId()) == _session_table.end())
-		{
-			logtd("Add the client to the port list: %s", address.ToString().CStr());
-
-			_ice_port_info[address] = info;
-			_session_table[info->session_info->GetId()] = info;
-		}
-		else
-		{
-			// Updated
-		}
+		_ice_port_info.Set(address, info);
+	}
+	else
+	{
+		// Updated
 	}
 
 	SendBindingRequest(remote, address, info);
@@ -653,22 +643,14 @@ bool IcePort::ProcessBindingResponse(const std::shared_ptr<ov::Socket> &remote,
 
 	std::shared_ptr<IcePortInfo> ice_port_info;
 
+	if (_ice_port_info.Find(address, &ice_port_info) == false)
 	{
-		std::lock_guard<std::mutex> lock_guard(_ice_port_info_mutex);
-
-		auto item = _ice_port_info.find(address);
-
-		if (item == _ice_port_info.end())
-		{
-			// 포트 정보가 없음
-			// 이전 단계에서 관련 정보가 저장되어 있어야 함
-
-			// 같은 ufrag에 대해 서로 다른 ICE candidate로 부터 동시에 접속 요청이 왔다면, 첫 번째로 도착한 ICE candidate가 저장됨
-			// 따라서 두 번째 address는 처리하지 않으므로, 없다고 간주
-			return false;
-		}
+		// 포트 정보가 없음
+		// 이전 단계에서 관련 정보가 저장되어 있어야 함
 
-		ice_port_info = item->second;
+		// 같은 ufrag에 대해 서로 다른 ICE candidate로 부터 동시에 접속 요청이 왔다면, 첫 번째로 도착한 ICE candidate가 저장됨
+		// 따라서 두 번째 address는 처리하지 않으므로, 없다고 간주
+		return false;
 	}
 
 	// SDP의 password로 무결성 검사를 한 뒤
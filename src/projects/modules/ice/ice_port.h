@@ -10,6 +10,7 @@
 
 #include "ice_port_observer.h"
 #include "modules/ice/stun/stun_message.h"
+#include "modules/ice/stun/stun_fast_path.h"
 
 #include <vector>
 #include <memory>
@@ -36,9 +37,14 @@ protected:
 		std::shared_ptr<ov::Socket> remote;
 		ov::SocketAddress address;
 
-		IcePortConnectionState state;
+		// Consent checks of the connected sessions are processed on the threads which receive them
+		std::atomic<IcePortConnectionState> state;
 
-		std::chrono::time_point<std::chrono::system_clock> expire_time;
+		// HMAC key for the STUN messages from the client (ICE password of offer_sdp), which is prepared once
+		ov::HmacSha1 integrity_key;
+		std::mutex integrity_key_mutex;
+
+		std::atomic<std::chrono::time_point<std::chrono::system_clock>> expire_time;
 
 		void UpdateBindingTime()
 		{
@@ -47,7 +53,7 @@ protected:
 
 		bool IsExpired() const
 		{
-			return (std::chrono::system_clock::now() > expire_time);
+			return (std::chrono::system_clock::now() > expire_time.load());
 		}
 	};
 
@@ -65,15 +71,15 @@ public:
 	{
 		OV_ASSERT2(session_info != nullptr);
 
-		auto item = _session_table.find(session_info->GetId());
+		std::shared_ptr<IcePortInfo> info;
 
-		if(item == _session_table.end())
+		if(_session_table.Find(session_info->GetId(), &info) == false)
 		{
 			OV_ASSERT(false, "Invalid session_id: %d", session_info->GetId());
 			return IcePortConnectionState::Failed;
 		}
 
-		return item->second->state;
+		return info->state;
 	}
 
 	ov::String GenerateUfrag();
@@ -94,6 +100,8 @@ public:
 	bool Send(const std::shared_ptr<info::Session> &session_info, std::unique_ptr<RtpPacket> packet);
 	bool Send(const std::shared_ptr<info::Session> &session_info, std::unique_ptr<RtcpPacket> packet);
 	bool Send(const std::shared_ptr<info::Session> &session_info, const std::shared_ptr<const ov::Data> &data);
+	// Send several packets to the session at once (UDP datagrams are sent using sendmmsg())
+	bool Send(const std::shared_ptr<info::Session> &session_info, const std::vector<std::shared_ptr<const ov::Data>> &data_list);
 
 	ov::String ToString() const;
 
@@ -116,6 +124,10 @@ protected:
 private:
 	void CheckTimedoutItem();
 
+	// Consent freshness check (RFC 7675) of a connected session, which is handled by StunFastPath.
+	// Returns false if data must be processed by StunMessage
+	bool ProcessConsentCheck(const std::shared_ptr<ov::Socket> &remote, const ov::SocketAddress &address, const std::shared_ptr<const ov::Data> &data);
+
 	// STUN negotiation order:
 	// (State: New)
 	// [Server] <-- 1. Binding Request          --- [Player]
@@ -141,18 +153,17 @@ private:
 	// binding이 완료되면 이후로는 destination ip & port로 구분하기 때문에 필요 없어짐
 	// key: offer ufrag
 	// value: IcePortInfo
-	std::map<const ov::String, std::shared_ptr<IcePortInfo>> _user_mapping_table;
-	std::mutex _user_mapping_table_mutex;
+	ov::StripedMap<ov::String, std::shared_ptr<IcePortInfo>> _user_mapping_table;
 
 	// STUN nego가 완료되면 생성되는 mapping table
+	// (every received packet and every sent packet looks up these tables, so they are hashed and lock-striped)
 
 	// 상대방의 ip:port로 IcePortInfo를 바로 찾을 수 있게 함
 	// key: SocketAddress
 	// value: IcePortInfo
-	std::mutex _ice_port_info_mutex;
-	std::map<ov::SocketAddress, std::shared_ptr<IcePortInfo>> _ice_port_info;
+	ov::StripedMap<ov::SocketAddress, std::shared_ptr<IcePortInfo>> _ice_port_info;
 	// session_id로 IcePortInfo를 바로 찾을 수 있게 함
-	std::map<session_id_t, std::shared_ptr<IcePortInfo>> _session_table;
+	ov::StripedMap<session_id_t, std::shared_ptr<IcePortInfo>> _session_table;
 
 	// 마지막으로 STUN 메시지가 온 시점을 기억함
 	ov::DelayQueue _timer;
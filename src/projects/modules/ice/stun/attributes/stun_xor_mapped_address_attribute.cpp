@@ -83,7 +83,7 @@ bool StunXorMappedAddressAttribute::Serialize(ov::ByteStream &stream) const noex
 	return StunAttribute::Serialize(stream) &&
 	       stream.Write8(0x00) &&
 	       stream.Write8((uint8_t)GetFamily()) &&
-	       stream.WriteBE16((uint16_t)GetPort()) &&
+	       stream.WriteBE16((uint16_t)address1.Port()) &&
 	       stream.Write(address1.ToAddrIn(), GetAddressLength());
 }
 
@@ -0,0 +1,214 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2020 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "stun_fast_path.h"
+
+#include <base/ovlibrary/byte_io.h>
+
+#include "modules/ice/ice_private.h"
+#include "stun_message.h"
+
+// Type (2B) + Length (2B)
+#define STUN_ATTRIBUTE_HEADER_LENGTH 4
+// Binding (0x0001) + Request (0b00)
+#define STUN_BINDING_REQUEST_TYPE 0x0001
+// Binding (0x0001) + Success Response (0b10)
+#define STUN_BINDING_SUCCESS_RESPONSE_TYPE 0x0101
+
+static inline size_t PaddedLength(size_t length)
+{
+	return (length + 3) & ~static_cast<size_t>(3);
+}
+
+bool StunFastPath::IsBindingRequest(const uint8_t *data, size_t length)
+{
+	if ((data == nullptr) || (length < StunMessage::DefaultHeaderLength()) || ((length & 0b11) != 0))
+	{
+		return false;
+	}
+
+	return (ByteReader<uint16_t>::ReadBigEndian(data) == STUN_BINDING_REQUEST_TYPE) &&
+		   (ByteReader<uint16_t>::ReadBigEndian(data + 2) == (length - StunMessage::DefaultHeaderLength())) &&
+		   (ByteReader<uint32_t>::ReadBigEndian(data + 4) == OV_STUN_MAGIC_COOKIE);
+}
+
+bool StunFastPath::ValidateBindingRequest(const uint8_t *data, size_t length, const ov::String &local_ufrag, ov::HmacSha1 &integrity_key)
+{
+	const uint8_t *user_name = nullptr;
+	size_t user_name_length = 0;
+	size_t integrity_offset = 0;
+	size_t fingerprint_offset = 0;
+
+	size_t offset = StunMessage::DefaultHeaderLength();
+
+	while ((offset + STUN_ATTRIBUTE_HEADER_LENGTH) <= length)
+	{
+		auto type = static_cast<StunAttributeType>(ByteReader<uint16_t>::ReadBigEndian(data + offset));
+		size_t attribute_length = ByteReader<uint16_t>::ReadBigEndian(data + offset + 2);
+
+		if ((offset + STUN_ATTRIBUTE_HEADER_LENGTH + attribute_length) > length)
+		{
+			return false;
+		}
+
+		if (fingerprint_offset != 0)
+		{
+			// FINGERPRINT must be the last attribute
+			return false;
+		}
+
+		switch (type)
+		{
+			case StunAttributeType::UserName:
+				if (integrity_offset == 0)
+				{
+					user_name = data + offset + STUN_ATTRIBUTE_HEADER_LENGTH;
+					user_name_length = attribute_length;
+				}
+				break;
+
+			case StunAttributeType::MessageIntegrity:
+				if (attribute_length != OV_STUN_HASH_LENGTH)
+				{
+					return false;
+				}
+
+				integrity_offset = offset;
+				break;
+
+			case StunAttributeType::Fingerprint:
+				if (attribute_length != sizeof(uint32_t))
+				{
+					return false;
+				}
+
+				fingerprint_offset = offset;
+				break;
+
+			default:
+				// The attributes after MESSAGE-INTEGRITY are ignored (RFC 5389, section 15.4)
+				break;
+		}
+
+		offset += STUN_ATTRIBUTE_HEADER_LENGTH + PaddedLength(attribute_length);
+	}
+
+	if ((offset != length) || (user_name == nullptr) || (integrity_offset == 0) || (fingerprint_offset == 0))
+	{
+		return false;
+	}
+
+	// FINGERPRINT: CRC-32 of the message before FINGERPRINT, XOR'ed with 0x5354554E
+	uint32_t crc = ov::Crc32::Calculate(data, fingerprint_offset) ^ OV_STUN_FINGERPRINT_XOR_VALUE;
+
+	if (crc != ByteReader<uint32_t>::ReadBigEndian(data + fingerprint_offset + STUN_ATTRIBUTE_HEADER_LENGTH))
+	{
+		logtd("Mismatched fingerprint");
+		return false;
+	}
+
+	// USERNAME: <local ufrag>:<remote ufrag>
+	size_t local_ufrag_length = local_ufrag.GetLength();
+
+	if ((user_name_length <= local_ufrag_length) ||
+		(::memcmp(user_name, local_ufrag.CStr(), local_ufrag_length) != 0) ||
+		(user_name[local_ufrag_length] != ':'))
+	{
+		logtd("Mismatched user name");
+		return false;
+	}
+
+	// MESSAGE-INTEGRITY: HMAC of the message before MESSAGE-INTEGRITY,
+	// but the length in the header must include MESSAGE-INTEGRITY (not FINGERPRINT)
+	uint8_t header[StunMessage::DefaultHeaderLength()];
+	::memcpy(header, data, sizeof(header));
+	ByteWriter<uint16_t>::WriteBigEndian(header + 2, static_cast<uint16_t>(integrity_offset + STUN_ATTRIBUTE_HEADER_LENGTH + OV_STUN_HASH_LENGTH - sizeof(header)));
+
+	uint8_t hash[OV_STUN_HASH_LENGTH];
+
+	if ((integrity_key.Update(header, sizeof(header)) &&
+		 integrity_key.Update(data + sizeof(header), integrity_offset - sizeof(header)) &&
+		 integrity_key.Finish(hash)) == false)
+	{
+		return false;
+	}
+
+	// Compares all bytes, to take the same time whether it matches or not
+	const uint8_t *expected = data + integrity_offset + STUN_ATTRIBUTE_HEADER_LENGTH;
+	uint8_t difference = 0;
+
+	for (size_t index = 0; index < OV_STUN_HASH_LENGTH; index++)
+	{
+		difference |= hash[index] ^ expected[index];
+	}
+
+	if (difference != 0)
+	{
+		logtd("Mismatched message integrity");
+		return false;
+	}
+
+	return true;
+}
+
+size_t StunFastPath::WriteBindingResponse(const uint8_t *request, const ov::SocketAddress &address, ov::HmacSha1 &integrity_key, uint8_t *buffer, size_t buffer_length)
+{
+	if ((address.GetFamily() != ov::SocketFamily::Inet) || (buffer_length < OV_STUN_FAST_PATH_RESPONSE_LENGTH))
+	{
+		return 0;
+	}
+
+	constexpr size_t header_length = StunMessage::DefaultHeaderLength();
+	constexpr size_t mapped_address_length = STUN_ATTRIBUTE_HEADER_LENGTH + 8;
+	constexpr size_t integrity_length = STUN_ATTRIBUTE_HEADER_LENGTH + OV_STUN_HASH_LENGTH;
+	constexpr size_t fingerprint_length = STUN_ATTRIBUTE_HEADER_LENGTH + sizeof(uint32_t);
+
+	uint8_t *current = buffer;
+
+	// Header: the transaction ID of the request is used
+	ByteWriter<uint16_t>::WriteBigEndian(current, STUN_BINDING_SUCCESS_RESPONSE_TYPE);
+	// Length until MESSAGE-INTEGRITY, to compute the HMAC
+	ByteWriter<uint16_t>::WriteBigEndian(current + 2, mapped_address_length + integrity_length);
+	ByteWriter<uint32_t>::WriteBigEndian(current + 4, OV_STUN_MAGIC_COOKIE);
+	::memcpy(current + 8, request + 8, OV_STUN_TRANSACTION_ID_LENGTH);
+	current += header_length;
+
+	// XOR-MAPPED-ADDRESS
+	ByteWriter<uint16_t>::WriteBigEndian(current, static_cast<uint16_t>(StunAttributeType::XorMappedAddress));
+	ByteWriter<uint16_t>::WriteBigEndian(current + 2, mapped_address_length - STUN_ATTRIBUTE_HEADER_LENGTH);
+	current[4] = 0x00;
+	current[5] = static_cast<uint8_t>(StunAddressFamily::IPv4);
+	ByteWriter<uint16_t>::WriteBigEndian(current + 6, static_cast<uint16_t>(address.Port() ^ (OV_STUN_MAGIC_COOKIE >> 16)));
+	// sin_addr is already in network byte order
+	uint32_t x_address = address.AddrInForIPv4()->s_addr ^ ov::HostToNetwork32(OV_STUN_MAGIC_COOKIE);
+	::memcpy(current + 8, &x_address, sizeof(x_address));
+	current += mapped_address_length;
+
+	// MESSAGE-INTEGRITY
+	ByteWriter<uint16_t>::WriteBigEndian(current, static_cast<uint16_t>(StunAttributeType::MessageIntegrity));
+	ByteWriter<uint16_t>::WriteBigEndian(current + 2, OV_STUN_HASH_LENGTH);
+
+	if (integrity_key.Compute(buffer, current - buffer, current + STUN_ATTRIBUTE_HEADER_LENGTH) == false)
+	{
+		return 0;
+	}
+
+	current += integrity_length;
+
+	// FINGERPRINT: the length in the header must include it
+	ByteWriter<uint16_t>::WriteBigEndian(buffer + 2, mapped_address_length + integrity_length + fingerprint_length);
+
+	uint32_t crc = ov::Crc32::Calculate(buffer, current - buffer) ^ OV_STUN_FINGERPRINT_XOR_VALUE;
+
+	ByteWriter<uint16_t>::WriteBigEndian(current, static_cast<uint16_t>(StunAttributeType::Fingerprint));
+	ByteWriter<uint16_t>::WriteBigEndian(current + 2, sizeof(uint32_t));
+	ByteWriter<uint32_t>::WriteBigEndian(current + 4, crc);
+	current += fingerprint_length;
+
+	return current - buffer;
+}
@@ -0,0 +1,40 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2020 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include "stun_datastructure.h"
+
+#include <base/ovcrypto/ovcrypto.h>
+#include <base/ovlibrary/ovlibrary.h>
+#include <base/ovsocket/ovsocket.h>
+
+// Header (20B) + XOR-MAPPED-ADDRESS (4B + 8B) + MESSAGE-INTEGRITY (4B + 20B) + FINGERPRINT (4B + 4B)
+#define OV_STUN_FAST_PATH_RESPONSE_LENGTH                       64
+
+// Handles the STUN binding requests of connected sessions (consent freshness checks, RFC 7675) without StunMessage.
+//
+// StunMessage allocates an object for every attribute, and MessageDigest::ComputeHmac() prepares the key for every message.
+// Browsers send a binding request every few seconds for every session, so these are validated where they are received,
+// with the HMAC key which is prepared once per session, and the response is written to a buffer on the stack.
+class StunFastPath
+{
+public:
+	// Checks the header only (RFC 5389, section 6): binding request, magic cookie, and the length of the message
+	static bool IsBindingRequest(const uint8_t *data, size_t length);
+
+	// Validates the binding request in place:
+	//  - USERNAME must be "<local_ufrag>:<remote ufrag>"
+	//  - MESSAGE-INTEGRITY must match integrity_key (the local ICE password)
+	//  - FINGERPRINT must be the last attribute, and must match
+	static bool ValidateBindingRequest(const uint8_t *data, size_t length, const ov::String &local_ufrag, ov::HmacSha1 &integrity_key);
+
+	// Writes a binding success response for request to buffer (OV_STUN_FAST_PATH_RESPONSE_LENGTH bytes or more).
+	// Only IPv4 is supported, like StunXorMappedAddressAttribute. Returns the length of the response (0 if it could not be written)
+	static size_t WriteBindingResponse(const uint8_t *request, const ov::SocketAddress &address, ov::HmacSha1 &integrity_key, uint8_t *buffer, size_t buffer_length);
+};
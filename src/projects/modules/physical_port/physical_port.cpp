@@ -33,7 +33,9 @@ PhysicalPort::~PhysicalPort()
 bool PhysicalPort::Create(ov::SocketType type,
 						  const ov::SocketAddress &address,
 						  int send_buffer_size,
-						  int recv_buffer_size)
+						  int recv_buffer_size,
+						  int reactor_count,
+						  ov::SocketBackend backend)
 {
 	OV_ASSERT2((_server_socket == nullptr) && (_datagram_socket == nullptr));
 
@@ -41,9 +43,16 @@ bool PhysicalPort::Create(ov::SocketType type,
 
 	switch (type)
 	{
-		case ov::SocketType::Srt:
-		case ov::SocketType::Tcp: {
-			return CreateServerSocket(type, address, send_buffer_size, recv_buffer_size);
+		case ov::SocketType::Tcp:
+			if (reactor_count > 0)
+			{
+				return CreateServerSocketReactors(type, address, send_buffer_size, recv_buffer_size, reactor_count, backend);
+			}
+
+			return CreateServerSocket(type, address, send_buffer_size, recv_buffer_size, backend);
+
+		case ov::SocketType::Srt: {
+			return CreateServerSocket(type, address, send_buffer_size, recv_buffer_size, ov::SocketBackend::Epoll);
 		}
 
 		case ov::SocketType::Udp: {
@@ -57,10 +66,66 @@ bool PhysicalPort::Create(ov::SocketType type,
 	return false;
 }
 
+ov::SocketConnectionState PhysicalPort::OnClientConnectionStateChanged(const std::shared_ptr<ov::ClientSocket> &client, ov::SocketConnectionState state, const std::shared_ptr<ov::Error> &error)
+{
+	switch (state)
+	{
+		case ov::SocketConnectionState::Connected: {
+			logtd("New client is connected: %s", client->ToString().CStr());
+
+			// Notify observers
+			auto func = std::bind(&PhysicalPortObserver::OnConnected, std::placeholders::_1, std::static_pointer_cast<ov::Socket>(client));
+			for_each(_observer_list.begin(), _observer_list.end(), func);
+
+			break;
+		}
+
+		case ov::SocketConnectionState::Disconnect: {
+			logtd("Disconnected by server: %s", client->ToString().CStr());
+
+			// Notify observers
+			auto func = bind(&PhysicalPortObserver::OnDisconnected, std::placeholders::_1, std::static_pointer_cast<ov::Socket>(client), PhysicalPortDisconnectReason::Disconnect, nullptr);
+			for_each(_observer_list.begin(), _observer_list.end(), func);
+
+			break;
+		}
+
+		case ov::SocketConnectionState::Disconnected: {
+			logtd("Client is disconnected: %s", client->ToString().CStr());
+
+			// Notify observers
+			auto func = bind(&PhysicalPortObserver::OnDisconnected, std::placeholders::_1, std::static_pointer_cast<ov::Socket>(client), PhysicalPortDisconnectReason::Disconnected, nullptr);
+			for_each(_observer_list.begin(), _observer_list.end(), func);
+
+			break;
+		}
+
+		case ov::SocketConnectionState::Error: {
+			logtd("Client is disconnected with error: %s (%s)", client->ToString().CStr(), (error != nullptr) ? error->ToString().CStr() : "N/A");
+
+			// Notify observers
+			auto func = bind(&PhysicalPortObserver::OnDisconnected, std::placeholders::_1, std::static_pointer_cast<ov::Socket>(client), PhysicalPortDisconnectReason::Error, error);
+			for_each(_observer_list.begin(), _observer_list.end(), func);
+
+			break;
+		}
+	}
+
+	return state;
+}
+
+void PhysicalPort::NotifyDataReceived(const std::shared_ptr<ov::ClientSocket> &client, const std::shared_ptr<const ov::Data> &data)
+{
+	// Notify observers
+	auto func = std::bind(&PhysicalPortObserver::OnDataReceived, std::placeholders::_1, std::static_pointer_cast<ov::Socket>(client), std::ref(*(client->GetRemoteAddress().get())), std::ref(data));
+	std::for_each(_observer_list.begin(), _observer_list.end(), func);
+}
+
 bool PhysicalPort::CreateServerSocket(ov::SocketType type,
 									  const ov::SocketAddress &address,
 									  int send_buffer_size,
-									  int recv_buffer_size)
+									  int recv_buffer_size,
+									  ov::SocketBackend backend)
 {
 	// Prepare physical port workers
 	{
@@ -73,6 +138,8 @@ bool PhysicalPort::CreateServerSocket(ov::SocketType type,
 
 	auto socket = std::make_shared<ov::ServerSocket>();
 
+	socket->SetBackend(backend);
+
 	if (socket->Prepare(type, address, send_buffer_size, recv_buffer_size, 4096))
 	{
 		_type = type;
@@ -81,52 +148,7 @@ bool PhysicalPort::CreateServerSocket(ov::SocketType type,
 		_need_to_stop = false;
 
 		auto proc = [&, socket]() -> void {
-			auto client_callback = [&](const std::shared_ptr<ov::ClientSocket> &client, ov::SocketConnectionState state, const std::shared_ptr<ov::Error> &error) -> ov::SocketConnectionState {
-				switch (state)
-				{
-					case ov::SocketConnectionState::Connected: {
-						logtd("New client is connected: %s", client->ToString().CStr());
-
-						// Notify observers
-						auto func = std::bind(&PhysicalPortObserver::OnConnected, std::placeholders::_1, std::static_pointer_cast<ov::Socket>(client));
-						for_each(_observer_list.begin(), _observer_list.end(), func);
-
-						break;
-					}
-
-					case ov::SocketConnectionState::Disconnect: {
-						logtd("Disconnected by server: %s", client->ToString().CStr());
-
-						// Notify observers
-						auto func = bind(&PhysicalPortObserver::OnDisconnected, std::placeholders::_1, std::static_pointer_cast<ov::Socket>(client), PhysicalPortDisconnectReason::Disconnect, nullptr);
-						for_each(_observer_list.begin(), _observer_list.end(), func);
-
-						break;
-					}
-
-					case ov::SocketConnectionState::Disconnected: {
-						logtd("Client is disconnected: %s", client->ToString().CStr());
-
-						// Notify observers
-						auto func = bind(&PhysicalPortObserver::OnDisconnected, std::placeholders::_1, std::static_pointer_cast<ov::Socket>(client), PhysicalPortDisconnectReason::Disconnected, nullptr);
-						for_each(_observer_list.begin(), _observer_list.end(), func);
-
-						break;
-					}
-
-					case ov::SocketConnectionState::Error: {
-						logtd("Client is disconnected with error: %s (%s)", client->ToString().CStr(), (error != nullptr) ? error->ToString().CStr() : "N/A");
-
-						// Notify observers
-						auto func = bind(&PhysicalPortObserver::OnDisconnected, std::placeholders::_1, std::static_pointer_cast<ov::Socket>(client), PhysicalPortDisconnectReason::Error, error);
-						for_each(_observer_list.begin(), _observer_list.end(), func);
-
-						break;
-					}
-				}
-
-				return state;
-			};
+			auto client_callback = std::bind(&PhysicalPort::OnClientConnectionStateChanged, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
 
 			auto data_callback = [&](const std::shared_ptr<ov::ClientSocket> &client, const std::shared_ptr<const ov::Data> &data) -> ov::SocketConnectionState {
 				auto sock = client->GetSocket();
@@ -181,6 +203,86 @@ bool PhysicalPort::CreateServerSocket(ov::SocketType type,
 	return false;
 }
 
+bool PhysicalPort::CreateServerSocketReactors(ov::SocketType type,
+											  const ov::SocketAddress &address,
+											  int send_buffer_size,
+											  int recv_buffer_size,
+											  int reactor_count,
+											  ov::SocketBackend backend)
+{
+	// Each reactor has its own listening socket bound to the same address (SO_REUSEPORT),
+	// so accept/recv/dispatch of a client are all processed in the reactor thread without PhysicalPortWorker
+	std::vector<std::shared_ptr<ov::ServerSocket>> socket_list;
+
+	for (int index = 0; index < reactor_count; index++)
+	{
+		auto socket = std::make_shared<ov::ServerSocket>();
+
+		socket->SetReusePort(true);
+		socket->SetBackend(backend);
+
+		if (socket->Prepare(type, address, send_buffer_size, recv_buffer_size, 4096) == false)
+		{
+			logte("Could not prepare reactor #%d for %s", index, address.ToString().CStr());
+
+			for (auto &prepared_socket : socket_list)
+			{
+				prepared_socket->Close();
+			}
+
+			return false;
+		}
+
+		socket_list.push_back(socket);
+	}
+
+	_type = type;
+	// The first socket represents this port
+	_server_socket = socket_list.front();
+	_reactor_socket_list = socket_list;
+
+	_need_to_stop = false;
+
+	for (int index = 0; index < reactor_count; index++)
+	{
+		auto socket = socket_list[index];
+
+		auto proc = [&, socket, index]() -> void {
+			if (ov::Platform::SetThreadAffinity(index) == false)
+			{
+				logtw("Could not pin reactor #%d to a processor", index);
+			}
+
+			auto client_callback = std::bind(&PhysicalPort::OnClientConnectionStateChanged, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
+
+			auto data_callback = [&](const std::shared_ptr<ov::ClientSocket> &client, const std::shared_ptr<const ov::Data> &data) -> ov::SocketConnectionState {
+				logtd("Received data %zu bytes", data->GetLength());
+
+				// The data of a client is always processed in the same reactor, so the order is guaranteed
+				NotifyDataReceived(client, data);
+
+				return ov::SocketConnectionState::Connected;
+			};
+
+			while ((_need_to_stop == false) && (socket->DispatchEvent(client_callback, data_callback, PHYSICAL_PORT_EPOLL_TIMEOUT_MSEC)))
+			{
+			}
+
+			socket->Close();
+
+			logtd("Reactor #%d is stopped", index);
+		};
+
+		_reactor_thread_list.emplace_back(proc);
+	}
+
+	_address = address;
+
+	logti("%d reactors are started for %s", reactor_count, address.ToString().CStr());
+
+	return true;
+}
+
 bool PhysicalPort::CreateDatagramSocket(ov::SocketType type, const ov::SocketAddress &address)
 {
 	auto socket = std::make_shared<ov::DatagramSocket>();
@@ -246,6 +348,26 @@ bool PhysicalPort::Close()
 
 	_thread = std::thread();
 
+	for (auto &thread : _reactor_thread_list)
+	{
+		if (thread.joinable())
+		{
+			thread.join();
+		}
+	}
+
+	_reactor_thread_list.clear();
+
+	for (auto &reactor_socket : _reactor_socket_list)
+	{
+		if (reactor_socket->GetState() != ov::SocketState::Closed)
+		{
+			reactor_socket->Close();
+		}
+	}
+
+	_reactor_socket_list.clear();
+
 	auto socket = GetSocket();
 
 	if (socket != nullptr)
@@ -333,5 +455,6 @@ bool PhysicalPort::RemoveObserver(PhysicalPortObserver *observer)
 
 bool PhysicalPort::DisconnectClient(ov::ClientSocket *client_socket)
 {
-	return _server_socket->DisconnectClient(client_socket, ov::SocketConnectionState::Disconnect);
+	// The client knows which ServerSocket (reactor) it belongs to
+	return client_socket->Close();
 }
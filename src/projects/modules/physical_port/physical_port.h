@@ -28,10 +28,14 @@ public:
 	PhysicalPort();
 	virtual ~PhysicalPort();
 
+	// If reactor_count > 0, the TCP port is served by <reactor_count> listening sockets (SO_REUSEPORT)
+	// backend is used for TCP port only
 	bool Create(ov::SocketType type,
 				const ov::SocketAddress &address,
 				int send_buffer_size = 0,
-				int recv_buffer_size = 0);
+				int recv_buffer_size = 0,
+				int reactor_count = 0,
+				ov::SocketBackend backend = ov::SocketBackend::Epoll);
 
 	bool Close();
 
@@ -75,10 +79,21 @@ protected:
 	bool CreateServerSocket(ov::SocketType type,
 							const ov::SocketAddress &address,
 							int send_buffer_size,
-							int recv_buffer_size);
+							int recv_buffer_size,
+							ov::SocketBackend backend);
+
+	bool CreateServerSocketReactors(ov::SocketType type,
+									const ov::SocketAddress &address,
+									int send_buffer_size,
+									int recv_buffer_size,
+									int reactor_count,
+									ov::SocketBackend backend);
 
 	bool CreateDatagramSocket(ov::SocketType type, const ov::SocketAddress &address);
 
+	ov::SocketConnectionState OnClientConnectionStateChanged(const std::shared_ptr<ov::ClientSocket> &client, ov::SocketConnectionState state, const std::shared_ptr<ov::Error> &error);
+	void NotifyDataReceived(const std::shared_ptr<ov::ClientSocket> &client, const std::shared_ptr<const ov::Data> &data);
+
 	ov::SocketType _type;
 	ov::SocketAddress _address;
 
@@ -88,6 +103,10 @@ protected:
 	volatile bool _need_to_stop;
 	std::thread _thread;
 
+	// Used when the port is created with reactors
+	std::vector<std::shared_ptr<ov::ServerSocket>> _reactor_socket_list;
+	std::vector<std::thread> _reactor_thread_list;
+
 	std::atomic<int> _ref_count { 0 };
 
 	std::vector<PhysicalPortObserver *> _observer_list;
@@ -30,7 +30,7 @@ std::shared_ptr<PhysicalPort> PhysicalPortManager::CreatePort(ov::SocketType typ
 	{
 		port = std::make_shared<PhysicalPort>();
 
-		if (port->Create(type, address))
+		if (port->Create(type, address, 0, 0, (type == ov::SocketType::Tcp) ? _tcp_reactor_count : 0, _tcp_backend))
 		{
 			_port_list[key] = port;
 		}
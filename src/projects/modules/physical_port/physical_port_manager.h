@@ -20,6 +20,18 @@ public:
 
 	virtual ~PhysicalPortManager();
 
+	// Number of reactors for the TCP ports created after this call (0: use PhysicalPortWorkers)
+	void SetTcpReactorCount(int reactor_count)
+	{
+		_tcp_reactor_count = reactor_count;
+	}
+
+	// Event mechanism for the TCP ports created after this call
+	void SetTcpBackend(ov::SocketBackend backend)
+	{
+		_tcp_backend = backend;
+	}
+
 	std::shared_ptr<PhysicalPort> CreatePort(ov::SocketType type, const ov::SocketAddress &address);
 
 	bool DeletePort(std::shared_ptr<PhysicalPort> &port);
@@ -30,4 +42,7 @@ protected:
 	std::map<std::pair<ov::SocketType, ov::SocketAddress>, std::shared_ptr<PhysicalPort>> _port_list;
 
 	std::mutex _port_list_mutex;
+
+	int _tcp_reactor_count = 0;
+	ov::SocketBackend _tcp_backend = ov::SocketBackend::Epoll;
 };
@@ -15,8 +15,7 @@
 #include "physical_port_private.h"
 
 PhysicalPortWorker::PhysicalPortWorker(const std::shared_ptr<PhysicalPort> &physical_port)
-	: _observer_list(physical_port->_observer_list),
-	  _physical_port(physical_port)
+	: _physical_port(physical_port)
 {
 }
 
@@ -86,20 +85,19 @@ bool PhysicalPortWorker::AddTask(const std::shared_ptr<ov::ClientSocket> &client
 
 void PhysicalPortWorker::ThreadProc()
 {
+	std::vector<Task> task_list;
+	task_list.reserve(PHYSICAL_PORT_WORKER_BATCH_COUNT);
+
 	while (_stop == false)
 	{
-		auto task = _task_list.Dequeue();
-
-		if (task.has_value())
+		if (_task_list.DequeueBatch(task_list, PHYSICAL_PORT_WORKER_BATCH_COUNT) > 0)
 		{
-			auto &value = task.value();
-
-			auto &client = value.client;
-			auto &data = value.data;
+			for (auto &task : task_list)
+			{
+				_physical_port->NotifyDataReceived(task.client, task.data);
+			}
 
-			// Notify observers
-			auto func = std::bind(&PhysicalPortObserver::OnDataReceived, std::placeholders::_1, std::static_pointer_cast<ov::Socket>(client), std::ref(*(client->GetRemoteAddress().get())), ref(data));
-			std::for_each(_observer_list.begin(), _observer_list.end(), func);
+			task_list.clear();
 		}
 	}
 }
\ No newline at end of file
@@ -12,6 +12,9 @@
 
 #include <thread>
 
+// Maximum number of tasks that PhysicalPortWorker takes from the queue at once
+#define PHYSICAL_PORT_WORKER_BATCH_COUNT 32
+
 class PhysicalPort;
 class PhysicalPortObserver;
 
@@ -41,11 +44,10 @@ protected:
 
 	void ThreadProc();
 
-	std::vector<PhysicalPortObserver *> &_observer_list;
 	std::shared_ptr<PhysicalPort> _physical_port;
 
 	std::thread _thread;
 	volatile bool _stop = true;
 
-	ov::Queue<Task> _task_list { nullptr, 500 };
+	ov::RingQueue<Task> _task_list { nullptr, 500, 4096 };
 };
@@ -0,0 +1,111 @@
+#include "bandwidth_estimator.h"
+
+#include <algorithm>
+
+BandwidthEstimator::BandwidthEstimator()
+{
+	_last_report_time = std::chrono::steady_clock::now();
+}
+
+void BandwidthEstimator::OnPacketSent(size_t bytes)
+{
+	_sent_bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void BandwidthEstimator::OnReceiverReport(uint8_t fraction_lost, uint32_t jitter, int64_t rtt_ms)
+{
+	auto now = std::chrono::steady_clock::now();
+	auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - _last_report_time).count();
+
+	if(elapsed_ms <= 0)
+	{
+		return;
+	}
+
+	auto sent_bytes = _sent_bytes.load(std::memory_order_relaxed);
+	uint64_t sending_bitrate = (sent_bytes - _last_report_sent_bytes) * 8 * 1000 / elapsed_ms;
+
+	_last_report_time = now;
+	_last_report_sent_bytes = sent_bytes;
+
+	_sending_bitrate = sending_bitrate;
+	_fraction_lost = fraction_lost;
+	_jitter = jitter;
+	if(rtt_ms >= 0)
+	{
+		_rtt_ms = rtt_ms;
+	}
+
+	double loss = fraction_lost / 256.0;
+
+	if(_loss_based_bitrate == 0)
+	{
+		// The first report, start from what we are sending
+		_loss_based_bitrate = sending_bitrate;
+	}
+	else if(loss < BANDWIDTH_ESTIMATOR_LOW_LOSS)
+	{
+		auto increased = static_cast<uint64_t>(_loss_based_bitrate * BANDWIDTH_ESTIMATOR_INCREASE_FACTOR);
+		auto limit = static_cast<uint64_t>(sending_bitrate * BANDWIDTH_ESTIMATOR_MAX_SENDING_FACTOR);
+
+		// Don't decrease it only because the sender has sent less (e.g. a still image)
+		_loss_based_bitrate = std::max(_loss_based_bitrate, std::min(increased, limit));
+	}
+	else if(loss > BANDWIDTH_ESTIMATOR_HIGH_LOSS)
+	{
+		_loss_based_bitrate = std::max<uint64_t>(_loss_based_bitrate * (1.0 - (0.5 * loss)), BANDWIDTH_ESTIMATOR_MIN_BITRATE);
+	}
+	// Otherwise, the estimate is kept
+
+	UpdateEstimate();
+}
+
+void BandwidthEstimator::OnRemb(uint64_t bitrate)
+{
+	_remb_bitrate = bitrate;
+
+	UpdateEstimate();
+}
+
+void BandwidthEstimator::UpdateEstimate()
+{
+	uint64_t estimate = _loss_based_bitrate;
+
+	if(_remb_bitrate > 0)
+	{
+		estimate = (estimate == 0) ? _remb_bitrate : std::min(estimate, _remb_bitrate);
+	}
+
+	if(estimate == 0)
+	{
+		// Nothing has been sent yet
+		return;
+	}
+
+	_estimated_bitrate = std::max<uint64_t>(estimate, BANDWIDTH_ESTIMATOR_MIN_BITRATE);
+}
+
+uint64_t BandwidthEstimator::GetEstimatedBitrate() const
+{
+	return _estimated_bitrate;
+}
+
+uint64_t BandwidthEstimator::GetSendingBitrate() const
+{
+	return _sending_bitrate;
+}
+
+double BandwidthEstimator::GetLossRate() const
+{
+	return _fraction_lost / 256.0;
+}
+
+uint32_t BandwidthEstimator::GetJitter() const
+{
+	return _jitter;
+}
+
+int64_t BandwidthEstimator::GetRttMs() const
+{
+	return _rtt_ms;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <base/ovlibrary/ovlibrary.h>
+
+// Below this fraction lost, the estimate is increased (GCC loss-based controller)
+#define BANDWIDTH_ESTIMATOR_LOW_LOSS			0.02
+// Above this fraction lost, the estimate is decreased in proportion to the loss
+#define BANDWIDTH_ESTIMATOR_HIGH_LOSS			0.10
+// How much the estimate is increased per receiver report while there is no loss
+#define BANDWIDTH_ESTIMATOR_INCREASE_FACTOR		1.05
+// The estimate is not increased above (sending bitrate * this), because the unused bandwidth is not verified.
+// It is high enough for a session to move up to the next rendition, which probes the bandwidth.
+#define BANDWIDTH_ESTIMATOR_MAX_SENDING_FACTOR	3.0
+#define BANDWIDTH_ESTIMATOR_MIN_BITRATE			(50 * 1000)
+
+// Estimates the available bandwidth of a session from the feedback of the peer.
+//
+// The loss-based controller of Google Congestion Control (draft-ietf-rmcat-gcc) is used for the receiver reports,
+// and the estimate is limited by REMB if the peer sends it.
+// OnPacketSent() is called by the sending thread, the others are called by the receiving thread,
+// and the results can be read by any thread.
+class BandwidthEstimator
+{
+public:
+	BandwidthEstimator();
+
+	void OnPacketSent(size_t bytes);
+
+	// fraction_lost: the highest fraction lost (1/256) of the report blocks
+	// rtt_ms: -1 if unknown
+	void OnReceiverReport(uint8_t fraction_lost, uint32_t jitter, int64_t rtt_ms);
+	void OnRemb(uint64_t bitrate);
+
+	// bps, 0 if it is not estimated yet
+	uint64_t GetEstimatedBitrate() const;
+	// bps, measured between the last two receiver reports
+	uint64_t GetSendingBitrate() const;
+	// 0.0 ~ 1.0
+	double GetLossRate() const;
+	// RTP timestamp units
+	uint32_t GetJitter() const;
+	// -1 if unknown
+	int64_t GetRttMs() const;
+
+private:
+	void UpdateEstimate();
+
+	std::atomic<uint64_t> _sent_bytes{0};
+
+	// Used by the receiving thread only
+	std::chrono::steady_clock::time_point _last_report_time;
+	uint64_t _last_report_sent_bytes = 0;
+	uint64_t _loss_based_bitrate = 0;
+	uint64_t _remb_bitrate = 0;
+
+	std::atomic<uint64_t> _estimated_bitrate{0};
+	std::atomic<uint64_t> _sending_bitrate{0};
+	std::atomic<uint8_t> _fraction_lost{0};
+	std::atomic<uint32_t> _jitter{0};
+	std::atomic<int64_t> _rtt_ms{-1};
+};
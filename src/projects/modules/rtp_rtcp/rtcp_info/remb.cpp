@@ -0,0 +1,81 @@
+#include "remb.h"
+#include "rtcp_private.h"
+#include <base/ovlibrary/byte_io.h>
+
+// Receiver Estimated Max Bitrate (draft-alvestrand-rmcat-remb).
+//
+//    0                   1                   2                   3
+//    0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |V=2|P| FMT=15  |   PT=206      |             length            |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 0 |                  SSRC of packet sender                        |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 4 |                       Unused = 0                              |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 8 |  Unique identifier 'R' 'E' 'M' 'B'                            |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//12 |  Num SSRC     | BR Exp    |  BR Mantissa                      |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//16 |   SSRC feedback                                               |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   :  ...                                                          :
+
+bool REMB::IsREMB(const RtcpPacket &packet)
+{
+	if(packet.GetType() != RtcpPacketType::PSFB || packet.GetFMT() != static_cast<uint8_t>(PSFBFMT::AFB))
+	{
+		return false;
+	}
+
+	if(packet.GetPayloadSize() < 16)
+	{
+		return false;
+	}
+
+	return ::memcmp(&packet.GetPayload()[8], "REMB", 4) == 0;
+}
+
+bool REMB::Parse(const RtcpPacket &packet)
+{
+	const uint8_t *payload = packet.GetPayload();
+	size_t payload_size = packet.GetPayloadSize();
+
+	if(IsREMB(packet) == false)
+	{
+		logtd("Payload is not REMB");
+		return false;
+	}
+
+	_src_ssrc = ByteReader<uint32_t>::ReadBigEndian(&payload[0]);
+
+	uint8_t ssrc_count = payload[12];
+	uint8_t exponent = payload[13] >> 2;
+	uint32_t mantissa = ByteReader<uint32_t, 3>::ReadBigEndian(&payload[13]) & 0x3FFFF;
+
+	_bitrate = static_cast<uint64_t>(mantissa) << exponent;
+
+	if(payload_size < static_cast<size_t>(16 + ssrc_count * 4))
+	{
+		logtd("Payload is too small to parse REMB");
+		return false;
+	}
+
+	for(size_t i = 0; i < ssrc_count; i++)
+	{
+		_ssrcs.push_back(ByteReader<uint32_t>::ReadBigEndian(&payload[16 + (i * 4)]));
+	}
+
+	return true;
+}
+
+// RtcpInfo must provide raw data
+std::shared_ptr<ov::Data> REMB::GetData() const
+{
+	return nullptr;
+}
+
+void REMB::DebugPrint()
+{
+	logtd("REMB >> sender ssrc(%u) bitrate(%llu) ssrc count(%zu)", _src_ssrc, _bitrate, _ssrcs.size());
+}
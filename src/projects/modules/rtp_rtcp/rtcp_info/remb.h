@@ -0,0 +1,42 @@
+#pragma once
+#include "base/ovlibrary/ovlibrary.h"
+#include "rtcp_info.h"
+#include "../rtcp_packet.h"
+
+// Receiver Estimated Max Bitrate (draft-alvestrand-rmcat-remb)
+class REMB : public RtcpInfo
+{
+public:
+	// REMB is one of the Application Layer Feedback messages, so it is identified by "REMB" in FCI
+	static bool IsREMB(const RtcpPacket &packet);
+
+	///////////////////////////////////////////
+	// Implement RtcpInfo virtual functions
+	///////////////////////////////////////////
+	bool Parse(const RtcpPacket &packet) override;
+	// RtcpInfo must provide raw data
+	std::shared_ptr<ov::Data> GetData() const override;
+	void DebugPrint() override;
+
+	// RtcpInfo must provide packet type
+	RtcpPacketType GetPacketType() const override
+	{
+		return RtcpPacketType::PSFB;
+	}
+
+	// If the packet type is one of the feedback messages (205, 206) child must provide fmt(format)
+	uint8_t GetFmt() const override
+	{
+		return static_cast<uint8_t>(PSFBFMT::AFB);
+	}
+
+	uint32_t GetSrcSsrc(){return _src_ssrc;}
+	// bps
+	uint64_t GetBitrate(){return _bitrate;}
+	const std::vector<uint32_t> &GetSsrcs(){return _ssrcs;}
+
+private:
+	uint32_t	_src_ssrc = 0;
+	uint64_t	_bitrate = 0;
+	std::vector<uint32_t> _ssrcs;
+};
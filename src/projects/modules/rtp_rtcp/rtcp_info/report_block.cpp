@@ -41,6 +41,30 @@ double RtcpPacket::DelayCalculation(uint32_t lsr, uint32_t dlsr)
 }
 */
 
+int64_t ReportBlock::GetRttMs()
+{
+	if(_last_sr == 0)
+	{
+		return -1;
+	}
+
+	uint32_t msw = 0;
+	uint32_t lsw = 0;
+
+	ov::Clock::GetNtpTime(msw, lsw);
+
+	// Middle 32 bits of the NTP timestamp, in 1/65536 seconds
+	uint32_t now = ((msw & 0xFFFF) << 16) | (lsw >> 16);
+	uint32_t elapsed = now - _last_sr;
+
+	if(elapsed <= _delay_since_last_sr)
+	{
+		return 0;
+	}
+
+	return (static_cast<int64_t>(elapsed - _delay_since_last_sr) * 1000) >> 16;
+}
+
 void ReportBlock::Print()
 {
 	logtd("Receiver Report >> source ssrc(%u) fraction lost(%u) cumulative lost(%u) highest sequence(%u) jitter(%u) last sr(%u) delay(%u)",
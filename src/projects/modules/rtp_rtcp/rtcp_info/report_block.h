@@ -16,6 +16,9 @@ public:
 	uint32_t	GetLastSr(){return _last_sr;}
 	uint32_t	GetDelaySinceLastSr(){return _delay_since_last_sr;}
 
+	// Round trip time calculated from LSR and DLSR (RFC 3550 6.4.1), -1 if no SR has been received by the peer yet
+	int64_t		GetRttMs();
+
 	void Print();
 
 private:
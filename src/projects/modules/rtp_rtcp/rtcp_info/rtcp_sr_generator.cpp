@@ -9,9 +9,14 @@ RtcpSRGenerator::RtcpSRGenerator(uint32_t ssrc)
 }
 
 void RtcpSRGenerator::AddRTPPacketAndGenerateRtcpSR(const RtpPacket &rtp_packet)
+{
+    AddRTPPacketAndGenerateRtcpSR(rtp_packet.Timestamp(), rtp_packet.PayloadSize());
+}
+
+void RtcpSRGenerator::AddRTPPacketAndGenerateRtcpSR(uint32_t timestamp, size_t payload_size)
 {
     _packet_count ++;
-    _octec_count += rtp_packet.PayloadSize();
+    _octec_count += payload_size;
 
     // RTCP Interval
     // Send RTCP SR twice a second for the first 10 seconds so the player can sync AV. 
@@ -29,7 +34,7 @@ void RtcpSRGenerator::AddRTPPacketAndGenerateRtcpSR(const RtpPacket &rtp_packet)
 		report.SetSenderSsrc(_ssrc);
 		report.SetMsw(msw);
 		report.SetLsw(lsw);
-		report.SetTimestamp(rtp_packet.Timestamp());
+		report.SetTimestamp(timestamp);
 		report.SetPacketCount(_packet_count);
 		report.SetOctetCount(_octec_count);
 
@@ -10,6 +10,8 @@ public:
     RtcpSRGenerator(uint32_t ssrc);
 
 	void AddRTPPacketAndGenerateRtcpSR(const RtpPacket &rtp_packet);
+	// Used when the packet is not parsed into RtpPacket (timestamp and payload size are enough)
+	void AddRTPPacketAndGenerateRtcpSR(uint32_t timestamp, size_t payload_size);
 	bool IsAvailableRtcpSRPacket() const;
 	std::shared_ptr<RtcpPacket>   PopRtcpSRPacket();
 	
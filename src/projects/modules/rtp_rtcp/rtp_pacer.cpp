@@ -0,0 +1,156 @@
+#include "rtp_pacer.h"
+
+#include <algorithm>
+
+#define OV_LOG_TAG "RtpPacer"
+
+RtpPacer::RtpPacer(SendFunction send_function, double multiplier, int max_queue_delay_ms, ov::Executor *executor)
+	: _send_function(std::move(send_function)),
+	  _multiplier(multiplier),
+	  _max_queue_delay_ms(std::max(max_queue_delay_ms, 1)),
+	  _executor(executor)
+{
+	_last_refill_time = std::chrono::steady_clock::now();
+	_window_start_time = _last_refill_time;
+}
+
+void RtpPacer::Enqueue(const std::shared_ptr<const ov::Data> &packet)
+{
+	auto now = std::chrono::steady_clock::now();
+
+	std::lock_guard<std::mutex> lock_guard(_mutex);
+
+	if(_stopped)
+	{
+		return;
+	}
+
+	_queue.push_back({now, packet});
+	_queued_bytes += packet->GetLength();
+
+	_window_bytes += packet->GetLength();
+	auto window_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - _window_start_time).count();
+	if(window_ms >= RTP_PACER_RATE_WINDOW_MS)
+	{
+		auto bitrate = _window_bytes * 8 * 1000 / window_ms;
+
+		// Follows increases at once, so a keyframe is not held back by the bitrate of the previous frames
+		_bitrate = (bitrate > _bitrate) ? bitrate : ((_bitrate + bitrate) / 2);
+		_window_bytes = 0;
+		_window_start_time = now;
+	}
+}
+
+uint64_t RtpPacer::GetPacingBitrate(const std::chrono::steady_clock::time_point &now)
+{
+	auto pacing_bitrate = std::max<uint64_t>(_bitrate * _multiplier, RTP_PACER_MIN_BITRATE);
+
+	if(_queue.empty() == false)
+	{
+		// Raise the rate to send all of the queue before the oldest packet exceeds the limit
+		auto waited_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - _queue.front().enqueued_time).count();
+		auto remaining_ms = std::max<int64_t>(_max_queue_delay_ms - waited_ms, 1);
+
+		pacing_bitrate = std::max<uint64_t>(pacing_bitrate, _queued_bytes * 8 * 1000 / remaining_ms);
+	}
+
+	return pacing_bitrate;
+}
+
+bool RtpPacer::Process()
+{
+	std::lock_guard<std::mutex> send_lock_guard(_send_mutex);
+
+	std::vector<std::shared_ptr<const ov::Data>> packet_list;
+	int next_delay_ms = 0;
+
+	{
+		std::lock_guard<std::mutex> lock_guard(_mutex);
+
+		if(_stopped)
+		{
+			return false;
+		}
+
+		auto now = std::chrono::steady_clock::now();
+		auto pacing_bitrate = GetPacingBitrate(now);
+		double bytes_per_ms = pacing_bitrate / 8.0 / 1000.0;
+
+		// Refill the bucket
+		auto elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(now - _last_refill_time).count();
+		_tokens = std::min(_tokens + (bytes_per_ms * elapsed_us / 1000.0), bytes_per_ms * RTP_PACER_BURST_MS);
+		_last_refill_time = now;
+
+		// A packet can be sent while there is any token, so a packet larger than the bucket is not stuck
+		while((_queue.empty() == false) && (_tokens > 0.0))
+		{
+			auto &packet = _queue.front().data;
+
+			_tokens -= packet->GetLength();
+			_queued_bytes -= packet->GetLength();
+
+			packet_list.push_back(std::move(packet));
+			_queue.pop_front();
+		}
+
+		if((_queue.empty() == false) && (_is_timer_scheduled == false))
+		{
+			// Until the bucket has a token again
+			next_delay_ms = std::max(static_cast<int>((-_tokens / bytes_per_ms) + 1), 1);
+			_is_timer_scheduled = true;
+		}
+	}
+
+	if(next_delay_ms > 0)
+	{
+		ScheduleProcess(next_delay_ms);
+	}
+
+	if(packet_list.empty())
+	{
+		return true;
+	}
+
+	return _send_function(packet_list);
+}
+
+void RtpPacer::ScheduleProcess(int delay_ms)
+{
+	std::weak_ptr<RtpPacer> weak_pacer = GetSharedPtr();
+
+	bool scheduled = ov::TimerWheel::GetInstance()->Schedule(delay_ms, [weak_pacer]() {
+		auto pacer = weak_pacer.lock();
+
+		if(pacer != nullptr)
+		{
+			{
+				std::lock_guard<std::mutex> lock_guard(pacer->_mutex);
+				pacer->_is_timer_scheduled = false;
+			}
+
+			pacer->Process();
+		}
+	}, _executor);
+
+	if(scheduled == false)
+	{
+		std::lock_guard<std::mutex> lock_guard(_mutex);
+		_is_timer_scheduled = false;
+	}
+}
+
+void RtpPacer::Stop()
+{
+	std::lock_guard<std::mutex> lock_guard(_mutex);
+
+	_stopped = true;
+	_queue.clear();
+	_queued_bytes = 0;
+}
+
+size_t RtpPacer::GetQueuedCount()
+{
+	std::lock_guard<std::mutex> lock_guard(_mutex);
+
+	return _queue.size();
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+#include <base/ovlibrary/ovlibrary.h>
+
+// Packets are sent at (bitrate of the session * multiplier), like the pacer of libwebrtc
+#define RTP_PACER_DEFAULT_MULTIPLIER		2.5
+// If packets wait longer than this, the pacing rate is raised to send them in time
+#define RTP_PACER_DEFAULT_MAX_QUEUE_DELAY_MS	100
+// Lower limit of the pacing rate, so audio and the first frames are not delayed
+#define RTP_PACER_MIN_BITRATE				(500 * 1000)
+// Bytes of this duration can be sent at once (size of the token bucket)
+#define RTP_PACER_BURST_MS					5
+// The bitrate of the session is measured over this window
+#define RTP_PACER_RATE_WINDOW_MS			500
+
+// Smooths the packets of a session (e.g. the 150 packets of a keyframe) with a token bucket,
+// so they don't leave at line rate and overflow the shallow buffers of the routers on the path.
+//
+// Enqueue() queues the packets, and Process() sends as many as the bucket allows.
+// The rest are sent by the shared timer wheel (ov::TimerWheel), so a pacer doesn't need a thread.
+class RtpPacer : public ov::EnableSharedFromThis<RtpPacer>
+{
+public:
+	using SendFunction = std::function<bool(const std::vector<std::shared_ptr<const ov::Data>> &packet_list)>;
+
+	// multiplier: pacing rate / bitrate of the session
+	// executor: where the timer sends the packets (nullptr means the shared executor)
+	RtpPacer(SendFunction send_function, double multiplier, int max_queue_delay_ms, ov::Executor *executor = nullptr);
+
+	void Enqueue(const std::shared_ptr<const ov::Data> &packet);
+	// Sends the packets the bucket allows, and schedules the timer for the rest
+	bool Process();
+
+	// The queued packets are discarded
+	void Stop();
+
+	size_t GetQueuedCount();
+
+private:
+	struct QueuedPacket
+	{
+		std::chrono::steady_clock::time_point enqueued_time;
+		std::shared_ptr<const ov::Data> data;
+	};
+
+	// Must be called with _mutex
+	uint64_t GetPacingBitrate(const std::chrono::steady_clock::time_point &now);
+	void ScheduleProcess(int delay_ms);
+
+	SendFunction _send_function;
+	double _multiplier;
+	int _max_queue_delay_ms;
+	ov::Executor *_executor;
+
+	std::mutex _mutex;
+	std::deque<QueuedPacket> _queue;
+	size_t _queued_bytes = 0;
+
+	// Bytes that can be sent now (negative if the last packet was larger than the bucket)
+	double _tokens = 0.0;
+	std::chrono::steady_clock::time_point _last_refill_time;
+
+	// Bitrate of the session, measured from the enqueued packets
+	std::chrono::steady_clock::time_point _window_start_time;
+	uint64_t _window_bytes = 0;
+	uint64_t _bitrate = 0;
+
+	bool _is_timer_scheduled = false;
+	bool _stopped = false;
+
+	// Packets must be sent in order, but Process() can be called by the sender and the timer at the same time
+	std::mutex _send_mutex;
+};
@@ -0,0 +1,35 @@
+#include "rtp_packet_history.h"
+#include "rtp_packet.h"
+
+#include <base/ovlibrary/byte_io.h>
+
+static_assert((RTP_PACKET_HISTORY_SIZE & (RTP_PACKET_HISTORY_SIZE - 1)) == 0, "RTP_PACKET_HISTORY_SIZE must be a power of 2");
+
+RtpPacketHistory::RtpPacketHistory()
+	: _slots(RTP_PACKET_HISTORY_SIZE)
+{
+}
+
+void RtpPacketHistory::Store(uint16_t sequence_number, const std::shared_ptr<const ov::Data> &packet)
+{
+	// The slots are never resized, so only the slot itself needs to be updated atomically
+	std::atomic_store_explicit(&_slots[sequence_number & (RTP_PACKET_HISTORY_SIZE - 1)], packet, std::memory_order_release);
+}
+
+std::shared_ptr<const ov::Data> RtpPacketHistory::Get(uint16_t sequence_number) const
+{
+	auto packet = std::atomic_load_explicit(&_slots[sequence_number & (RTP_PACKET_HISTORY_SIZE - 1)], std::memory_order_acquire);
+
+	if((packet == nullptr) || (packet->GetLength() < FIXED_HEADER_SIZE))
+	{
+		return nullptr;
+	}
+
+	// The slot may have been overwritten by a newer packet
+	if(ByteReader<uint16_t>::ReadBigEndian(packet->GetDataAs<uint8_t>() + 2) != sequence_number)
+	{
+		return nullptr;
+	}
+
+	return packet;
+}
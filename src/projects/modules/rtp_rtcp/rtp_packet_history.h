@@ -0,0 +1,30 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <base/ovlibrary/ovlibrary.h>
+
+// Number of packets kept for retransmission (must be a power of 2).
+// At 2 Mbps with 1200 byte packets, it is about 4 seconds of video.
+#define RTP_PACKET_HISTORY_SIZE		1024
+
+// Keeps the RTP packets recently sent on a stream, so the lost ones can be retransmitted when NACK is received.
+//
+// A history is shared by all sessions of the stream. The packets are stored before SRTP protection,
+// since each session protects them with its own key.
+// Store() must be called by one thread (the packetizer), and Get() can be called by any thread without locking.
+class RtpPacketHistory
+{
+public:
+	RtpPacketHistory();
+
+	// packet must not be modified after it is stored
+	void Store(uint16_t sequence_number, const std::shared_ptr<const ov::Data> &packet);
+
+	// Returns nullptr if the packet is too old (it has been overwritten) or has never been sent
+	std::shared_ptr<const ov::Data> Get(uint16_t sequence_number) const;
+
+private:
+	std::vector<std::shared_ptr<const ov::Data>> _slots;
+};
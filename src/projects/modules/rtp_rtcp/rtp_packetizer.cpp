@@ -59,6 +59,11 @@ void RtpPacketizer::SetUlpfec(uint8_t red_payload_type, uint8_t ulpfec_payload_t
 	_ulpfec_payload_type = ulpfec_payload_type;
 }
 
+void RtpPacketizer::SetUlpfecProtectionLevel(UlpfecProtectionLevel level)
+{
+	_ulpfec_generator.SetProtectionLevel(level);
+}
+
 bool RtpPacketizer::Packetize(FrameType frame_type,
                                    uint32_t timestamp,
                                    const uint8_t *payload_data,
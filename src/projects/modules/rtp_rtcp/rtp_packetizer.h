@@ -15,6 +15,8 @@ public:
 	void SetVideoCodec(common::MediaCodecId codec_type);
 	void SetAudioCodec(common::MediaCodecId codec_type);
 	void SetUlpfec(uint8_t _red_payload_type, uint8_t _ulpfec_payload_type);
+	// Can be called by the other threads (applied from the next frame)
+	void SetUlpfecProtectionLevel(UlpfecProtectionLevel level);
 	void SetPayloadType(uint8_t payload_type);
 	void SetSSRC(uint32_t ssrc);
 	void SetCsrcs(const std::vector<uint32_t> &csrcs);
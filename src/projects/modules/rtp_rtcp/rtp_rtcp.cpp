@@ -2,8 +2,11 @@
 #include "publishers/webrtc/rtc_application.h"
 #include "publishers/webrtc/rtc_stream.h"
 #include "rtcp_receiver.h"
+#include "modules/dtls_srtp/srtp_transport.h"
 #include <base/ovlibrary/byte_io.h>
 
+#include <algorithm>
+
 #define OV_LOG_TAG "RtpRtcp"
 
 RtpRtcp::RtpRtcp(uint32_t id, std::shared_ptr<pub::Session> session, const std::vector<uint32_t> &ssrc_list)
@@ -16,12 +19,118 @@ RtpRtcp::RtpRtcp(uint32_t id, std::shared_ptr<pub::Session> session, const std::
     }
 }
 
+void RtpRtcp::SetRetransmission(uint32_t media_ssrc, const std::shared_ptr<RtpPacketHistory> &history, uint8_t rtx_payload_type, uint32_t rtx_ssrc,
+								uint16_t sequence_number_offset, int32_t start_sequence_number)
+{
+	if(history == nullptr)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock_guard(_retransmission_mutex);
+
+	auto item = _retransmissions.find(media_ssrc);
+	if(item == _retransmissions.end())
+	{
+		item = _retransmissions.emplace(media_ssrc, Retransmission()).first;
+		// The RTX stream continues when the history is changed
+		item->second.rtx_sequence_number = static_cast<uint16_t>(ov::Random::GenerateUInt32());
+	}
+
+	auto &retransmission = item->second;
+
+	retransmission.history = history;
+	retransmission.rtx_payload_type = rtx_payload_type;
+	retransmission.rtx_ssrc = rtx_ssrc;
+	retransmission.sequence_number_offset = sequence_number_offset;
+	retransmission.start_sequence_number = start_sequence_number;
+	retransmission.offset_changes.clear();
+}
+
+void RtpRtcp::ChangeSequenceNumberOffset(uint32_t media_ssrc, uint16_t sequence_number_offset, uint16_t start_sequence_number)
+{
+	std::lock_guard<std::mutex> lock_guard(_retransmission_mutex);
+
+	auto item = _retransmissions.find(media_ssrc);
+	if(item == _retransmissions.end())
+	{
+		return;
+	}
+
+	auto &changes = item->second.offset_changes;
+
+	if((changes.empty() == false) && (changes.back().first == start_sequence_number))
+	{
+		// Consecutive packets are skipped
+		changes.back().second = sequence_number_offset;
+		return;
+	}
+
+	changes.emplace_back(start_sequence_number, sequence_number_offset);
+
+	// The changes must span less than a half of the sequence numbers, so they can be compared after a wraparound
+	while((changes.size() > RTP_RTCP_MAX_SEQUENCE_NUMBER_OFFSET_CHANGES) ||
+		  (static_cast<uint16_t>(start_sequence_number - changes.front().first) >= 0x8000))
+	{
+		// The packets before the oldest change are not retransmitted anymore
+		auto &retransmission = item->second;
+		auto &oldest_change = changes.front();
+
+		retransmission.start_sequence_number = oldest_change.first;
+		retransmission.sequence_number_offset = oldest_change.second;
+
+		changes.pop_front();
+	}
+}
+
+bool RtpRtcp::SendRtpToLowerNode(const std::shared_ptr<pub::SessionNode> &node, const std::shared_ptr<const ov::Data> &packet, const RtpPacketRewrite *rewrite)
+{
+	if(rewrite == nullptr)
+	{
+		return node->SendData(pub::SessionNodeType::Rtp, packet);
+	}
+
+	// Lower Node is SRTP, which copies the packet to protect it anyway
+	return std::static_pointer_cast<SrtpTransport>(node)->SendRtpPacket(packet, *rewrite);
+}
+
+uint16_t RtpRtcp::GetSequenceNumberOffset(const Retransmission &retransmission, uint16_t sequence_number) const
+{
+	auto &changes = retransmission.offset_changes;
+	if(changes.empty())
+	{
+		return retransmission.sequence_number_offset;
+	}
+
+	// The changes span less than a half of the sequence numbers, so they are sorted by the distance from the oldest one
+	auto oldest = changes.front().first;
+	auto distance = static_cast<uint16_t>(sequence_number - oldest);
+	if(distance >= 0x8000)
+	{
+		// Before the oldest change
+		return retransmission.sequence_number_offset;
+	}
+
+	auto change = std::upper_bound(changes.begin(), changes.end(), distance,
+								   [oldest](uint16_t value, const std::pair<uint16_t, uint16_t> &item) {
+									   return value < static_cast<uint16_t>(item.first - oldest);
+								   });
+
+	// There is at least one change (the oldest one) which is not after sequence_number
+	return std::prev(change)->second;
+}
+
+const BandwidthEstimator &RtpRtcp::GetBandwidthEstimator() const
+{
+	return _bandwidth_estimator;
+}
+
 RtpRtcp::~RtpRtcp()
 {
     _rtcp_sr_generators.clear();
 }
 
-bool RtpRtcp::SendOutgoingData(const std::shared_ptr<ov::Data> &packet)
+bool RtpRtcp::SendOutgoingData(const std::shared_ptr<const ov::Data> &packet, const RtpPacketRewrite *rewrite)
 {
 	// Lower Node is SRTP
 	auto node = GetLowerNode();
@@ -30,44 +139,201 @@ bool RtpRtcp::SendOutgoingData(const std::shared_ptr<ov::Data> &packet)
 		return false;
 	}
 
-    RtpPacket rtp_packet(packet);
+    // The packet is shared with other sessions, so only the fields needed are read from the header
+    // (RtpPacket takes a writable buffer, which would copy the payload)
+    if(packet->GetLength() < FIXED_HEADER_SIZE)
+    {
+        return false;
+    }
 
-    // Parsing error
-	if(rtp_packet.Buffer() == nullptr)
+    auto buffer = packet->GetDataAs<uint8_t>();
+    if((buffer[0] >> 6) != RTP_VERSION)
     {
         return false;
     }
 
-    if(_rtcp_sr_generators.find(rtp_packet.Ssrc()) == _rtcp_sr_generators.end())
+    auto timestamp = ByteReader<uint32_t>::ReadBigEndian(&buffer[4]);
+    auto ssrc = ByteReader<uint32_t>::ReadBigEndian(&buffer[8]);
+
+    auto item = _rtcp_sr_generators.find(ssrc);
+    if(item == _rtcp_sr_generators.end())
     {
         return false;
     }
     
-    auto rtcp_sr_generator = _rtcp_sr_generators[rtp_packet.Ssrc()];
+    auto &rtcp_sr_generator = item->second;
     
-    rtcp_sr_generator->AddRTPPacketAndGenerateRtcpSR(rtp_packet);
+    rtcp_sr_generator->AddRTPPacketAndGenerateRtcpSR(timestamp, packet->GetLength() - FIXED_HEADER_SIZE);
     if(rtcp_sr_generator->IsAvailableRtcpSRPacket())
     {
         auto rtcp_sr_packet = rtcp_sr_generator->PopRtcpSRPacket();
         if(!node->SendData(pub::SessionNodeType::Rtcp, rtcp_sr_packet->GetData()))
         {
-            logd("RTCP","Send RTCP failed : ssrc(%u)", rtp_packet.Ssrc());
+            logd("RTCP","Send RTCP failed : ssrc(%u)", ssrc);
         }
 		else
 		{
-			logd("RTCP", "Send RTCP succeed : ssrc(%u) length(%d)", rtp_packet.Ssrc(), rtcp_sr_packet->GetData()->GetLength());
+			logd("RTCP", "Send RTCP succeed : ssrc(%u) length(%d)", ssrc, rtcp_sr_packet->GetData()->GetLength());
 		}
     }
 
-	if(!node->SendData(pub::SessionNodeType::Rtp, packet))
+	if(!SendRtpToLowerNode(node, packet, rewrite))
     {
 		return false;
     }
 
+	_bandwidth_estimator.OnPacketSent(packet->GetLength());
+
+	if(_retransmission_budget.load(std::memory_order_relaxed) < RTP_RTCP_RETRANSMISSION_BUDGET_MAX_BYTES)
+	{
+		_retransmission_budget.fetch_add(packet->GetLength() * RTP_RTCP_RETRANSMISSION_BUDGET_PERCENT / 100, std::memory_order_relaxed);
+	}
+
 	return true;
 }
 
-bool RtpRtcp::SendData(pub::SessionNodeType from_node, const std::shared_ptr<ov::Data> &data)
+void RtpRtcp::OnReceiverReport(const std::shared_ptr<ReceiverReport> &receiver_report)
+{
+	if(receiver_report->GetReportBlockCount() == 0)
+	{
+		return;
+	}
+
+	// Audio and video are reported in separate blocks, the worst one is used
+	uint8_t fraction_lost = 0;
+	uint32_t jitter = 0;
+	int64_t rtt_ms = -1;
+
+	for(size_t i = 0; i < receiver_report->GetReportBlockCount(); i++)
+	{
+		auto report_block = receiver_report->GetReportBlock(i);
+
+		if(_rtcp_sr_generators.find(report_block->GetSrcSsrc()) == _rtcp_sr_generators.end())
+		{
+			// Not sent by this session (e.g. RTX)
+			continue;
+		}
+
+		fraction_lost = std::max(fraction_lost, report_block->GetFractionLost());
+		jitter = std::max(jitter, report_block->GetJitter());
+		rtt_ms = std::max(rtt_ms, report_block->GetRttMs());
+	}
+
+	_bandwidth_estimator.OnReceiverReport(fraction_lost, jitter, rtt_ms);
+}
+
+void RtpRtcp::OnNack(const std::shared_ptr<NACK> &nack)
+{
+	std::lock_guard<std::mutex> lock_guard(_retransmission_mutex);
+
+	auto item = _retransmissions.find(nack->GetMediaSsrc());
+	if(item == _retransmissions.end())
+	{
+		return;
+	}
+
+	auto node = GetLowerNode();
+	if(!node)
+	{
+		return;
+	}
+
+	auto &retransmission = item->second;
+	size_t retransmitted_count = 0;
+	size_t dropped_count = 0;
+
+	for(size_t i = 0; i < nack->GetLostIdCount(); i++)
+	{
+		auto lost_sequence_number = nack->GetLostId(i);
+
+		if((retransmission.start_sequence_number >= 0) &&
+		   (static_cast<uint16_t>(lost_sequence_number - retransmission.start_sequence_number) >= 0x8000))
+		{
+			// Sent before the history was changed
+			dropped_count++;
+			continue;
+		}
+
+		auto sequence_number_offset = GetSequenceNumberOffset(retransmission, lost_sequence_number);
+		auto packet = retransmission.history->Get(lost_sequence_number - sequence_number_offset);
+		if(packet == nullptr)
+		{
+			// Too old
+			dropped_count++;
+			continue;
+		}
+
+		if(_retransmission_budget.load(std::memory_order_relaxed) < static_cast<int64_t>(packet->GetLength()))
+		{
+			// The peer is losing more than we can afford to resend, the rest will be recovered by FEC or the next keyframe
+			dropped_count += nack->GetLostIdCount() - i;
+			break;
+		}
+
+		std::shared_ptr<const ov::Data> retransmission_packet = packet;
+		RtpPacketRewrite rewrite;
+		if(retransmission.rtx_payload_type != 0)
+		{
+			retransmission_packet = MakeRtxPacket(packet, lost_sequence_number, retransmission);
+			if(retransmission_packet == nullptr)
+			{
+				dropped_count++;
+				continue;
+			}
+		}
+		else
+		{
+			// The packet of the history has the sequence number of the stream
+			rewrite.sequence_number_offset = sequence_number_offset;
+		}
+
+		_retransmission_budget.fetch_sub(retransmission_packet->GetLength(), std::memory_order_relaxed);
+
+		if(SendRtpToLowerNode(node, retransmission_packet, rewrite.IsEmpty() ? nullptr : &rewrite))
+		{
+			_bandwidth_estimator.OnPacketSent(retransmission_packet->GetLength());
+			retransmitted_count++;
+		}
+	}
+
+	logtd("NACK : ssrc(%u) lost(%zu) retransmitted(%zu) dropped(%zu)", nack->GetMediaSsrc(), nack->GetLostIdCount(), retransmitted_count, dropped_count);
+}
+
+std::shared_ptr<ov::Data> RtpRtcp::MakeRtxPacket(const std::shared_ptr<const ov::Data> &packet, uint16_t original_sequence_number, Retransmission &retransmission)
+{
+	auto buffer = packet->GetDataAs<uint8_t>();
+	auto length = packet->GetLength();
+
+	// CSRCs and header extension belong to the header
+	size_t header_size = FIXED_HEADER_SIZE + (buffer[0] & 0x0F) * 4;
+	if((buffer[0] & 0x10) && (header_size + 4 <= length))
+	{
+		header_size += 4 + ByteReader<uint16_t>::ReadBigEndian(&buffer[header_size + 2]) * 4;
+	}
+
+	if(header_size > length)
+	{
+		return nullptr;
+	}
+
+	auto rtx_packet = std::make_shared<ov::Data>(length + 2);
+	rtx_packet->SetLength(length + 2);
+
+	auto rtx_buffer = rtx_packet->GetWritableDataAs<uint8_t>();
+
+	::memcpy(rtx_buffer, buffer, header_size);
+	rtx_buffer[1] = (buffer[1] & 0x80) | (retransmission.rtx_payload_type & 0x7F);
+	ByteWriter<uint16_t>::WriteBigEndian(&rtx_buffer[2], retransmission.rtx_sequence_number++);
+	ByteWriter<uint32_t>::WriteBigEndian(&rtx_buffer[8], retransmission.rtx_ssrc);
+
+	// OSN(Original Sequence Number), which is the one the peer has lost
+	ByteWriter<uint16_t>::WriteBigEndian(&rtx_buffer[header_size], original_sequence_number);
+	::memcpy(&rtx_buffer[header_size + 2], &buffer[header_size], length - header_size);
+
+	return rtx_packet;
+}
+
+bool RtpRtcp::SendData(pub::SessionNodeType from_node, const std::shared_ptr<const ov::Data> &data)
 {
 	return true;
 }
@@ -97,13 +363,20 @@ bool RtpRtcp::OnDataReceived(pub::SessionNodeType from_node, const std::shared_p
 
 		if(info->GetPacketType() == RtcpPacketType::RR)
 		{
-			// Process
+			OnReceiverReport(std::static_pointer_cast<ReceiverReport>(info));
+		}
+		else if(info->GetPacketType() == RtcpPacketType::PSFB)
+		{
+			if(info->GetFmt() == static_cast<uint8_t>(PSFBFMT::AFB))
+			{
+				_bandwidth_estimator.OnRemb(std::static_pointer_cast<REMB>(info)->GetBitrate());
+			}
 		}
 		else if(info->GetPacketType() == RtcpPacketType::RTPFB)
 		{
 			if(info->GetFmt() == static_cast<uint8_t>(RTPFBFMT::NACK))
 			{
-				// Process
+				OnNack(std::static_pointer_cast<NACK>(info));
 			}
 		}
 
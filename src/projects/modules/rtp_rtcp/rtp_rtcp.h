@@ -3,7 +3,21 @@
 #include "rtp_rtcp_defines.h"
 #include "rtp_packetizer.h"
 #include "base/publisher/session_node.h"
+#include "rtp_packet_history.h"
+#include "bandwidth_estimator.h"
 #include "rtcp_info/rtcp_sr_generator.h"
+#include "rtcp_info/nack.h"
+#include "rtcp_info/receiver_report.h"
+#include "rtcp_info/remb.h"
+
+#include <deque>
+
+// Retransmissions can use up to this percent of the bytes sent (RFC 4588 recommends to limit them)
+#define RTP_RTCP_RETRANSMISSION_BUDGET_PERCENT		25
+// Maximum bytes that can be retransmitted at once, even if the budget has been saved for a long time
+#define RTP_RTCP_RETRANSMISSION_BUDGET_MAX_BYTES	(256 * 1024)
+// Changes of the sequence number offset which are kept to find the packets of NACK (older ones can't be retransmitted)
+#define RTP_RTCP_MAX_SEQUENCE_NUMBER_OFFSET_CHANGES	1024
 
 class RtpRtcp : public pub::SessionNode
 {
@@ -12,18 +26,64 @@ public:
 	~RtpRtcp() override;
 
 	// 패킷을 전송한다. 성능을 위해 상위에서 Packetizing을 하는 경우 사용한다.
-	bool SendOutgoingData(const std::shared_ptr<ov::Data> &packet);
+	// If rewrite is given, the sequence numbers are rewritten in the copy which SRTP protects (packet is not modified)
+	bool SendOutgoingData(const std::shared_ptr<const ov::Data> &packet, const RtpPacketRewrite *rewrite = nullptr);
+
+	// Lost packets of media_ssrc reported by NACK are retransmitted from the history.
+	// If rtx_payload_type is not 0, they are sent as RTX packets (RFC 4588) with rtx_ssrc.
+	// If the session rewrites the sequence numbers of the history (e.g. after switching to the other rendition),
+	// sequence_number_offset is added to them, and the packets sent before start_sequence_number are not retransmitted.
+	void SetRetransmission(uint32_t media_ssrc, const std::shared_ptr<RtpPacketHistory> &history, uint8_t rtx_payload_type, uint32_t rtx_ssrc,
+						   uint16_t sequence_number_offset = 0, int32_t start_sequence_number = -1);
+	// The session changes the offset from start_sequence_number (e.g. when it doesn't send some packets of the history).
+	// The packets sent before that are still retransmitted with the previous offset.
+	// start_sequence_number must not decrease (the changes are looked up by binary search).
+	void ChangeSequenceNumberOffset(uint32_t media_ssrc, uint16_t sequence_number_offset, uint16_t start_sequence_number);
+
+	// Estimated by the receiver reports and REMB of the peer
+	const BandwidthEstimator &GetBandwidthEstimator() const;
 
 	// Implement SessionNode Interface
 	// RtpRtcp는 최상위 노드로 SendData를 사용하지 않는다. SendOutgoingData를 사용한다.
-	bool SendData(pub::SessionNodeType from_node, const std::shared_ptr<ov::Data> &data) override;
+	bool SendData(pub::SessionNodeType from_node, const std::shared_ptr<const ov::Data> &data) override;
 	// Lower Node(SRTP)로부터 데이터를 받는다.
 	bool OnDataReceived(pub::SessionNodeType from_node, const std::shared_ptr<const ov::Data> &data) override;
 	
 private:
+	struct Retransmission
+	{
+		std::shared_ptr<RtpPacketHistory> history;
+		uint8_t rtx_payload_type = 0;
+		uint32_t rtx_ssrc = 0;
+		uint16_t rtx_sequence_number = 0;
+		uint16_t sequence_number_offset = 0;
+		int32_t start_sequence_number = -1;
+		// Changed offsets after start_sequence_number (first: start sequence number, second: offset), from the oldest
+		std::deque<std::pair<uint16_t, uint16_t>> offset_changes;
+	};
+
+	// Returns the offset which was used when sequence_number was sent
+	uint16_t GetSequenceNumberOffset(const Retransmission &retransmission, uint16_t sequence_number) const;
+
+	void OnReceiverReport(const std::shared_ptr<ReceiverReport> &receiver_report);
+	void OnNack(const std::shared_ptr<NACK> &nack);
+	bool SendRtpToLowerNode(const std::shared_ptr<pub::SessionNode> &node, const std::shared_ptr<const ov::Data> &packet, const RtpPacketRewrite *rewrite);
+	// Makes an RTX packet: the header of the original packet with RTX payload type/SSRC/sequence number,
+	// followed by the original sequence number(OSN) and payload
+	std::shared_ptr<ov::Data> MakeRtxPacket(const std::shared_ptr<const ov::Data> &packet, uint16_t original_sequence_number, Retransmission &retransmission);
+
     time_t _first_receiver_report_time = 0; // 0 - not received RR packet
     time_t _last_sender_report_time = 0;
     uint64_t _send_packet_sequence_number = 0;
 
     std::map<uint32_t, std::shared_ptr<RtcpSRGenerator>> _rtcp_sr_generators;
+
+	// Key: media ssrc
+	std::map<uint32_t, Retransmission> _retransmissions;
+	// The session can change the retransmission while NACK is processed
+	std::mutex _retransmission_mutex;
+	// Increased by SendOutgoingData(), and decreased by retransmissions (which run on the other thread)
+	std::atomic<int64_t> _retransmission_budget{0};
+
+	BandwidthEstimator _bandwidth_estimator;
 };
@@ -96,3 +96,21 @@ struct RTPVideoHeader
 	common::MediaCodecId codec;
 	RTPVideoTypeHeader codec_header;
 };
+
+// Sequence numbers which a session rewrites in its own copy of a shared RTP packet
+// (the copy which SrtpTransport makes to protect the packet, so the packet is not cloned for it)
+struct RtpPacketRewrite
+{
+	// Added to the sequence number of the RTP header
+	uint16_t sequence_number_offset = 0;
+
+	// Position of another 16-bit sequence number in the packet (e.g. SN base of a FEC header), 0 if there is none
+	size_t sn_base_position = 0;
+	// Added to the sequence number at sn_base_position
+	uint16_t sn_base_offset = 0;
+
+	bool IsEmpty() const
+	{
+		return (sequence_number_offset == 0) && ((sn_base_position == 0) || (sn_base_offset == 0));
+	}
+};
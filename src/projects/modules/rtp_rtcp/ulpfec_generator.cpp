@@ -3,6 +3,11 @@
 
 #include <string.h>
 
+#if defined(__x86_64__) || defined(__i386__)
+#	define ULPFEC_GENERATOR_X86 1
+#	include <immintrin.h>
+#endif
+
 constexpr size_t 	kFecHeaderSize					= 10;
 constexpr size_t 	kMaskSizeLbitClear				= 2;
 constexpr size_t	kMaskSizeLbitSet				= 6;
@@ -11,24 +16,161 @@ constexpr size_t	kFecLevelHeaderSizeLbitSet		= 2 + kMaskSizeLbitSet;
 constexpr size_t 	kUlpfecMaxMediaPacketsLbitClear	= 16;
 constexpr size_t 	kUlpfecMaxMediaPacketsLbitSet	= 48;
 
-constexpr size_t    kMediaPacketNumMakeFec          = 100 / 10; // 25% Rate, 1 fec packet per 4 media packets.
+// Media packets per FEC packet of each protection level
+constexpr size_t	kMediaPacketNumMakeFec[ULPFEC_PROTECTION_LEVEL_COUNT] = { 0, 10, 6, 4 };
+
+// XORs source into destination
+static void XorScalar(uint8_t *destination, const uint8_t *source, size_t length)
+{
+	size_t index = 0;
+
+	// 8 bytes at a time (memcpy() is used for the unaligned buffers)
+	for(; (index + sizeof(uint64_t)) <= length; index += sizeof(uint64_t))
+	{
+		uint64_t destination_word;
+		uint64_t source_word;
+
+		memcpy(&destination_word, destination + index, sizeof(destination_word));
+		memcpy(&source_word, source + index, sizeof(source_word));
+
+		destination_word ^= source_word;
+
+		memcpy(destination + index, &destination_word, sizeof(destination_word));
+	}
+
+	for(; index < length; index++)
+	{
+		destination[index] ^= source[index];
+	}
+}
+
+#if ULPFEC_GENERATOR_X86
+__attribute__((target("sse2"))) static void XorSse2(uint8_t *destination, const uint8_t *source, size_t length)
+{
+	size_t index = 0;
+
+	for(; (index + 16) <= length; index += 16)
+	{
+		auto destination_block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(destination + index));
+		auto source_block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + index));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(destination + index), _mm_xor_si128(destination_block, source_block));
+	}
+
+	XorScalar(destination + index, source + index, length - index);
+}
+
+__attribute__((target("avx2"))) static void XorAvx2(uint8_t *destination, const uint8_t *source, size_t length)
+{
+	size_t index = 0;
+
+	for(; (index + 32) <= length; index += 32)
+	{
+		auto destination_block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(destination + index));
+		auto source_block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + index));
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + index), _mm256_xor_si256(destination_block, source_block));
+	}
+
+	XorScalar(destination + index, source + index, length - index);
+}
+#endif  // ULPFEC_GENERATOR_X86
+
+using XorFunction = void (*)(uint8_t *destination, const uint8_t *source, size_t length);
+
+struct XorImplementation
+{
+	XorFunction xor_function;
+	const char *name;
+};
+
+static XorImplementation SelectXorImplementation()
+{
+#if ULPFEC_GENERATOR_X86
+	__builtin_cpu_init();
+
+	if(__builtin_cpu_supports("avx2"))
+	{
+		return {XorAvx2, "avx2"};
+	}
+
+	if(__builtin_cpu_supports("sse2"))
+	{
+		return {XorSse2, "sse2"};
+	}
+#endif
+
+	return {XorScalar, "scalar"};
+}
+
+static const XorImplementation &GetXorImplementation()
+{
+	// Selected once, when it is used for the first time
+	static const XorImplementation implementation = SelectXorImplementation();
+
+	return implementation;
+}
 
 UlpfecGenerator::UlpfecGenerator()
 {
-	_high_level = false;
+	_protection_level = UlpfecProtectionLevel::Low;
 }
 
 UlpfecGenerator::~UlpfecGenerator()
 {
 }
 
-void UlpfecGenerator::SetHighRateProtection(bool high_level)
+void UlpfecGenerator::SetProtectionLevel(UlpfecProtectionLevel level)
+{
+	_protection_level = level;
+}
+
+UlpfecProtectionLevel UlpfecGenerator::GetProtectionLevel() const
+{
+	return _protection_level;
+}
+
+size_t UlpfecGenerator::GetMediaPacketCountPerFec(UlpfecProtectionLevel level)
+{
+	auto index = static_cast<size_t>(level);
+
+	return (index < ULPFEC_PROTECTION_LEVEL_COUNT) ? kMediaPacketNumMakeFec[index] : 0;
+}
+
+UlpfecProtectionLevel UlpfecGenerator::GetProtectionLevel(double loss_rate, bool disable_on_clean_path)
+{
+	if(loss_rate >= ULPFEC_HIGH_PROTECTION_LOSS)
+	{
+		return UlpfecProtectionLevel::High;
+	}
+
+	if(loss_rate >= ULPFEC_MEDIUM_PROTECTION_LOSS)
+	{
+		return UlpfecProtectionLevel::Medium;
+	}
+
+	if((loss_rate >= ULPFEC_LOW_PROTECTION_LOSS) || (disable_on_clean_path == false))
+	{
+		return UlpfecProtectionLevel::Low;
+	}
+
+	// Retransmissions are enough for the rare losses
+	return UlpfecProtectionLevel::None;
+}
+
+const char *UlpfecGenerator::GetXorImplementationName()
 {
-	_high_level = high_level;
+	return GetXorImplementation().name;
 }
 
 bool UlpfecGenerator::AddRtpPacketAndGenerateFec(std::shared_ptr<RedRtpPacket> packet)
 {
+	if(_media_packets.empty() && (GetProtectionLevel() == UlpfecProtectionLevel::None))
+	{
+		// FEC is not needed, so the packets are not kept
+		return true;
+	}
+
 	_media_packets.push_back(packet);
 
 	if(packet->Marker())
@@ -60,8 +202,16 @@ bool UlpfecGenerator::NextPacket(RtpPacket *packet)
 bool UlpfecGenerator::Encode()
 {
 	size_t media_size = _media_packets.size();
-	//uint32_t rate = static_cast<uint32_t>(kMediaPacketNumMakeFec / (_high_level?2:1));
-	uint32_t fec_packet_count = static_cast<uint32_t>(std::ceil((float)media_size / (float)kMediaPacketNumMakeFec));
+	size_t media_packet_count_per_fec = GetMediaPacketCountPerFec(GetProtectionLevel());
+
+	if(media_packet_count_per_fec == 0)
+	{
+		// The level has been changed to None during the frame
+		_media_packets.clear();
+		return true;
+	}
+
+	uint32_t fec_packet_count = static_cast<uint32_t>(std::ceil((float)media_size / (float)media_packet_count_per_fec));
 	uint32_t media_packet_idx = 0;
 	size_t mask_len = 0;
 
@@ -194,10 +344,7 @@ void UlpfecGenerator::XorFecPacket(uint8_t *fec_packet, size_t fec_header_len, R
 	fec_packet[9] ^= rtp_payload_length_network_order[1];
 
 	// XOR Payload
-	for(size_t i = 0; i < rtp_payload_len; i++)
-	{
-		fec_packet[fec_header_len + i] ^= rtp_payload[i];
-	}
+	GetXorImplementation().xor_function(&fec_packet[fec_header_len], rtp_payload, rtp_payload_len);
 }
 
 void UlpfecGenerator::FinalizeFecHeader(uint8_t *fec_packet, const size_t fec_payload_len, const uint8_t *mask, const size_t mask_len)
@@ -7,6 +7,8 @@
 #include "base/common_types.h"
 #include "red_rtp_packet.h"
 
+#include <atomic>
+
 /*
 * RTP + RED + FEC
     0                   1                    2                   3
@@ -37,17 +39,49 @@
  *	The current version of OME protects all contiguous media packets with one FEC packet,
  *  and one media packet only protects with one FEC packet.
  *  Fec packets is generated by a frame.
- *  Current version generates only one fec packet, near future we will apply bursty mask model.
+ *  The number of FEC packets of a frame is determined by the protection level.
  *  The session determines whether the FEC PACKET is sent according to the network status (using RTCP RR).
  */
 
+// How many FEC packets are generated for the media packets
+enum class UlpfecProtectionLevel : uint8_t
+{
+	// FEC is not generated
+	None = 0,
+	// 1 FEC packet per 10 media packets
+	Low,
+	// 1 FEC packet per 6 media packets
+	Medium,
+	// 1 FEC packet per 4 media packets
+	High
+};
+
+#define ULPFEC_PROTECTION_LEVEL_COUNT		4
+
+// Loss rates (fraction lost of RTCP RR) from which the protection levels are used
+#define ULPFEC_LOW_PROTECTION_LOSS			0.01
+#define ULPFEC_MEDIUM_PROTECTION_LOSS		0.03
+#define ULPFEC_HIGH_PROTECTION_LOSS			0.08
+
 class UlpfecGenerator
 {
 public:
 	UlpfecGenerator();
 	~UlpfecGenerator();
 
-	void SetHighRateProtection(bool high_level);
+	// It can be changed by the other threads while the packets are generated. It is applied from the next frame.
+	void SetProtectionLevel(UlpfecProtectionLevel level);
+	UlpfecProtectionLevel GetProtectionLevel() const;
+
+	// Number of media packets which are protected by a FEC packet (0 if the level is None)
+	static size_t GetMediaPacketCountPerFec(UlpfecProtectionLevel level);
+	// Protection level for the loss rate (0.0 ~ 1.0) of a path.
+	// If disable_on_clean_path is false, the paths without loss are protected with the Low level.
+	static UlpfecProtectionLevel GetProtectionLevel(double loss_rate, bool disable_on_clean_path);
+
+	// Name of the XOR implementation selected for this CPU ("avx2", "sse2" or "scalar")
+	static const char *GetXorImplementationName();
+
 	// Because RTP is already being sent out, we execute ulpfec using the newly created red packet.
 	// I used this technique to reduce the copying and improve performance.
 	bool AddRtpPacketAndGenerateFec(std::shared_ptr<RedRtpPacket> packet);
@@ -61,5 +95,5 @@ private:
 
 	std::queue<std::shared_ptr<ov::Data>>	    _generated_fec_packets;
 	std::vector<std::shared_ptr<RedRtpPacket>>	_media_packets;
-	bool                                        _high_level;
+	std::atomic<UlpfecProtectionLevel>          _protection_level;
 };
\ No newline at end of file
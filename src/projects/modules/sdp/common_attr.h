@@ -10,6 +10,8 @@
 #pragma once
 #include "sdp_base.h"
 
+#include <string_view>
+
 // Session Level과 Media Level 양쪽에서 모두 사용될 수 있는 Attribute
 
 #include "sdp_base.h"
@@ -21,7 +23,7 @@ protected:
 	~CommonAttr();
 
 	bool			SerializeCommonAttr(ov::String &sdp);
-	bool			ParsingCommonAttrLine(char type, std::string content);
+	bool			ParsingCommonAttrLine(char type, const std::string_view &content);
 
 public:
 	// a=fingerprint:sha-256 D7:81:CF:01:46:FB:2D
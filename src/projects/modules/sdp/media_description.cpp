@@ -9,8 +9,7 @@
 
 #include "media_description.h"
 #include "session_description.h"
-
-#include <regex>
+#include "sdp_tokenizer.h"
 
 MediaDescription::MediaDescription(const std::shared_ptr<SessionDescription> &session_desc)
 {
@@ -131,7 +130,17 @@ bool MediaDescription::UpdateData(ov::String &sdp)
 	// SSRCs
 	if(_cname.IsEmpty() == false)
 	{
+		if(_rtx_ssrc != 0)
+		{
+			sdp.AppendFormat("a=ssrc-group:FID %u %u\r\n", _ssrc, _rtx_ssrc);
+		}
+
 		sdp.AppendFormat("a=ssrc:%u cname:%s\r\n", _ssrc, _cname.CStr());
+
+		if(_rtx_ssrc != 0)
+		{
+			sdp.AppendFormat("a=ssrc:%u cname:%s\r\n", _rtx_ssrc, _cname.CStr());
+		}
 	}
 
 	return true;
@@ -163,22 +172,27 @@ bool MediaDescription::SetMediaType(const ov::String &type)
 
 bool MediaDescription::FromString(const ov::String &desc)
 {
-	std::stringstream sdpstream(desc.CStr());
-	std::string line;
+	return FromString(std::string_view(desc.CStr(), desc.GetLength()));
+}
+
+bool MediaDescription::FromString(const std::string_view &desc)
+{
+	std::string_view text = desc;
+	std::string_view line;
 
-	while(std::getline(sdpstream, line, '\n'))
+	while(SdpTokenizer::NextLine(text, line))
 	{
-		if(line.size() && line[line.length() - 1] == '\r')
+		if(SdpTokenizer::IsValidLine(line) == false)
 		{
-			line.pop_back();
+			continue;
 		}
 
 		char type = line[0];
-		std::string content = line.substr(2);
+		auto content = line.substr(2);
 
 		if(ParsingMediaLine(type, content) == false)
 		{
-			logw("SDP", "Could not parse line: %c: %s (%s)", type, content.c_str(), line.c_str());
+			logw("SDP", "Could not parse line: %.*s", static_cast<int>(line.size()), line.data());
 			return false;
 		}
 	}
@@ -212,204 +226,179 @@ bool MediaDescription::SetDirection(const ov::String &dir)
 	return true;
 }
 
-bool MediaDescription::ParsingMediaLine(char type, std::string content)
+bool MediaDescription::ParsingMediaLine(char type, const std::string_view &content)
 {
 	bool parsing_error = false;
-	std::smatch matches;
+	SdpTokenizer tokenizer(content);
 
 	switch(type)
 	{
 		case 'm':
+		{
 			// m=video 9 UDP/TLS/RTP/SAVPF 97
+			std::string_view media_type, protocol_token;
+			uint16_t port;
 
-			if(std::regex_search(content, matches, std::regex("^(\\w*) (\\d*) ([\\w\\/]*)(?: (.*))?")))
+			// 필수값 이므로 m이 에러가 나면 실패
+			if((tokenizer.NextToken(' ', media_type) && tokenizer.NextNumber(' ', port) && tokenizer.NextToken(' ', protocol_token)) == false)
 			{
-				if(matches.size() < 4 + 1)
-				{
-					parsing_error = true;
-					break;
-				}
+				parsing_error = true;
+				break;
+			}
 
-				if(!SetMediaType(std::string(matches[1]).c_str()))
-				{
-					parsing_error = true;
-					break;
-				}
+			if(!SetMediaType(SdpTokenizer::ToString(media_type)))
+			{
+				parsing_error = true;
+				break;
+			}
 
-				SetPort(std::stoul(matches[2]));
+			SetPort(port);
 
-				ov::String protocol = std::string(matches[3]).c_str();
-				if(protocol.UpperCaseString() == "UDP/TLS/RTP/SAVPF")
-				{
-					UseDtls(true);
-				}
-				else if(protocol.UpperCaseString() == "RTP/AVPF")
-				{
-					UseDtls(false);
-				}
-				else
-				{
-					loge("SDP", "Cannot support %s protocol", protocol.CStr());
-					parsing_error = true;
-					break;
-				}
-
-				// Payload를 모두 생성하여 넣는다.
-				// 나중에 Payload에 관련된 정보(rtpmap, fmtp, rtcp-fb)가 나오면 파싱하여 해당 Payload에 값을 설정한다.
-				std::string payload_number;
-				std::stringstream payload_numbers(matches[4]);
-				while(std::getline(payload_numbers, payload_number, ' '))
-				{
-					auto payload = std::make_shared<PayloadAttr>();
-					payload->SetId(static_cast<uint8_t>(std::stoul(payload_number)));
-					AddPayload(payload);
-				}
+			ov::String protocol = SdpTokenizer::ToString(protocol_token);
+			if(protocol.UpperCaseString() == "UDP/TLS/RTP/SAVPF")
+			{
+				UseDtls(true);
+			}
+			else if(protocol.UpperCaseString() == "RTP/AVPF")
+			{
+				UseDtls(false);
 			}
 			else
 			{
-				// 필수값 이므로 m이 에러가 나면 실패
+				loge("SDP", "Cannot support %s protocol", protocol.CStr());
 				parsing_error = true;
+				break;
 			}
-			break;
-		case 'c':
-			// c=IN IP4 0.0.0.0
-			if(std::regex_search(content, matches, std::regex("^IN IP(\\d) (\\S*)")))
+
+			// Payload를 모두 생성하여 넣는다.
+			// 나중에 Payload에 관련된 정보(rtpmap, fmtp, rtcp-fb)가 나오면 파싱하여 해당 Payload에 값을 설정한다.
+			uint8_t payload_number;
+			while(tokenizer.IsEnd() == false)
 			{
-				if(matches.size() != 2 + 1)
+				if(tokenizer.NextNumber(' ', payload_number) == false)
 				{
 					parsing_error = true;
 					break;
 				}
 
-				SetConnection(std::stoul(matches[1]), std::string(matches[2]).c_str());
+				auto payload = std::make_shared<PayloadAttr>();
+				payload->SetId(payload_number);
+				AddPayload(payload);
 			}
-			else
+			break;
+		}
+		case 'c':
+		{
+			// c=IN IP4 0.0.0.0
+			uint8_t ip_version;
+
+			// 필수값 이므로 c가 에러가 나면 실패
+			if((tokenizer.SkipPrefix("IN IP") && tokenizer.NextNumber(' ', ip_version)) == false)
 			{
-				// 필수값 이므로 m이 에러가 나면 실패
 				parsing_error = true;
+				break;
 			}
 
+			SetConnection(ip_version, SdpTokenizer::ToString(tokenizer.NextWord()));
 			break;
-
+		}
 		case 'a':
-			// For Performance
-			if(content.compare(0, OV_COUNTOF("rtp") - 1,"rtp") == 0)
+			if(tokenizer.SkipPrefix("rtpmap:"))
 			{
 				// a=rtpmap:96 VP8/50000/?
-				if(std::regex_search(content,
-				                     matches,
-				                     std::regex("rtpmap:(\\d*) ([\\w\\-\\.]*)(?:\\s*\\/(\\d*)(?:\\s*\\/(\\S*))?)?")))
-				{
-					if(matches.size() < 3 + 1)
-					{
-						parsing_error = true;
-						break;
-					}
+				uint8_t payload_type;
+				uint32_t rate;
+				std::string_view codec, parameters;
 
-					//TODO(getroot): matches[4]가 없는 경우에도 메모리는 할당 되는지 확인
-					AddRtpmap(static_cast<uint8_t>(std::stoul(matches[1])), std::string(matches[2]).c_str(),
-					          static_cast<uint32_t>(std::stoul(matches[3])), std::string(matches[4]).c_str());
+				if((tokenizer.NextNumber(' ', payload_type) && tokenizer.NextToken('/', codec) && tokenizer.NextNumber('/', rate)) == false)
+				{
+					parsing_error = true;
+					break;
 				}
+
+				tokenizer.NextToken(' ', parameters);
+
+				AddRtpmap(payload_type, SdpTokenizer::ToString(codec), rate, SdpTokenizer::ToString(parameters));
 			}
 				// a=rtcp-mux
-			else if(content.compare(0, OV_COUNTOF("rtcp-m") - 1,"rtcp-m") == 0)
+			else if(tokenizer.SkipPrefix("rtcp-mux"))
 			{
-				if(std::regex_search(content, matches, std::regex("^(rtcp-mux)")))
-				{
-					UseRtcpMux(true);
-				}
+				UseRtcpMux(true);
 			}
-			else if(content.compare(0, OV_COUNTOF("rtcp-f") - 1, "rtcp-f") == 0)
+			else if(tokenizer.SkipPrefix("rtcp-fb:"))
 			{
 				// a=rtcp-fb:96 nack pli
 				// pli는 subtype으로 구분해야 하지만 여기서는 type-subtype 형태로 구분한다.
-				if(std::regex_search(content,
-				                     matches,
-				                     std::regex("rtcp-fb:(\\*|\\d*) (.*)")))
+				std::string_view id;
+				uint8_t payload_type;
+
+				if(tokenizer.NextToken(' ', id) == false || tokenizer.IsEnd())
+				{
+					parsing_error = true;
+					break;
+				}
+
+				auto fb_type = SdpTokenizer::ToString(tokenizer.Rest());
+
+				if(id == "*")
 				{
-					if(matches.size() != 2 + 1)
+					// All payloads
+					for(auto &payload : _payload_list)
 					{
-						parsing_error = true;
-						break;
+						payload->EnableRtcpFb(fb_type, true);
 					}
-
-					EnableRtcpFb(static_cast<uint8_t>(std::stoul(matches[1])), std::string(matches[2]).c_str(), true);
+				}
+				else if(SdpTokenizer::ToNumber(id, payload_type))
+				{
+					EnableRtcpFb(payload_type, fb_type, true);
+				}
+				else
+				{
+					parsing_error = true;
 				}
 			}
-			else if(content.compare(0, OV_COUNTOF("mid") - 1, "mid") == 0)
+			else if(tokenizer.SkipPrefix("mid:"))
 			{
 				// a=mid:video,
-				if(std::regex_search(content, matches, std::regex("^mid:([^\\s]*)")))
-				{
-					if(matches.size() != 1 + 1)
-					{
-						parsing_error = true;
-						break;
-					}
-
-					SetMid(std::string(matches[1]).c_str());
-				}
+				SetMid(SdpTokenizer::ToString(tokenizer.NextWord()));
 			}
-			else if(content.compare(0, OV_COUNTOF("set") - 1, "set") == 0)
+			else if(tokenizer.SkipPrefix("setup:"))
 			{
 				// a=setup:actpass
-				if(std::regex_search(content, matches, std::regex("^setup:(\\w*)")))
-				{
-					if(matches.size() != 1 + 1)
-					{
-						parsing_error = true;
-						break;
-					}
-
-					SetSetup(std::string(matches[1]).c_str());
-				}
+				SetSetup(SdpTokenizer::ToString(tokenizer.NextWord()));
 			}
-			else if(content.compare(0, OV_COUNTOF("ss") - 1, "ss") == 0)
+			else if(tokenizer.SkipPrefix("ssrc:"))
 			{
 				// a=ssrc:2064629418 cname:{b2266c86-259f-4853-8662-ea94cf0835a3}
-				if(std::regex_search(content, matches, std::regex("ssrc:(\\d*) cname(?::(.*))?")))
-				{
-					if(matches.size() != 2 + 1)
-					{
-						parsing_error = true;
-						break;
-					}
+				// The other attributes of the ssrc (msid, mslabel, ...) are not used
+				uint32_t ssrc;
 
-					SetCname(stoul(matches[1]), std::string(matches[2]).c_str());
+				if(tokenizer.NextNumber(' ', ssrc) && tokenizer.SkipPrefix("cname"))
+				{
+					tokenizer.SkipPrefix(":");
+					SetCname(ssrc, SdpTokenizer::ToString(tokenizer.Rest()));
 				}
 			}
-			else if(content.compare(0, OV_COUNTOF("fra") - 1, "fra") == 0)
+			else if(tokenizer.SkipPrefix("framerate:"))
 			{
 				// a=framerate:29.97
-				if(std::regex_search(content, matches, std::regex("^framerate:(\\d+(?:$|\\.\\d+))")))
-				{
-					if(matches.size() != 1 + 1)
-					{
-						parsing_error = true;
-						break;
-					}
+				auto framerate = tokenizer.NextWord();
+				char *end = nullptr;
+				// strtof() stops at the end of the word, because the line is followed by CRLF or a white space
+				auto value = std::strtof(framerate.data(), &end);
 
-					SetFramerate(std::stof(matches[1]));
+				if((framerate.empty() == false) && (end == (framerate.data() + framerate.size())))
+				{
+					SetFramerate(value);
 				}
 			}
-				// a=sendonly
-			else if(content.compare(0, OV_COUNTOF("se") - 1, "se") == 0 ||
-			        content.compare(0, OV_COUNTOF("re") - 1, "re") == 0 ||
-			        content.compare(0, OV_COUNTOF("in") - 1, "in") == 0)
+			else if((content == "sendrecv") || (content == "recvonly") || (content == "sendonly") || (content == "inactive"))
 			{
-				if(std::regex_search(content, matches, std::regex("^(sendrecv|recvonly|sendonly|inactive)")))
+				// a=sendonly
+				if(!SetDirection(SdpTokenizer::ToString(content)))
 				{
-					if(matches.size() != 1 + 1)
-					{
-						parsing_error = true;
-						break;
-					}
-
-					if(!SetDirection(std::string(matches[1]).c_str()))
-					{
-						parsing_error = true;
-						break;
-					}
+					parsing_error = true;
+					break;
 				}
 			}
 			else if(ParsingCommonAttrLine(type, content))
@@ -420,18 +409,18 @@ bool MediaDescription::ParsingMediaLine(char type, std::string content)
 			{
 				//TODO: Implementing of unknown attributes
             	//a=fmtp:112 minptime=10;useinbandfec=1
-				logw("SDP", "Unknown Attributes : %c=%s", type, content.c_str());
+				logw("SDP", "Unknown Attributes : %c=%.*s", type, static_cast<int>(content.size()), content.data());
 			}
 
 			break;
 		default:
-			logw("SDP", "Unknown Attributes : %c=%s", type, content.c_str());
+			logw("SDP", "Unknown Attributes : %c=%.*s", type, static_cast<int>(content.size()), content.data());
 			break;
 	}
 
 	if(parsing_error)
 	{
-		loge("SDP", "Sdp parsing error : %c=%s", type, content.c_str());
+		loge("SDP", "Sdp parsing error : %c=%.*s", type, static_cast<int>(content.size()), content.data());
 		return false;
 	}
 
@@ -662,6 +651,17 @@ ov::String MediaDescription::GetCname() const
 	return _cname;
 }
 
+// a=ssrc-group:FID 2064629418 1427432361
+void MediaDescription::SetRtxSsrc(uint32_t ssrc)
+{
+	_rtx_ssrc = ssrc;
+}
+
+uint32_t MediaDescription::GetRtxSsrc() const
+{
+	return _rtx_ssrc;
+}
+
 // a=rtpmap:96 VP8/50000
 bool MediaDescription::AddRtpmap(uint8_t payload_type, const ov::String &codec,
                                  uint32_t rate, const ov::String &parameters)
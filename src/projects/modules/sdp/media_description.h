@@ -49,6 +49,8 @@ public:
 	virtual ~MediaDescription();
 
 	bool FromString(const ov::String &desc) override;
+	// desc is not copied (e.g. a range of the session description)
+	bool FromString(const std::string_view &desc);
 
 	// m=video 9 UDP/TLS/RTP/SAVPF 97
 	void SetMediaType(MediaType type);
@@ -102,9 +104,14 @@ public:
 	uint32_t GetSsrc() const;
 	ov::String GetCname() const;
 
+	// a=ssrc-group:FID 2064629418 1427432361
+	// a=ssrc:1427432361 cname:{b2266c86-259f-4853-8662-ea94cf0835a3}
+	void SetRtxSsrc(uint32_t ssrc);
+	uint32_t GetRtxSsrc() const;
+
 private:
 	bool UpdateData(ov::String &sdp) override;
-	bool ParsingMediaLine(char type, std::string content);
+	bool ParsingMediaLine(char type, const std::string_view &content);
 
 	MediaType _media_type = MediaType::Unknown;
 	ov::String _media_type_str = "UNKNOWN";
@@ -129,6 +136,7 @@ private:
 	float _framerate = 0.0f;
 
 	uint32_t _ssrc = 0;
+	uint32_t _rtx_ssrc = 0;
 	ov::String _cname;
 
 
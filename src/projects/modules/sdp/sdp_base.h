@@ -29,6 +29,12 @@ public:
 protected:
 	virtual bool UpdateData(ov::String &sdp) = 0;
 
+	// For the text which is made without UpdateData() (e.g. patched from a template)
+	void SetSdpText(const ov::String &sdp_text)
+	{
+		_sdp_text = sdp_text;
+	}
+
 private:
 	ov::String _sdp_text;
 };
@@ -0,0 +1,144 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2018 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/string.h>
+
+#include <charconv>
+#include <string_view>
+
+// Reads the lines and the tokens of an SDP without copying them.
+// It replaces std::regex, which was compiled again for every line of every SDP.
+//
+//   // a=rtpmap:96 VP8/90000
+//   SdpTokenizer tokenizer(content);
+//   if(tokenizer.SkipPrefix("rtpmap:") && tokenizer.NextNumber(' ', payload_type) && tokenizer.NextToken('/', codec) ...)
+class SdpTokenizer
+{
+public:
+	explicit SdpTokenizer(const std::string_view &text)
+		: _text(text)
+	{
+	}
+
+	// Takes the next line of text (without CRLF), and moves text to the line after it
+	static bool NextLine(std::string_view &text, std::string_view &line)
+	{
+		if(text.empty())
+		{
+			return false;
+		}
+
+		auto position = text.find('\n');
+
+		line = text.substr(0, position);
+		text = (position == std::string_view::npos) ? std::string_view() : text.substr(position + 1);
+
+		if((line.empty() == false) && (line.back() == '\r'))
+		{
+			line.remove_suffix(1);
+		}
+
+		return true;
+	}
+
+	// <type>=<value> (type is a lower case letter)
+	static bool IsValidLine(const std::string_view &line)
+	{
+		return (line.size() >= 2) && (line[0] >= 'a') && (line[0] <= 'z') && (line[1] == '=');
+	}
+
+	static ov::String ToString(const std::string_view &text)
+	{
+		return ov::String(text.data(), text.size());
+	}
+
+	template <typename T>
+	static bool ToNumber(const std::string_view &text, T &value)
+	{
+		if(text.empty())
+		{
+			return false;
+		}
+
+		auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+
+		// Whole text must be a number
+		return (result.ec == std::errc()) && (result.ptr == (text.data() + text.size()));
+	}
+
+	// Skips prefix if the rest starts with it
+	bool SkipPrefix(const std::string_view &prefix)
+	{
+		if(_text.compare(0, prefix.size(), prefix) != 0)
+		{
+			return false;
+		}
+
+		_text.remove_prefix(prefix.size());
+
+		return true;
+	}
+
+	void SkipSpaces()
+	{
+		while((_text.empty() == false) && ((_text.front() == ' ') || (_text.front() == '\t')))
+		{
+			_text.remove_prefix(1);
+		}
+	}
+
+	// Takes the text before the delimiter, and skips the delimiter.
+	// If there is no delimiter, the rest is taken. Returns false if nothing is left.
+	bool NextToken(char delimiter, std::string_view &token)
+	{
+		if(_text.empty())
+		{
+			return false;
+		}
+
+		auto position = _text.find(delimiter);
+
+		token = _text.substr(0, position);
+		_text = (position == std::string_view::npos) ? std::string_view() : _text.substr(position + 1);
+
+		return true;
+	}
+
+	template <typename T>
+	bool NextNumber(char delimiter, T &value)
+	{
+		std::string_view token;
+
+		return NextToken(delimiter, token) && ToNumber(token, value);
+	}
+
+	// The rest until a white space (like \S* of a regex)
+	std::string_view NextWord()
+	{
+		auto position = _text.find_first_of(" \t");
+		auto word = _text.substr(0, position);
+
+		_text.remove_prefix(word.size());
+
+		return word;
+	}
+
+	const std::string_view &Rest() const
+	{
+		return _text;
+	}
+
+	bool IsEnd() const
+	{
+		return _text.empty();
+	}
+
+private:
+	std::string_view _text;
+};
@@ -1,14 +1,5 @@
-/*
- *
- * The REGEX pattern in this source code is refers to libsdptransform.
- * https://github.com/ibc/libsdptransform [MIT LICENSE]
- *
- *
- */
-
 #include "session_description.h"
-#include <sstream>
-#include <regex>
+#include "sdp_tokenizer.h"
 
 SessionDescription::SessionDescription()
 {
@@ -28,11 +19,21 @@ bool SessionDescription::UpdateData(ov::String &sdp)
 	// Session
 	sdp.Format(
 		"v=%d\r\n"
-		"o=%s %u %d %s IP%d %s\r\n"
+		"o=%s ",
+		_version,
+		_user_name.CStr()
+	);
+
+	// Clone() replaces the session id here
+	_session_id_offset = sdp.GetLength();
+	sdp.AppendFormat("%u", _session_id);
+	_session_id_length = sdp.GetLength() - _session_id_offset;
+
+	sdp.AppendFormat(
+		" %d %s IP%d %s\r\n"
 		"s=%s\r\n"
 		"t=%d %d\r\n",
-		_version,
-		_user_name.CStr(), _session_id, _session_version, _net_type.CStr(), _ip_version, _address.CStr(),
+		_session_version, _net_type.CStr(), _ip_version, _address.CStr(),
 		_session_name.CStr(),
 		_start_time, _stop_time
 	);
@@ -69,6 +70,13 @@ bool SessionDescription::UpdateData(ov::String &sdp)
 		return false;
 	}
 
+	// Clone() replaces the ufrag here
+	static constexpr const char ICE_UFRAG_PREFIX[] = "a=ice-ufrag:";
+	auto ice_ufrag_index = common_attr_text.IndexOf(ICE_UFRAG_PREFIX);
+
+	_ice_ufrag_offset = (ice_ufrag_index < 0) ? -1 : (sdp.GetLength() + ice_ufrag_index + OV_COUNTOF(ICE_UFRAG_PREFIX) - 1);
+	_ice_ufrag_length = CommonAttr::GetIceUfrag().GetLength();
+
 	sdp += common_attr_text;
 
 	// Media
@@ -80,66 +88,73 @@ bool SessionDescription::UpdateData(ov::String &sdp)
 	return true;
 }
 
-bool SessionDescription::FromString(const ov::String &sdp)
+std::shared_ptr<SessionDescription> SessionDescription::Clone(uint32_t session_id, const ov::String &ice_ufrag) const
 {
-	static const std::regex ValidLineRegex("^([a-z])=(.*)");
-	std::stringstream sdpstream(sdp.CStr());
-	std::string line;
+	auto description = std::make_shared<SessionDescription>(*this);
 
-	ov::String media_desc_sdp;
-	bool media_level = false;
+	description->_session_id = session_id;
+	description->SetIceUfrag(ice_ufrag);
 
-	while(std::getline(sdpstream, line, '\n'))
+	if((_session_id_offset < 0) || (_ice_ufrag_offset < _session_id_offset))
 	{
-		if(line.size() && line[line.length() - 1] == '\r')
-		{
-			line.pop_back();
-		}
+		// There is no template (Update() has not been called, or there is no ufrag at the session level)
+		description->Update();
+		return description;
+	}
+
+	const auto text = ToString();
+	auto session_id_end = _session_id_offset + _session_id_length;
+	auto ice_ufrag_end = _ice_ufrag_offset + _ice_ufrag_length;
+
+	ov::String sdp;
+	sdp.SetCapacity(text.GetLength() + ice_ufrag.GetLength() + 16);
+
+	sdp.Append(text.CStr(), _session_id_offset);
+	sdp.AppendFormat("%u", session_id);
+	description->_session_id_length = sdp.GetLength() - _session_id_offset;
+
+	sdp.Append(text.CStr() + session_id_end, _ice_ufrag_offset - session_id_end);
+	description->_ice_ufrag_offset = sdp.GetLength();
+	description->_ice_ufrag_length = ice_ufrag.GetLength();
+	sdp.Append(ice_ufrag);
 
-		if(!std::regex_search(line, ValidLineRegex))
+	sdp.Append(text.CStr() + ice_ufrag_end, text.GetLength() - ice_ufrag_end);
+
+	description->SetSdpText(sdp);
+
+	return description;
+}
+
+bool SessionDescription::FromString(const ov::String &sdp)
+{
+	std::string_view text(sdp.CStr(), sdp.GetLength());
+	std::string_view line;
+
+	// media라면 다음 m을 만날때까지 또는 sdp가 끝날때까지의 범위를 media description에 넘긴다.
+	const char *media_section = nullptr;
+
+	while(SdpTokenizer::NextLine(text, line))
+	{
+		if(SdpTokenizer::IsValidLine(line) == false)
 		{
 			continue;
 		}
+
 		char type = line[0];
-		std::string content = line.substr(2);
+		auto content = line.substr(2);
 
-		// media라면 다음 m을 만날때까지 또는 stream이 끝날때까지 모아서 media description에 넘긴다.
 		if(type == 'm')
 		{
 			// 새로운 m을 만나면 기존 m level을 파싱
-			if(media_level == true)
+			if((media_section != nullptr) && (ParsingMediaSection(std::string_view(media_section, line.data() - media_section)) == false))
 			{
-				auto media_desc = std::make_shared<MediaDescription>(GetSharedPtr());
-				if(media_desc->FromString(media_desc_sdp) == false)
-				{
-					return false;
-				}
-				AddMedia(media_desc);
+				return false;
 			}
 
-			// 초기화
-			media_desc_sdp.Clear();
-			media_desc_sdp.AppendFormat("%s\n", line.c_str());
-			media_level = true;
-		}
-			// media level이면 계속 모은다.
-		else if(media_level == true)
-		{
-			media_desc_sdp.AppendFormat("%s\n", line.c_str());
-
-			// 만약 sdp의 끝이면 생성
-			if(sdpstream.rdbuf()->in_avail() == 0)
-			{
-				auto media_desc = std::make_shared<MediaDescription>(GetSharedPtr());
-				if(media_desc->FromString(media_desc_sdp) == false)
-				{
-					return false;
-				}
-				AddMedia(media_desc);
-			}
+			media_section = line.data();
 		}
 			// media level이 아니면 파싱하여 저장
-		else
+		else if(media_section == nullptr)
 		{
 			if(ParsingSessionLine(type, content) == false)
 			{
@@ -148,109 +163,105 @@ bool SessionDescription::FromString(const ov::String &sdp)
 		}
 	}
 
+	if((media_section != nullptr) && (ParsingMediaSection(std::string_view(media_section, sdp.CStr() + sdp.GetLength() - media_section)) == false))
+	{
+		return false;
+	}
+
 	Update();
 
 	return true;
 }
 
-bool SessionDescription::ParsingSessionLine(char type, std::string content)
+bool SessionDescription::ParsingMediaSection(const std::string_view &section)
+{
+	auto media_desc = std::make_shared<MediaDescription>(GetSharedPtr());
+
+	if(media_desc->FromString(section) == false)
+	{
+		return false;
+	}
+
+	AddMedia(media_desc);
+
+	return true;
+}
+
+bool SessionDescription::ParsingSessionLine(char type, const std::string_view &content)
 {
-	bool parsing_error = false;
-	std::smatch matches;
+	SdpTokenizer tokenizer(content);
 
 	switch(type)
 	{
 		case 'v':
+		{
 			// v=0
-			if(std::regex_search(content, matches, std::regex("^(\\d*)$")))
+			uint8_t version;
+			if(SdpTokenizer::ToNumber(content, version))
 			{
-				if(matches.size() != 1 + 1)
-				{
-					parsing_error = true;
-					break;
-				}
-				SetVersion(static_cast<uint8_t>(std::stoi(matches[1])));
+				SetVersion(version);
 			}
 			break;
+		}
 		case 'o':
+		{
 			// o=OvenMediaEngine 1882243660 2 IN IP4 127.0.0.1
-			if(std::regex_search(content, matches, std::regex("^(\\S*) (\\d*) (\\d*) (\\S*) IP(\\d) (\\S*)")))
+			std::string_view user_name, net_type;
+			// Browsers use 64 bit session ids, which are truncated to 32 bits
+			uint64_t session_id, session_version;
+			uint8_t ip_version;
+
+			if(tokenizer.NextToken(' ', user_name) &&
+			   tokenizer.NextNumber(' ', session_id) &&
+			   tokenizer.NextNumber(' ', session_version) &&
+			   tokenizer.NextToken(' ', net_type) &&
+			   tokenizer.SkipPrefix("IP") &&
+			   tokenizer.NextNumber(' ', ip_version))
 			{
-				if(matches.size() != 6 + 1)
-				{
-					parsing_error = true;
-					break;
-				}
-
-				SetOrigin(std::string(matches[1]).c_str(),
-				          static_cast<uint32_t>(std::stoul(matches[2])),
-				          static_cast<uint32_t>(std::stoul(matches[3])),
-				          std::string(matches[4]).c_str(),
-				          static_cast<uint8_t>(std::stoul(matches[5])),
-				          std::string(matches[6]).c_str());
+				SetOrigin(SdpTokenizer::ToString(user_name), static_cast<uint32_t>(session_id), static_cast<uint32_t>(session_version),
+				          SdpTokenizer::ToString(net_type), ip_version, SdpTokenizer::ToString(tokenizer.NextWord()));
 			}
 			break;
+		}
 		case 's':
 			// s=-
-			if(std::regex_search(content, matches, std::regex("^(.*)")))
-			{
-				if(matches.size() != 1 + 1)
-				{
-					parsing_error = true;
-					break;
-				}
-
-				SetSessionName(std::string(matches[1]).c_str());
-			}
+			SetSessionName(SdpTokenizer::ToString(content));
 			break;
 		case 't':
+		{
 			// t=0 0
-			if(std::regex_search(content, matches, std::regex("^(\\d*) (\\d*)")))
-			{
-				if(matches.size() != 2 + 1)
-				{
-					parsing_error = true;
-					break;
-				}
+			uint32_t start, stop;
+			std::string_view stop_token;
 
-				SetTiming(static_cast<uint32_t>(std::stoul(matches[1])),
-				          static_cast<uint32_t>(std::stoul(matches[2])));
+			if(tokenizer.NextNumber(' ', start) && tokenizer.NextToken(' ', stop_token) && SdpTokenizer::ToNumber(stop_token, stop))
+			{
+				SetTiming(start, stop);
 			}
-
 			break;
+		}
 		case 'a':
 			// a=group:BUNDLE video audio ...
-			if(content.compare(0, OV_COUNTOF("gr") - 1, "gr") == 0)
+			if(tokenizer.SkipPrefix("group:"))
 			{
-				if(std::regex_search(content, matches, std::regex("^group:BUNDLE (.*)")))
+				if(tokenizer.SkipPrefix("BUNDLE "))
 				{
-					if(matches.size() != 1 + 1)
-					{
-						parsing_error = true;
-						break;
-					}
-
-					std::string bundle;
-					std::stringstream bundles(matches[1]);
-					while(std::getline(bundles, bundle, ' '))
+					std::string_view bundle;
+					while(tokenizer.NextToken(' ', bundle))
 					{
 						// 당장은 사용하는 곳이 없다. bundle only 이므로...
-						_bundles.emplace_back(bundle.c_str());
+						_bundles.emplace_back(SdpTokenizer::ToString(bundle));
 					}
 				}
 			}
 			// a=msid-semantic:WMS *
-			else if(content.compare(0, OV_COUNTOF("ms") - 1, "ms") == 0)
+			else if(tokenizer.SkipPrefix("msid-semantic:"))
 			{
-				if(std::regex_search(content, matches, std::regex(R"(^msid-semantic:\s?(\w*) (\S*))")))
-				{
-					if(matches.size() != 2 + 1)
-					{
-						parsing_error = true;
-						break;
-					}
+				std::string_view semantic;
 
-					SetMsidSemantic(std::string(matches[1]).c_str(), std::string(matches[2]).c_str());
+				tokenizer.SkipSpaces();
+				if(tokenizer.NextToken(' ', semantic))
+				{
+					SetMsidSemantic(SdpTokenizer::ToString(semantic), SdpTokenizer::ToString(tokenizer.NextWord()));
 				}
 			}
 			else if(ParsingCommonAttrLine(type, content))
@@ -259,20 +270,15 @@ bool SessionDescription::ParsingSessionLine(char type, std::string content)
 			}
 			else
 			{
-				logw("SDP", "Unknown Attributes : %c=%s", type, content.c_str());
+				logw("SDP", "Unknown Attributes : %c=%.*s", type, static_cast<int>(content.size()), content.data());
 			}
 
 			break;
 		default:
-			logw("SDP", "Unknown Attributes : %c=%s", type, content.c_str());
-	}
-
-	if(parsing_error)
-	{
-		loge("SDP", "Sdp parsing error : %c=%s", type, content.c_str());
-		return false;
+			logw("SDP", "Unknown Attributes : %c=%.*s", type, static_cast<int>(content.size()), content.data());
 	}
 
+	// The lines which don't match are ignored
 	return true;
 }
 
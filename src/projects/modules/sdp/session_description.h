@@ -98,6 +98,11 @@ public:
 	ov::String GetIceUfrag() const override;
 	ov::String GetIcePwd() const override;
 
+	// Copies this description for a session, with the session id of o= and a=ice-ufrag replaced.
+	// The text is patched from ToString() of this description instead of being serialized again,
+	// because thousands of viewers can request the offer of a stream at the same time.
+	std::shared_ptr<SessionDescription> Clone(uint32_t session_id, const ov::String &ice_ufrag) const;
+
 	bool operator ==(const SessionDescription &description) const
 	{
 		// TODO(getroot): this와 description이 같은지를 판단할 수 있게 해주세요
@@ -106,7 +111,8 @@ public:
 
 private:
 	bool UpdateData(ov::String &sdp) override;
-	bool ParsingSessionLine(char type, std::string content);
+	bool ParsingSessionLine(char type, const std::string_view &content);
+	bool ParsingMediaSection(const std::string_view &section);
 
 	// version
 	uint8_t _version = 0;
@@ -135,4 +141,10 @@ private:
 
 	// Media
 	std::vector<std::shared_ptr<const MediaDescription>> _media_list;
+
+	// Where the values of Clone() are in the text (set by UpdateData(), -1 if it is not found)
+	off_t _session_id_offset = -1;
+	size_t _session_id_length = 0;
+	off_t _ice_ufrag_offset = -1;
+	size_t _ice_ufrag_length = 0;
 };
\ No newline at end of file
@@ -5,6 +5,8 @@
 #include "monitoring.h"
 #include "monitoring_private.h"
 
+#include <cinttypes>
+
 namespace mon
 {
 	void Monitoring::ShowInfo()
@@ -14,6 +16,34 @@ namespace mon
 			auto &host = t.second;
 			host->ShowInfo();
 		}
+
+		logti("%s", GetBufferPoolInfoString().CStr());
+	}
+
+	std::vector<ov::BufferPoolStatistics> Monitoring::GetBufferPoolStatistics() const
+	{
+		return ov::BufferPool::GetStatistics();
+	}
+
+	ov::String Monitoring::GetBufferPoolInfoString() const
+	{
+		ov::String out_str = "\n------------ Buffer Pool ------------\n";
+
+		for (const auto &statistics : GetBufferPoolStatistics())
+		{
+			if (statistics.block_size == 0)
+			{
+				out_str.AppendFormat("\t- Not pooled : Allocations(%" PRIu64 ") In use(%" PRIu64 ") High water(%" PRIu64 ")\n",
+									 statistics.miss_count, statistics.in_use_count, statistics.high_water_count);
+				continue;
+			}
+
+			out_str.AppendFormat("\t- %s : Hit(%" PRIu64 ") Miss(%" PRIu64 ") In use(%" PRIu64 ") High water(%" PRIu64 ") Pooled(%" PRIu64 ")\n",
+								 ov::Converter::BytesToString(statistics.block_size).CStr(),
+								 statistics.hit_count, statistics.miss_count, statistics.in_use_count, statistics.high_water_count, statistics.pooled_count);
+		}
+
+		return out_str;
 	}
 
 	void Monitoring::Release()
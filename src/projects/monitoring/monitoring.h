@@ -29,6 +29,10 @@ namespace mon
 
 		void ShowInfo();
 
+		// Statistics of ov::BufferPool, which ov::Data allocates media payloads from
+		std::vector<ov::BufferPoolStatistics> GetBufferPoolStatistics() const;
+		ov::String GetBufferPoolInfoString() const;
+
 		bool OnHostCreated(const info::Host &host_info);
 		bool OnHostDeleted(const info::Host &host_info);
 		bool OnApplicationCreated(const info::Application &app_info);
@@ -0,0 +1,150 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2020 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "domain_index.h"
+
+#include <algorithm>
+
+#include "orchestrator_private.h"
+
+std::string_view DomainIndex::Store(const char *data, size_t length)
+{
+	_storage.emplace_back(data, length);
+
+	return _storage.back();
+}
+
+void DomainIndex::Add(const ov::String &domain, const std::regex &regex_for_domain, const ov::String &vhost_name)
+{
+	size_t priority = _vhost_name_list.size();
+	_vhost_name_list.push_back(vhost_name);
+
+	std::string_view name(domain.CStr(), domain.GetLength());
+	auto wildcard_position = name.find_first_of("*?");
+
+	if (wildcard_position == std::string_view::npos)
+	{
+		// An exact name - if the same name is added more than once, the first one is used
+		_exact_map.emplace(Store(name.data(), name.size()), priority);
+		return;
+	}
+
+	if (name == "*")
+	{
+		_match_all_priority = std::min(_match_all_priority, priority);
+		return;
+	}
+
+	if ((name.size() > 2) && (name.compare(0, 2, "*.") == 0) && (name.find_first_of("*?", 2) == std::string_view::npos))
+	{
+		// "*.<suffix>" - insert the labels of the suffix in reverse order
+		auto suffix = Store(name.data() + 2, name.size() - 2);
+		size_t node_index = 0;
+
+		while (true)
+		{
+			auto dot_position = suffix.rfind('.');
+			auto label = (dot_position == std::string_view::npos) ? suffix : suffix.substr(dot_position + 1);
+
+			auto &children = _node_list[node_index].children;
+			auto child = children.find(label);
+
+			if (child == children.end())
+			{
+				_node_list.emplace_back();
+				// Do not use the reference of children after emplace_back()
+				_node_list[node_index].children.emplace(label, _node_list.size() - 1);
+				node_index = _node_list.size() - 1;
+			}
+			else
+			{
+				node_index = child->second;
+			}
+
+			if (dot_position == std::string_view::npos)
+			{
+				break;
+			}
+
+			suffix = suffix.substr(0, dot_position);
+		}
+
+		auto &node = _node_list[node_index];
+		node.priority = std::min(node.priority, priority);
+
+		return;
+	}
+
+	// Other patterns are matched with regex
+	_regex_list.push_back({priority, regex_for_domain});
+}
+
+ov::String DomainIndex::Find(const ov::String &domain_name) const
+{
+	std::string_view name(domain_name.CStr(), domain_name.GetLength());
+
+	size_t best_priority = _match_all_priority;
+
+	auto exact_item = _exact_map.find(name);
+
+	if (exact_item != _exact_map.end())
+	{
+		best_priority = std::min(best_priority, exact_item->second);
+	}
+
+	// Follow the labels in reverse order (eg: a.airensoft.com => com -> airensoft -> a)
+	size_t node_index = 0;
+	auto remaining = name;
+
+	while (true)
+	{
+		auto dot_position = remaining.rfind('.');
+
+		if (dot_position == std::string_view::npos)
+		{
+			// "*.<suffix>" requires at least one dot before the suffix
+			break;
+		}
+
+		auto &children = _node_list[node_index].children;
+		auto child = children.find(remaining.substr(dot_position + 1));
+
+		if (child == children.end())
+		{
+			break;
+		}
+
+		node_index = child->second;
+		remaining = remaining.substr(0, dot_position);
+
+		// "*" matches any remaining part
+		best_priority = std::min(best_priority, _node_list[node_index].priority);
+	}
+
+	for (auto &item : _regex_list)
+	{
+		if (item.priority >= best_priority)
+		{
+			// The domain added earlier is already found
+			break;
+		}
+
+		if (std::regex_match(domain_name.CStr(), item.regex))
+		{
+			best_priority = item.priority;
+			break;
+		}
+	}
+
+	if (best_priority == NoPriority)
+	{
+		return "";
+	}
+
+	return _vhost_name_list[best_priority];
+}
@@ -0,0 +1,81 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2020 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+
+#include <deque>
+#include <limits>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// An index to find the VirtualHost corresponding to the domain name
+//
+// - Names without wildcards (eg: airensoft.com) are stored in a hash map
+// - Names in the form of "*.<suffix>" (eg: *.airensoft.com) are stored in a trie of reversed labels (com -> airensoft)
+// - Other names containing wildcards (eg: *.airensoft.*, test?.airensoft.com) are matched with std::regex
+//
+// Like scanning all domains of all VirtualHosts in order, the domain added first wins if several domains match.
+//
+// The index is not modified after it is built, so it can be used by several threads without locking.
+class DomainIndex
+{
+public:
+	// Domains must be added in order of priority (the order of VirtualHost/Domain in Server.xml)
+	void Add(const ov::String &domain, const std::regex &regex_for_domain, const ov::String &vhost_name);
+
+	// Returns an empty string if there is no matching domain
+	ov::String Find(const ov::String &domain_name) const;
+
+	size_t GetCount() const
+	{
+		return _vhost_name_list.size();
+	}
+
+protected:
+	static constexpr size_t NoPriority = std::numeric_limits<size_t>::max();
+
+	struct Node
+	{
+		// key: label, value: index of _node_list
+		std::unordered_map<std::string_view, size_t> children;
+
+		// Priority of "*.<labels from the root to this node>"
+		size_t priority = NoPriority;
+	};
+
+	struct RegexItem
+	{
+		size_t priority;
+		std::regex regex;
+	};
+
+	std::string_view Store(const char *data, size_t length);
+
+	// Contains the strings referenced by std::string_view (std::deque never moves the items while appending)
+	std::deque<std::string> _storage;
+
+	// index: priority
+	std::vector<ov::String> _vhost_name_list;
+
+	// key: domain name, value: priority
+	std::unordered_map<std::string_view, size_t> _exact_map;
+
+	// _node_list[0] is the root
+	std::vector<Node> _node_list = std::vector<Node>(1);
+
+	// Priority of "*"
+	size_t _match_all_priority = NoPriority;
+
+	// Sorted by priority
+	std::vector<RegexItem> _regex_list;
+};
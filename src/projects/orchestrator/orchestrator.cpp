@@ -275,11 +275,31 @@ bool Orchestrator::ApplyOriginMap(const std::vector<info::Host> &host_list)
 		}
 	}
 
+	UpdateDomainIndex();
+
 	logtd("All items are applied");
 
 	return result;
 }
 
+void Orchestrator::UpdateDomainIndex()
+{
+	auto domain_index = std::make_shared<DomainIndex>();
+
+	// CAUTION: This code is important to order, so don't use _virtual_host_map
+	for (auto &vhost_item : _virtual_host_list)
+	{
+		for (auto &domain_item : vhost_item->domain_list)
+		{
+			domain_index->Add(domain_item.name, domain_item.regex_for_domain, vhost_item->name);
+		}
+	}
+
+	logtd("Domain index is updated: %zu domains", domain_index->GetCount());
+
+	std::atomic_store(&_domain_index, std::shared_ptr<const DomainIndex>(domain_index));
+}
+
 const std::vector<std::shared_ptr<Orchestrator::VirtualHost>> &Orchestrator::GetVirtualHostList()
 {
 	return _virtual_host_list;
@@ -533,24 +553,15 @@ bool Orchestrator::UnregisterModule(const std::shared_ptr<OrchestratorModuleInte
 
 ov::String Orchestrator::GetVhostNameFromDomain(const ov::String &domain_name)
 {
-	// TODO(dimiden): I think it would be nice to create a VHost cache for performance
-
 	if (domain_name.IsEmpty() == false)
 	{
-		auto scoped_lock = std::scoped_lock(_virtual_host_map_mutex);
-
 		// Search for the domain corresponding to domain_name
+		// (The index is never modified after it is published, so _virtual_host_map_mutex is not needed)
+		auto domain_index = std::atomic_load(&_domain_index);
 
-		// CAUTION: This code is important to order, so don't use _virtual_host_map
-		for (auto &vhost_item : _virtual_host_list)
+		if (domain_index != nullptr)
 		{
-			for (auto &domain_item : vhost_item->domain_list)
-			{
-				if (std::regex_match(domain_name.CStr(), domain_item.regex_for_domain))
-				{
-					return vhost_item->name;
-				}
-			}
+			return domain_index->Find(domain_name);
 		}
 	}
 
@@ -1042,6 +1053,8 @@ Orchestrator::Result Orchestrator::Release()
 	_virtual_host_list.clear();
 	_virtual_host_map.clear();
 
+	UpdateDomainIndex();
+
 	return Result::Succeeded;
 }
 
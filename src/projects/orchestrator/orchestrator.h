@@ -9,6 +9,7 @@
 #pragma once
 
 #include "data_structure.h"
+#include "domain_index.h"
 #include "base/info/host.h"
 #include <regex>
 
@@ -391,6 +392,9 @@ protected:
 
 	bool ApplyForVirtualHost(const std::shared_ptr<VirtualHost> &virtual_host);
 
+	// Rebuild _domain_index from _virtual_host_list (_virtual_host_map_mutex must be locked)
+	void UpdateDomainIndex();
+
 	/// Compares a list of domains and adds them to added_domain_list if a new entry is found
 	///
 	/// @param domain_list The domain list
@@ -449,4 +453,8 @@ protected:
 	std::map<ov::String, std::shared_ptr<VirtualHost>> _virtual_host_map;
 	// ordered vhost list
 	std::vector<std::shared_ptr<VirtualHost>> _virtual_host_list;
+
+	// Used to find the VirtualHost from the domain without locking _virtual_host_map_mutex
+	// (replaced as a whole by UpdateDomainIndex(), so use std::atomic_load()/std::atomic_store() to access it)
+	std::shared_ptr<const DomainIndex> _domain_index;
 };
\ No newline at end of file
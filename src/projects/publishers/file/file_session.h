@@ -21,7 +21,7 @@ public:
 	bool Start() override;
 	bool Stop() override;
 
-	bool SendOutgoingData(uint32_t packet_type, const std::shared_ptr<ov::Data> &packet) override;
+	bool SendOutgoingData(uint32_t packet_type, const std::shared_ptr<const ov::Data> &packet) override;
 	void OnPacketReceived(const std::shared_ptr<info::Session> &session_info,
 						const std::shared_ptr<const ov::Data> &data) override;
 
@@ -31,4 +31,6 @@ public:
 private:
 	std::shared_ptr<ov::Socket>		_connector;
 	bool 							_sent_ready;
+	// Reused for every packet to avoid the allocation
+	std::shared_ptr<ov::Data>		_send_buffer = std::make_shared<ov::Data>();
 };
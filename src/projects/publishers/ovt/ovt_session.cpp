@@ -48,7 +48,7 @@ bool OvtSession::Stop()
 	return Session::Stop();
 }
 
-bool OvtSession::SendOutgoingData(uint32_t packet_type, const std::shared_ptr<ov::Data> &packet)
+bool OvtSession::SendOutgoingData(uint32_t packet_type, const std::shared_ptr<const ov::Data> &packet)
 {
 	// packet_type in OvtSession means marker of OVT Packet
 	// OvtSession should send full packet so it will start to send from next packet of marker packet.
@@ -64,10 +64,20 @@ bool OvtSession::SendOutgoingData(uint32_t packet_type, const std::shared_ptr<ov
 
 	// Set OVT Session ID into packet
 	// It is also possible to use OvtPacket::Load, but for performance, as follows.
-	auto buffer = packet->GetWritableDataAs<uint8_t>();
+	// The packet is shared with the other sessions, so the session id is written into the scratch buffer of this session
+	if(packet->GetLength() < 16)
+	{
+		return false;
+	}
+
+	// Keeps the memory of the previous packet
+	_send_buffer->SetLength(0);
+	_send_buffer->Append(packet->GetData(), packet->GetLength());
+
+	auto buffer = _send_buffer->GetWritableDataAs<uint8_t>();
 	ByteWriter<uint32_t>::WriteBigEndian(&buffer[12], GetId());
 
-	_connector->Send(packet->GetData(), packet->GetLength());
+	_connector->Send(_send_buffer->GetData(), _send_buffer->GetLength());
 
 	return true;
 }
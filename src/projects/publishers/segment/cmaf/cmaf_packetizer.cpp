@@ -67,7 +67,7 @@ ov::String CmafPacketizer::GetFileName(int64_t start_timestamp, common::MediaTyp
 	return "";
 }
 
-bool CmafPacketizer::WriteVideoInit(const std::shared_ptr<ov::Data> &frame_data)
+bool CmafPacketizer::WriteVideoInit(const std::shared_ptr<PacketizerFrameData> &frame_data)
 {
 	return WriteVideoInitInternal(frame_data, CMAF_MPD_VIDEO_FULL_INIT_FILE_NAME);
 }
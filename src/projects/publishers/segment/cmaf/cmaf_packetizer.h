@@ -44,7 +44,7 @@ public:
 	//--------------------------------------------------------------------
 	// Override DashPacketizer
 	//--------------------------------------------------------------------
-	bool WriteVideoInit(const std::shared_ptr<ov::Data> &frame) override;
+	bool WriteVideoInit(const std::shared_ptr<PacketizerFrameData> &frame_data) override;
 	bool WriteAudioInit(const std::shared_ptr<ov::Data> &frame) override;
 
 	bool WriteVideoSegment() override;
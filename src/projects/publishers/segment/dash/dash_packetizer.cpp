@@ -15,6 +15,9 @@
 #include <numeric>
 #include <sstream>
 
+#include <modules/bitstream/h264/h264_nal_unit_types.h>
+#include <modules/bitstream/nalu/nal_unit_start_code_scanner.h>
+
 DashPacketizer::DashPacketizer(const ov::String &app_name, const ov::String &stream_name,
 							   PacketizerStreamType stream_type,
 							   const ov::String &segment_prefix,
@@ -140,8 +143,9 @@ ov::String DashPacketizer::GetFileName(int64_t start_timestamp, common::MediaTyp
 	return "";
 }
 
-bool DashPacketizer::WriteVideoInitInternal(const std::shared_ptr<ov::Data> &frame, const ov::String &init_file_name)
+bool DashPacketizer::WriteVideoInitInternal(const std::shared_ptr<PacketizerFrameData> &frame_data, const ov::String &init_file_name)
 {
+	const auto &frame = frame_data->data;
 	const uint8_t* srcData = frame->GetDataAs<uint8_t>();
 	size_t dataOffset = 0;
 	size_t dataSize = frame->GetLength();
@@ -153,26 +157,25 @@ bool DashPacketizer::WriteVideoInitInternal(const std::shared_ptr<ov::Data> &fra
 
 	// Stage 1 - Extract the Offset and Lengh value of the NAL Packet
 
-	while ( dataOffset < dataSize )
+	if (frame_data->nal_unit_index != nullptr)
 	{
-		size_t remainDataSize = dataSize - dataOffset;
-		const uint8_t* data = srcData + dataOffset;
-
-		if (remainDataSize >= 3 && 0x00 == data[0] && 0x00 == data[1] && 0x01 == data[2])
+		// MediaRouter already found the NAL units
+		for (const auto &nal_unit : frame_data->nal_unit_index->nal_units)
 		{
-			nal_packet_header_length = 3;
-			offset_list.emplace_back(dataOffset, 3); // Offset, SIZEOF(START_CODE[3])
-			dataOffset += 3;
+			nal_packet_header_length = nal_unit.start_code_length;
+			offset_list.emplace_back(nal_unit.offset - nal_unit.start_code_length, nal_unit.start_code_length);
 		}
-		else if (remainDataSize >= 4 && 0x00 == data[0] &&  0x00 == data[1] && 0x00 == data[2] && 0x01 == data[3])
-		{
-			nal_packet_header_length = 4;
-			offset_list.emplace_back(dataOffset, 4); // Offset, SIZEOF(START_CODE[4])
-			dataOffset += 4;
-		}
-		else
+	}
+	else
+	{
+		size_t start_code_offset = 0;
+		size_t start_code_length = 0;
+
+		while (NalUnitStartCodeScanner::Find(srcData, dataSize, dataOffset, start_code_offset, start_code_length))
 		{
-			dataOffset += 1;
+			nal_packet_header_length = start_code_length;
+			offset_list.emplace_back(start_code_offset, start_code_length); // Offset, SIZEOF(START_CODE)
+			dataOffset = start_code_offset + start_code_length;
 		}
 	}
 
@@ -322,9 +325,9 @@ bool DashPacketizer::WriteVideoInitInternal(const std::shared_ptr<ov::Data> &fra
 	return true;
 }
 
-bool DashPacketizer::WriteVideoInit(const std::shared_ptr<ov::Data> &frame)
+bool DashPacketizer::WriteVideoInit(const std::shared_ptr<PacketizerFrameData> &frame_data)
 {
-	return WriteVideoInitInternal(frame, DASH_MPD_VIDEO_FULL_INIT_FILE_NAME);
+	return WriteVideoInitInternal(frame_data, DASH_MPD_VIDEO_FULL_INIT_FILE_NAME);
 }
 
 bool DashPacketizer::WriteVideoSegment()
@@ -374,7 +377,7 @@ bool DashPacketizer::WriteVideoInitIfNeeded(std::shared_ptr<PacketizerFrameData>
 		return true;
 	}
 
-	if ((frame->type == PacketizerFrameType::VideoKeyFrame) && WriteVideoInit(frame->data))
+	if ((frame->type == PacketizerFrameType::VideoKeyFrame) && WriteVideoInit(frame))
 	{
 		_video_init = true;
 	}
@@ -392,22 +395,43 @@ bool DashPacketizer::AppendVideoFrameInternal(std::shared_ptr<PacketizerFrameDat
 	auto &data = frame->data;
 
 	// Calculate offset to skip NAL header
-	int offset = (frame->type == PacketizerFrameType::VideoKeyFrame) ? _avc_nal_header_size : GetStartPatternSize(data->GetDataAs<uint8_t>(), data->GetLength());
+	int offset = 0;
 
-	if (static_cast<int>(data->GetLength()) < offset)
+	if (frame->nal_unit_index != nullptr)
 	{
-		// Not enough data
-		logtw("Invalid frame: frame is too short: expected: %d, but %zu bytes", offset, data->GetLength());
-		return false;
-	}
+		// Skip the leading SPS/PPS of a key frame (they are in the init file), and the start code
+		for (const auto &nal_unit : frame->nal_unit_index->nal_units)
+		{
+			offset = static_cast<int>(nal_unit.offset);
 
-	if(frame->type == PacketizerFrameType::VideoKeyFrame)
+			if ((frame->type != PacketizerFrameType::VideoKeyFrame) ||
+				((nal_unit.type != static_cast<uint8_t>(H264NalUnitType::Sps)) && (nal_unit.type != static_cast<uint8_t>(H264NalUnitType::Pps))))
+			{
+				break;
+			}
+		}
+	}
+	else
 	{
-		offset += GetStartPatternSize(data->GetDataAs<uint8_t>() + offset, data->GetLength() - offset);
+		offset = (frame->type == PacketizerFrameType::VideoKeyFrame) ? _avc_nal_header_size : GetStartPatternSize(data->GetDataAs<uint8_t>(), data->GetLength());
+
+		if (static_cast<int>(data->GetLength()) < offset)
+		{
+			// Not enough data
+			logtw("Invalid frame: frame is too short: expected: %d, but %zu bytes", offset, data->GetLength());
+			return false;
+		}
+
+		if (frame->type == PacketizerFrameType::VideoKeyFrame)
+		{
+			offset += GetStartPatternSize(data->GetDataAs<uint8_t>() + offset, data->GetLength() - offset);
+		}
 	}
 
 	// Skip NAL header
 	data = data->Subdata(offset);
+	// The offsets of the index don't match the data anymore
+	frame->nal_unit_index = nullptr;
 
 	// 8.8.3 Track Extends Box
 	// The sample flags field in sample fragments (default_sample_flags here and in a Track Fragment Header Box,
@@ -823,12 +847,17 @@ bool DashPacketizer::UpdatePlayList()
 	}
 
 	play_list_stream << "\t</Period>\n"
-					 << "\t<UTCTiming schemeIdUri=\"urn:mpeg:dash:utc:direct:2014\" value=\"%s\"/>\n"
+					 << "\t<UTCTiming schemeIdUri=\"urn:mpeg:dash:utc:direct:2014\" value=\"";
+
+	// The current time is inserted here whenever the playlist is requested
+	auto current_time_offset = static_cast<ssize_t>(play_list_stream.tellp());
+
+	play_list_stream << "\"/>\n"
 					 << "</MPD>\n";
 
 	ov::String play_list = play_list_stream.str().c_str();
 
-	SetPlayList(play_list);
+	SetPlayList(play_list, current_time_offset);
 
 	if(_stat_stop_watch.IsElapsed(5000) && _stat_stop_watch.Update())
 	{
@@ -966,18 +995,3 @@ void DashPacketizer::SetReadyForStreaming() noexcept
 
 	Packetizer::SetReadyForStreaming();
 }
-
-bool DashPacketizer::GetPlayList(ov::String &play_list)
-{
-	if (IsReadyForStreaming() == false)
-	{
-		logtd("A playlist was requested before the stream began");
-		return false;
-	}
-
-	ov::String current_time = MakeUtcMillisecond();
-
-	play_list = ov::String::FormatString(_play_list.CStr(), current_time.CStr());
-
-	return true;
-}
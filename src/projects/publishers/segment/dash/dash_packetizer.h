@@ -47,8 +47,6 @@ public:
 	const std::shared_ptr<SegmentData> GetSegmentData(const ov::String &file_name) override;
 	bool SetSegmentData(ov::String file_name, uint64_t duration, int64_t timestamp, std::shared_ptr<ov::Data> &data) override;
 
-	bool GetPlayList(ov::String &play_list) override;
-
 protected:
 	using DataCallback = std::function<void(const std::shared_ptr<const SampleData> &data, bool new_segment_written)>;
 
@@ -57,8 +55,8 @@ protected:
 	// start_timestamp: a timestamp of the first frame of the segment
 	virtual ov::String GetFileName(int64_t start_timestamp, common::MediaType media_type) const;
 
-	bool WriteVideoInitInternal(const std::shared_ptr<ov::Data> &frame, const ov::String &init_file_name);
-	virtual bool WriteVideoInit(const std::shared_ptr<ov::Data> &frame);
+	bool WriteVideoInitInternal(const std::shared_ptr<PacketizerFrameData> &frame_data, const ov::String &init_file_name);
+	virtual bool WriteVideoInit(const std::shared_ptr<PacketizerFrameData> &frame_data);
 	virtual bool WriteVideoSegment();
 	bool WriteVideoInitIfNeeded(std::shared_ptr<PacketizerFrameData> &frame);
 	// Enqueues the video frame, and call the data_callback if a new segment is created
@@ -63,7 +63,7 @@ bool DashStreamPacketizer::AppendAudioFrame(std::shared_ptr<PacketizerFrameData>
 // Get PlayList
 // - MPD
 //====================================================================================================
-bool DashStreamPacketizer::GetPlayList(ov::String &play_list)
+bool DashStreamPacketizer::GetPlayList(std::shared_ptr<const PlayListData> &play_list)
 {
 	return _packetizer->GetPlayList(play_list);
 }
@@ -85,7 +85,7 @@ bool SegmentPublisher::GetMonitoringCollectionData(std::vector<std::shared_ptr<p
 bool SegmentPublisher::OnPlayListRequest(const std::shared_ptr<HttpClient> &client,
 										 const ov::String &app_name, const ov::String &stream_name,
 										 const ov::String &file_name,
-										 ov::String &play_list)
+										 std::shared_ptr<const PlayListData> &play_list)
 {
 	auto request = client->GetRequest();
 	auto uri = request->GetUri();
@@ -11,7 +11,9 @@
 
 #include <sys/time.h>
 #include <algorithm>
+#include <functional>
 #include <sstream>
+#include <string_view>
 
 Packetizer::Packetizer(const ov::String &app_name, const ov::String &stream_name,
 					   PacketizerType packetizer_type, PacketizerStreamType stream_type,
@@ -134,11 +136,44 @@ uint64_t Packetizer::ConvertTimeScale(uint64_t time, const common::Timebase &fro
 	return (uint64_t)((double)time * ratio);
 }
 
-void Packetizer::SetPlayList(ov::String &play_list)
+void Packetizer::SetPlayList(const ov::String &play_list, ssize_t current_time_offset)
 {
+	std::shared_ptr<const ov::Data> data;
+	std::shared_ptr<const ov::Data> data_after_current_time;
+	ov::String etag;
+	ov::String header;
+
+	if ((current_time_offset >= 0L) && (static_cast<size_t>(current_time_offset) <= play_list.GetLength()))
+	{
+		data = std::make_shared<ov::Data>(play_list.CStr(), current_time_offset);
+		data_after_current_time = std::make_shared<ov::Data>(play_list.CStr() + current_time_offset, play_list.GetLength() - current_time_offset);
+	}
+	else
+	{
+		data = play_list.ToData(false);
+
+		// The playlist is identified by its contents, so the ETag remains valid even if the stream is restarted
+		auto hash = std::hash<std::string_view>()(std::string_view(play_list.CStr(), play_list.GetLength()));
+		etag.Format("\"%zx-%zx\"", play_list.GetLength(), hash);
+	}
+
+	// The headers are the same for all responses of this playlist, so they are serialized only once
+	if (etag.IsEmpty())
+	{
+		header = "Cache-Control: no-cache, no-store, must-revalidate\r\n";
+	}
+	else
+	{
+		// The player may keep the playlist, but must revalidate it with If-None-Match
+		header.Format("Cache-Control: no-cache\r\nETag: %s\r\n", etag.CStr());
+	}
+
+	header.Append("Pragma: no-cache\r\nExpires: 0\r\n");
+
 	std::unique_lock<std::mutex> lock(_play_list_guard);
 
-	_play_list = play_list;
+	_play_list_version++;
+	_play_list = std::make_shared<PlayListData>(_play_list_version, etag, header.ToData(false), data, data_after_current_time);
 }
 
 bool Packetizer::IsReadyForStreaming() const noexcept
@@ -151,13 +186,14 @@ void Packetizer::SetReadyForStreaming() noexcept
 	_streaming_start = true;
 }
 
-bool Packetizer::GetPlayList(ov::String &play_list)
+bool Packetizer::GetPlayList(std::shared_ptr<const PlayListData> &play_list)
 {
 	if (IsReadyForStreaming() == false)
 	{
 		return false;
 	}
 
+	// Only the pointer is copied while locking - the playlist is not modified once it is published
 	std::unique_lock<std::mutex> lock(_play_list_guard);
 
 	play_list = _play_list;
@@ -44,10 +44,12 @@ public:
 	//   +--------+---------+--------+-----------+
 	static uint64_t ConvertTimeScale(uint64_t time, const common::Timebase &from_timebase, const common::Timebase &to_timebase);
 
-	void SetPlayList(ov::String &play_list);
+	// Render the playlist into PlayListData, and publish it
+	// (current_time_offset: The position where the current time is inserted when responding, -1 if not needed)
+	void SetPlayList(const ov::String &play_list, ssize_t current_time_offset = -1L);
 
 	virtual bool IsReadyForStreaming() const noexcept;
-	virtual bool GetPlayList(ov::String &play_list);
+	virtual bool GetPlayList(std::shared_ptr<const PlayListData> &play_list);
 
 	bool GetVideoPlaySegments(std::vector<std::shared_ptr<SegmentData>> &segment_datas);
 	bool GetAudioPlaySegments(std::vector<std::shared_ptr<SegmentData>> &segment_datas);
@@ -78,7 +80,9 @@ protected:
 
 	uint32_t _sequence_number = 1U;
 	bool _streaming_start = false;
-	ov::String _play_list;
+	// The latest playlist (replaced as a whole by SetPlayList())
+	std::shared_ptr<const PlayListData> _play_list;
+	uint32_t _play_list_version = 0U;
 
 	bool _video_init = false;
 	bool _audio_init = false;
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <base/ovlibrary/ovlibrary.h>
+#include <base/mediarouter/media_buffer.h>
 #include <base/mediarouter/media_type.h>
 
 #include <string.h>
@@ -85,6 +86,42 @@ public:
 	std::shared_ptr<ov::Data> data;
 };
 
+// A playlist rendered by the packetizer
+// - It is published as a whole whenever the playlist is updated, and is never modified after that,
+//   so the responses can share it without copying
+struct PlayListData
+{
+public:
+	PlayListData(uint32_t version, const ov::String &etag,
+				 const std::shared_ptr<const ov::Data> &header,
+				 const std::shared_ptr<const ov::Data> &data,
+				 const std::shared_ptr<const ov::Data> &data_after_current_time = nullptr)
+		: version(version),
+		  etag(etag),
+		  header(header),
+		  data(data),
+		  data_after_current_time(data_after_current_time)
+	{
+	}
+
+	// If the playlist contains the current time of the server (such as <UTCTiming> of MPD),
+	// the response is [data] + [current time] + [data_after_current_time]
+	bool HasCurrentTime() const
+	{
+		return data_after_current_time != nullptr;
+	}
+
+public:
+	// Increased whenever the playlist is updated
+	uint32_t version = 0U;
+	// Entity tag of the playlist (empty if the playlist contains the current time)
+	ov::String etag;
+	// Serialized header fields of the response ("<name>: <value>\r\n"...), except Content-Type and Content-Length
+	std::shared_ptr<const ov::Data> header;
+	std::shared_ptr<const ov::Data> data;
+	std::shared_ptr<const ov::Data> data_after_current_time;
+};
+
 enum class PacketizerFrameType
 {
 	Unknown = 'U',
@@ -131,6 +168,8 @@ struct PacketizerFrameData
 	uint64_t duration = 0ULL;
 	common::Timebase timebase;
 	std::shared_ptr<ov::Data> data;
+	// NAL units of the video data, which are found by MediaRouter (nullptr if unknown)
+	std::shared_ptr<const NalUnitIndex> nal_unit_index;
 };
 
 #pragma pack(pop)
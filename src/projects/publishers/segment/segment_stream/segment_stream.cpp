@@ -143,7 +143,7 @@ void SegmentStream::SendAudioFrame(const std::shared_ptr<MediaPacket> &media_pac
 // GetPlayList
 // - M3U8/MPD
 //====================================================================================================
-bool SegmentStream::GetPlayList(ov::String &play_list)
+bool SegmentStream::GetPlayList(std::shared_ptr<const PlayListData> &play_list)
 {
 	if (_stream_packetizer != nullptr)
 	{
@@ -31,7 +31,7 @@ public :
     bool Start(int segment_count, int segment_duration, uint32_t worker_count);
     bool Stop() override;
 
-    bool GetPlayList(ov::String &play_list);
+    bool GetPlayList(std::shared_ptr<const PlayListData> &play_list);
 	std::shared_ptr<SegmentData> GetSegmentData(const ov::String &file_name);
     virtual std::shared_ptr<StreamPacketizer> CreateStreamPacketizer(int segment_count,
                                                                     int segment_duration,
@@ -313,9 +313,30 @@ bool SegmentStreamServer::ProcessRequest(const std::shared_ptr<HttpClient> &clie
 			SetAllowOrigin(origin_url, response);
 		}
 
-		auto host_name = request->GetHeader("HOST").Split(":")[0];
+		// Remove the port from "<host>:<port>"
+		auto host_name = request->GetHeader("HOST");
+		auto colon_index = host_name.IndexOf(':');
+
+		if (colon_index >= 0)
+		{
+			host_name.SetLength(colon_index);
+		}
+
 		ov::String internal_app_name = Orchestrator::GetInstance()->ResolveApplicationNameFromDomain(host_name, app_name);
 
+		if (client->IsSendQueueCongested())
+		{
+			// The previous responses are still in the send queue, so the player is asked to retry later instead of piling up more segments
+			logtd("The client(%s) is too slow to receive %s/%s/%s", client->GetRequest()->GetRemote()->ToString().CStr(), internal_app_name.CStr(), stream_name.CStr(), file_name.CStr());
+
+			response->SetStatusCode(HttpStatusCode::ServiceUnavailable);
+			response->SetHeader("Retry-After", "1");
+			response->Response();
+
+			connetion = HttpConnection::KeepAlive;
+			break;
+		}
+
 		connetion = ProcessStreamRequest(client, internal_app_name, stream_name, file_name, file_ext);
 	} while (false);
 
@@ -365,6 +386,35 @@ bool SegmentStreamServer::SetAllowOrigin(const ov::String &origin_url, const std
 	return true;
 }
 
+uint32_t SegmentStreamServer::ResponsePlayList(const std::shared_ptr<HttpClient> &client, const std::shared_ptr<const PlayListData> &play_list)
+{
+	auto response = client->GetResponse();
+
+	// The headers are serialized by the packetizer when the playlist is updated
+	response->SetPrebuiltHeader(play_list->header);
+
+	if ((play_list->etag.IsEmpty() == false) && (client->GetRequest()->GetHeader("If-None-Match").IndexOf(play_list->etag) >= 0))
+	{
+		// The player already has this playlist
+		response->SetStatusCode(HttpStatusCode::NotModified);
+		return response->Response();
+	}
+
+	// The playlist is shared with the packetizer and other responses, so it is sent without copying
+	if (play_list->HasCurrentTime())
+	{
+		response->AppendData(play_list->data);
+		response->AppendString(Packetizer::MakeUtcMillisecond());
+		response->AppendData(play_list->data_after_current_time);
+	}
+	else
+	{
+		response->AppendData(play_list->data);
+	}
+
+	return response->Response();
+}
+
 //====================================================================================================
 // SetCrossDomain Parsing/Setting
 //  crossdoamin : only domain
@@ -59,6 +59,10 @@ protected:
 
 	bool SetAllowOrigin(const ov::String &origin_url, const std::shared_ptr<HttpResponse> &response);
 
+	// Send the playlist published by the packetizer (Content-Type must be set before calling this)
+	// If the player already has the playlist (If-None-Match), 304 is sent without the playlist
+	uint32_t ResponsePlayList(const std::shared_ptr<HttpClient> &client, const std::shared_ptr<const PlayListData> &play_list);
+
 	// Interfaces
 	virtual HttpConnection ProcessStreamRequest(const std::shared_ptr<HttpClient> &client,
 												const ov::String &app_name, const ov::String &stream_name,
@@ -39,6 +39,7 @@ bool StreamPacketizer::AppendVideoData(const std::shared_ptr<MediaPacket> &media
 	PacketizerFrameType packetizer_frame_type = (frame_type == FrameType::VideoFrameKey) ? PacketizerFrameType::VideoKeyFrame : PacketizerFrameType::VideoPFrame;
 
 	auto frame_data = std::make_shared<PacketizerFrameData>(packetizer_frame_type, media_packet->GetPts(), media_packet->GetDts(), duration, _video_track->GetTimeBase(), buffer);
+	frame_data->nal_unit_index = media_packet->GetNalUnitIndex();
 
 	AppendVideoFrame(frame_data);
 
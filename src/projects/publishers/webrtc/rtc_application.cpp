@@ -44,7 +44,11 @@ std::shared_ptr<pub::Stream> RtcApplication::CreateStream(const std::shared_ptr<
 		// RtcStream should have worker threads.
 		worker_count = MIN_STREAM_WORKER_THREAD_COUNT;
 	}
-	return RtcStream::Create(GetSharedPtrAs<pub::Application>(), *info, worker_count);
+
+	auto webrtc_config = GetPublisher<cfg::WebrtcPublisher>();
+	bool session_sharding = (webrtc_config != nullptr) && webrtc_config->IsSessionSharding();
+
+	return RtcStream::Create(GetSharedPtrAs<pub::Application>(), *info, worker_count, session_sharding);
 }
 
 bool RtcApplication::DeleteStream(const std::shared_ptr<info::Stream> &info)
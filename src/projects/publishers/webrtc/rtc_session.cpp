@@ -4,6 +4,10 @@
 #include "rtc_application.h"
 #include "rtc_stream.h"
 
+#include <base/ovlibrary/byte_io.h>
+
+#include <algorithm>
+#include <chrono>
 #include <utility>
 
 std::shared_ptr<RtcSession> RtcSession::Create(const std::shared_ptr<pub::Application> &application,
@@ -107,6 +111,42 @@ bool RtcSession::Start()
     // RTP RTCP 생성
 	_rtp_rtcp = std::make_shared<RtpRtcp>((uint32_t)pub::SessionNodeType::Rtp, session, ssrc_list);
 
+	// Lost video packets are retransmitted when NACK is received (with RTX if the peer accepted it)
+	auto stream = std::static_pointer_cast<RtcStream>(GetStream());
+	for(size_t i = 0; i < peer_media_desc_list.size(); i++)
+	{
+		if(peer_media_desc_list[i]->GetMediaType() != MediaDescription::MediaType::Video)
+		{
+			continue;
+		}
+
+		_video_offer_media_desc = offer_media_desc_list[i];
+		_video_peer_media_desc = peer_media_desc_list[i];
+
+		auto video_track_payload_type = GetVideoTrackPayloadType();
+		auto history = stream->GetPacketHistory(video_track_payload_type, _video_payload_type == RED_PAYLOAD_TYPE);
+		if(history != nullptr)
+		{
+			_rtp_rtcp->SetRetransmission(_video_offer_media_desc->GetSsrc(), history, GetNegotiatedRtxPayloadType(video_track_payload_type), _video_offer_media_desc->GetRtxSsrc());
+		}
+
+		// Renditions the peer can decode
+		for(const auto &rendition : stream->GetVideoRenditions())
+		{
+			if(_video_peer_media_desc->GetPayload(rendition.first) != nullptr)
+			{
+				// The bitrate of a bypassed track is unknown, it is regarded as the highest
+				_video_renditions.emplace_back(rendition.first, (rendition.second > 0) ? rendition.second : UINT64_MAX);
+			}
+		}
+
+		std::sort(_video_renditions.begin(), _video_renditions.end(), [](const std::pair<uint8_t, uint64_t> &a, const std::pair<uint8_t, uint64_t> &b) {
+			return a.second > b.second;
+		});
+
+		break;
+	}
+
 	// SRTP 생성
 	_srtp_transport = std::make_shared<SrtpTransport>((uint32_t)pub::SessionNodeType::Srtp, session);
 
@@ -119,6 +159,25 @@ bool RtcSession::Start()
 	// ICE-DTLS 생성
 	_dtls_ice_transport = std::make_shared<DtlsIceTransport>((uint32_t)pub::SessionNodeType::Ice, session, _ice_port);
 
+	auto webrtc_config = application->GetPublisher<cfg::WebrtcPublisher>();
+	if((webrtc_config != nullptr) && (webrtc_config->GetPacingMultiplier() > 0.0f))
+	{
+		// A sharded session is paced on its own shard (the same one as its StreamWorker, see pub::Stream::Start())
+		auto executor = GetStream()->IsSessionSharded() ? ov::Executor::GetShard(GetId()) : nullptr;
+		_dtls_ice_transport->EnablePacing(webrtc_config->GetPacingMultiplier(), webrtc_config->GetMaxPacingDelay(), executor);
+	}
+
+	if(_video_payload_type == RED_PAYLOAD_TYPE)
+	{
+		_adaptive_fec = (webrtc_config != nullptr) && webrtc_config->IsAdaptiveFec();
+		_disable_fec_on_clean_path = (webrtc_config != nullptr) && webrtc_config->IsDisableFecOnCleanPath();
+
+		// Protected with the lowest level until the receiver reports of the peer come
+		_ulpfec_protection_level = UlpfecProtectionLevel::Low;
+		_ulpfec_level_changed_time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		stream->UpdateUlpfecProtectionLevel(UlpfecProtectionLevel::None, UlpfecProtectionLevel::Low);
+	}
+
 	// 노드를 연결한다.
 	_rtp_rtcp->RegisterUpperNode(nullptr);
 	_rtp_rtcp->RegisterLowerNode(_srtp_transport);
@@ -145,6 +204,15 @@ bool RtcSession::Stop()
 		return true;
 	}
 
+	{
+		std::lock_guard<std::mutex> lock_guard(_ulpfec_mutex);
+
+		// The stream doesn't generate FEC for this session anymore
+		std::static_pointer_cast<RtcStream>(GetStream())->UpdateUlpfecProtectionLevel(_ulpfec_protection_level, UlpfecProtectionLevel::None);
+		_ulpfec_protection_level = UlpfecProtectionLevel::None;
+		_ulpfec_released = true;
+	}
+
 	// 연결된 세션을 정리한다.
 	if(_rtp_rtcp != nullptr)
 	{
@@ -193,27 +261,272 @@ void RtcSession::OnPacketReceived(const std::shared_ptr<info::Session> &session_
 	_dtls_ice_transport->OnDataReceived(pub::SessionNodeType::None, data);
 }
 
-bool RtcSession::SendOutgoingData(uint32_t packet_type, const std::shared_ptr<ov::Data> &packet)
+bool RtcSession::SendOutgoingData(uint32_t packet_type, const std::shared_ptr<const ov::Data> &packet)
 {
 	auto rtp_payload_type = static_cast<uint8_t>(packet_type & 0xFF);
 	auto red_block_pt = static_cast<uint8_t>((packet_type & 0xFF00) >> 8);
 	auto origin_pt_of_fec = static_cast<uint8_t>((packet_type & 0xFF0000) >> 16);
 
-	if(rtp_payload_type != _video_payload_type && rtp_payload_type != _audio_payload_type)
+	if(rtp_payload_type == _audio_payload_type)
 	{
-		return false;
+		_sent_bytes += packet->GetLength();
+
+		return _rtp_rtcp->SendOutgoingData(packet);
 	}
 
+	// Video
+	bool use_red = (_video_payload_type == RED_PAYLOAD_TYPE);
+	uint8_t track_payload_type = 0;
+
 	if(rtp_payload_type == RED_PAYLOAD_TYPE)
 	{
+		if(use_red == false)
+		{
+			return false;
+		}
+
 		// When red_block_pt is ULPFEC_PAYLOAD_TYPE, origin_pt_of_fec is origin media payload type.
-		if(red_block_pt != _red_block_pt && origin_pt_of_fec != _red_block_pt)
+		track_payload_type = (red_block_pt == ULPFEC_PAYLOAD_TYPE) ? origin_pt_of_fec : red_block_pt;
+	}
+	else
+	{
+		if(use_red)
+		{
+			return false;
+		}
+
+		track_payload_type = rtp_payload_type;
+	}
+
+	if(packet->GetLength() < FIXED_HEADER_SIZE)
+	{
+		return false;
+	}
+
+	auto sequence_number = ByteReader<uint16_t>::ReadBigEndian(packet->GetDataAs<uint8_t>() + 2);
+
+	if(track_payload_type != GetVideoTrackPayloadType())
+	{
+		// The other rendition, which can be switched to at its keyframe
+		if(((packet_type & RTC_PACKET_TYPE_KEYFRAME_START) == 0) || (SelectVideoRendition() != track_payload_type))
 		{
 			return false;
 		}
+
+		SwitchVideoRendition(track_payload_type, sequence_number);
+	}
+
+	bool is_fec_packet = (rtp_payload_type == RED_PAYLOAD_TYPE) && (red_block_pt == ULPFEC_PAYLOAD_TYPE);
+
+	if(use_red)
+	{
+		UpdateUlpfecProtectionLevel();
+
+		if(is_fec_packet)
+		{
+			if(ShouldSendFecPacket() == false)
+			{
+				// The following packets are renumbered, so the peer doesn't see a gap of the sequence numbers.
+				// Consecutive skips start from the same sequence number, so the change is given to RtpRtcp once before the next packet is sent.
+				_video_sequence_number_offset--;
+				_pending_offset_start = static_cast<uint16_t>(sequence_number + 1 + _video_sequence_number_offset);
+				_has_pending_offset_change = true;
+
+				return true;
+			}
+		}
+		else
+		{
+			_ulpfec_media_packet_count++;
+			_fec_sn_base_offset = _video_sequence_number_offset;
+		}
+	}
+
+	if(_has_pending_offset_change)
+	{
+		_rtp_rtcp->ChangeSequenceNumberOffset(_video_offer_media_desc->GetSsrc(), _video_sequence_number_offset, _pending_offset_start);
+		_has_pending_offset_change = false;
+	}
+
+	// The packet is shared with the other sessions, so the sequence numbers are rewritten in the copy which SRTP protects
+	RtpPacketRewrite rewrite;
+	rewrite.sequence_number_offset = _video_sequence_number_offset;
+
+	if(is_fec_packet)
+	{
+		// SN base of the FEC header (RFC 5109), which follows the RED header.
+		// It is the first protected media packet, which was sent before the FEC packets of the frame were skipped.
+		size_t fec_header_offset = FIXED_HEADER_SIZE + ((packet->GetDataAs<uint8_t>()[0] & 0x0F) * 4) + RED_HEADER_SIZE;
+
+		if(fec_header_offset + 4 <= packet->GetLength())
+		{
+			rewrite.sn_base_position = fec_header_offset + 2;
+			rewrite.sn_base_offset = _fec_sn_base_offset;
+		}
 	}
 
+	_last_video_sequence_number = static_cast<uint16_t>(sequence_number + _video_sequence_number_offset);
 	_sent_bytes += packet->GetLength();
 
-	return _rtp_rtcp->SendOutgoingData(packet);
-}
\ No newline at end of file
+	return _rtp_rtcp->SendOutgoingData(packet, rewrite.IsEmpty() ? nullptr : &rewrite);
+}
+
+const BandwidthEstimator &RtcSession::GetBandwidthEstimator() const
+{
+	return _rtp_rtcp->GetBandwidthEstimator();
+}
+
+uint8_t RtcSession::GetVideoTrackPayloadType() const
+{
+	return (_video_payload_type == RED_PAYLOAD_TYPE) ? _red_block_pt : _video_payload_type;
+}
+
+uint8_t RtcSession::SelectVideoRendition() const
+{
+	auto estimated_bitrate = _rtp_rtcp->GetBandwidthEstimator().GetEstimatedBitrate();
+
+	if((estimated_bitrate == 0) || (_video_renditions.size() < 2))
+	{
+		return GetVideoTrackPayloadType();
+	}
+
+	auto available_bitrate = estimated_bitrate * RTC_SESSION_RENDITION_BANDWIDTH_PERCENT / 100;
+
+	for(const auto &rendition : _video_renditions)
+	{
+		if(rendition.second <= available_bitrate)
+		{
+			return rendition.first;
+		}
+	}
+
+	// Even the lowest one doesn't fit
+	return _video_renditions.back().first;
+}
+
+void RtcSession::SwitchVideoRendition(uint8_t payload_type, uint16_t sequence_number)
+{
+	auto previous_payload_type = GetVideoTrackPayloadType();
+	bool use_red = (_video_payload_type == RED_PAYLOAD_TYPE);
+
+	if(use_red)
+	{
+		_red_block_pt = payload_type;
+	}
+	else
+	{
+		_video_payload_type = payload_type;
+	}
+
+	if(_last_video_sequence_number >= 0)
+	{
+		_video_sequence_number_offset = static_cast<uint16_t>(_last_video_sequence_number + 1 - sequence_number);
+	}
+
+	// SetRetransmission() replaces the changes of the previous rendition
+	_has_pending_offset_change = false;
+
+	auto stream = std::static_pointer_cast<RtcStream>(GetStream());
+	auto history = stream->GetPacketHistory(payload_type, use_red);
+	if(history != nullptr)
+	{
+		_rtp_rtcp->SetRetransmission(_video_offer_media_desc->GetSsrc(), history, GetNegotiatedRtxPayloadType(payload_type), _video_offer_media_desc->GetRtxSsrc(),
+									 _video_sequence_number_offset, static_cast<uint16_t>(sequence_number + _video_sequence_number_offset));
+	}
+
+	const auto &estimator = _rtp_rtcp->GetBandwidthEstimator();
+	logti("RtcSession(%u) switches the video rendition (pt: %d -> %d) - estimated: %llu bps, sending: %llu bps, loss: %.1f%%, rtt: %lld ms",
+		  GetId(), previous_payload_type, payload_type,
+		  estimator.GetEstimatedBitrate(), estimator.GetSendingBitrate(), estimator.GetLossRate() * 100.0, estimator.GetRttMs());
+}
+
+void RtcSession::UpdateUlpfecProtectionLevel()
+{
+	if(_adaptive_fec == false)
+	{
+		return;
+	}
+
+	auto level = UlpfecGenerator::GetProtectionLevel(_rtp_rtcp->GetBandwidthEstimator().GetLossRate(), _disable_fec_on_clean_path);
+	auto current_level = _ulpfec_protection_level.load();
+
+	if(level == current_level)
+	{
+		return;
+	}
+
+	auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+	// Raised immediately, but lowered only when the loss has been low for a while
+	if((level < current_level) && ((now_ms - _ulpfec_level_changed_time_ms) < RTC_SESSION_FEC_LEVEL_HOLD_MS))
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock_guard(_ulpfec_mutex);
+
+	if(_ulpfec_released)
+	{
+		return;
+	}
+
+	std::static_pointer_cast<RtcStream>(GetStream())->UpdateUlpfecProtectionLevel(current_level, level);
+	_ulpfec_protection_level = level;
+	_ulpfec_level_changed_time_ms = now_ms;
+
+	logtd("RtcSession(%u) changes the FEC protection level: %d -> %d (loss: %.1f%%)",
+		  GetId(), static_cast<int>(current_level), static_cast<int>(level), _rtp_rtcp->GetBandwidthEstimator().GetLossRate() * 100.0);
+}
+
+bool RtcSession::ShouldSendFecPacket()
+{
+	auto level = _ulpfec_protection_level.load();
+
+	if(level == UlpfecProtectionLevel::None)
+	{
+		return false;
+	}
+
+	auto stream_level = std::static_pointer_cast<RtcStream>(GetStream())->GetUlpfecProtectionLevel();
+
+	// The FEC packets of the stream protect fewer media packets than this session needs, so some of them are skipped
+	if((level < stream_level) && (_ulpfec_media_packet_count < UlpfecGenerator::GetMediaPacketCountPerFec(level)))
+	{
+		return false;
+	}
+
+	_ulpfec_media_packet_count = 0;
+
+	return true;
+}
+
+uint8_t RtcSession::GetNegotiatedRtxPayloadType(uint8_t payload_type)
+{
+	auto stream = std::static_pointer_cast<RtcStream>(GetStream());
+
+	// RED packets are retransmitted as they are, so RTX is associated with RED
+	auto rtx_payload_type = stream->GetRtxPayloadType((_video_payload_type == RED_PAYLOAD_TYPE) ? RED_PAYLOAD_TYPE : payload_type);
+
+	if((rtx_payload_type != 0) && (_video_peer_media_desc->GetPayload(rtx_payload_type) == nullptr))
+	{
+		// The peer doesn't support RTX, the packets are retransmitted as they are
+		return 0;
+	}
+
+	return rtx_payload_type;
+}
+
+bool RtcSession::SendOutgoingBatch(const std::vector<std::pair<uint32_t, std::shared_ptr<const ov::Data>>> &packet_list)
+{
+	if(_dtls_ice_transport == nullptr)
+	{
+		return Session::SendOutgoingBatch(packet_list);
+	}
+
+	// The packets encrypted by SRTP are collected in DtlsIceTransport, and sent at once
+	_dtls_ice_transport->BeginBatch();
+
+	bool result = Session::SendOutgoingBatch(packet_list);
+
+	return _dtls_ice_transport->FlushBatch() && result;
+}
@@ -10,6 +10,13 @@
 #include "modules/rtp_rtcp/rtp_rtcp_interface.h"
 #include "modules/dtls_srtp/dtls_transport.h"
 #include <unordered_set>
+#include <atomic>
+#include <mutex>
+
+// A rendition is selected if its bitrate is lower than this percent of the estimated bandwidth
+#define RTC_SESSION_RENDITION_BANDWIDTH_PERCENT	85
+// The FEC protection level is lowered only if it has not been changed for this time (ms), so it doesn't flap with the loss
+#define RTC_SESSION_FEC_LEVEL_HOLD_MS			5000
 
 /*
  *
@@ -67,10 +74,30 @@ public:
 	const std::shared_ptr<const SessionDescription>& GetOfferSDP() const;
 	const std::shared_ptr<WebSocketClient>& GetWSClient();
 
-	bool SendOutgoingData(uint32_t packet_type, const std::shared_ptr<ov::Data> &packet) override;
+	bool SendOutgoingData(uint32_t packet_type, const std::shared_ptr<const ov::Data> &packet) override;
+	// RTP 패킷들을 SRTP로 암호화 한 후, IcePort를 통해 한번에 전송한다.
+	bool SendOutgoingBatch(const std::vector<std::pair<uint32_t, std::shared_ptr<const ov::Data>>> &packet_list) override;
 	void OnPacketReceived(const std::shared_ptr<info::Session> &session_info, const std::shared_ptr<const ov::Data> &data) override;
 
+	// Bandwidth, loss and RTT of the path to the peer
+	const BandwidthEstimator &GetBandwidthEstimator() const;
+	// Payload type of the video track (rendition) which is being sent
+	uint8_t GetVideoTrackPayloadType() const;
+
 private:
+	// Returns the rendition which fits the estimated bandwidth
+	uint8_t SelectVideoRendition() const;
+	// Switches to the rendition at the first packet of its keyframe.
+	// The sequence numbers continue from the previous rendition, so the peer sees one RTP stream.
+	void SwitchVideoRendition(uint8_t payload_type, uint16_t sequence_number);
+	uint8_t GetNegotiatedRtxPayloadType(uint8_t payload_type);
+
+	// Requests the FEC protection level for the loss of the path to the stream
+	void UpdateUlpfecProtectionLevel();
+	// The stream generates FEC for the session which loses the most packets,
+	// so the sessions with less loss send only some of the FEC packets.
+	bool ShouldSendFecPacket();
+
 	std::shared_ptr<RtpRtcp>            _rtp_rtcp;
 	std::shared_ptr<SrtpTransport>      _srtp_transport;
 	std::shared_ptr<DtlsTransport>      _dtls_transport;
@@ -84,4 +111,31 @@ private:
 	uint8_t 							_red_block_pt = 0;
 	uint8_t                             _video_payload_type = 0;
 	uint8_t                             _audio_payload_type = 0;
+
+	std::shared_ptr<const MediaDescription> _video_offer_media_desc;
+	std::shared_ptr<const MediaDescription> _video_peer_media_desc;
+	// Renditions accepted by the peer, ordered by bitrate from the highest (payload type, bitrate)
+	std::vector<std::pair<uint8_t, uint64_t>> _video_renditions;
+
+	// Added to the sequence numbers of the video packets after the rendition is switched
+	uint16_t							_video_sequence_number_offset = 0;
+	int32_t								_last_video_sequence_number = -1;
+	// The offset was changed by the skipped packets, from _pending_offset_start (given to RtpRtcp before the next packet is sent)
+	bool								_has_pending_offset_change = false;
+	uint16_t							_pending_offset_start = 0;
+
+	// Whether the FEC protection level follows the loss (otherwise it stays at Low)
+	bool								_adaptive_fec = false;
+	// Whether the adaptive level is None while the path has no loss (otherwise it is at least Low)
+	bool								_disable_fec_on_clean_path = false;
+	// Requested to the stream (None before Start() and after Stop())
+	std::atomic<UlpfecProtectionLevel>	_ulpfec_protection_level{UlpfecProtectionLevel::None};
+	int64_t								_ulpfec_level_changed_time_ms = 0;
+	// Stop() releases the level while the packets are sent
+	std::mutex							_ulpfec_mutex;
+	bool								_ulpfec_released = false;
+	// Media packets sent after the last FEC packet
+	size_t								_ulpfec_media_packet_count = 0;
+	// _video_sequence_number_offset of the media packets, which is used for SN base of the FEC packets
+	uint16_t							_fec_sn_base_offset = 0;
 };
\ No newline at end of file
@@ -8,9 +8,11 @@ using namespace common;
 
 std::shared_ptr<RtcStream> RtcStream::Create(const std::shared_ptr<pub::Application> application,
                                              const info::Stream &info,
-                                             uint32_t worker_count)
+                                             uint32_t worker_count,
+                                             bool session_sharding)
 {
 	auto stream = std::make_shared<RtcStream>(application, info);
+	stream->SetSessionSharding(session_sharding);
 	if(!stream->Start(worker_count))
 	{
 		return nullptr;
@@ -137,6 +139,7 @@ bool RtcStream::Start(uint32_t worker_count)
 					video_media_desc->SetDirection(MediaDescription::Direction::SendOnly);
 					video_media_desc->SetMediaType(MediaDescription::MediaType::Video);
 					video_media_desc->SetCname(ov::Random::GenerateUInt32(), ov::Random::GenerateString(16));
+					video_media_desc->SetRtxSsrc(ov::Random::GenerateUInt32());
 					_offer_sdp->AddMedia(video_media_desc);
 					first_video_desc = false;
 				}
@@ -145,6 +148,19 @@ bool RtcStream::Start(uint32_t worker_count)
 				payload->EnableRtcpFb(PayloadAttr::RtcpFbType::Nack, true);
 
 				video_media_desc->AddPayload(payload);
+
+				// RTX (RFC 4588) for the retransmission of the lost packets
+				{
+					auto rtx_payload = std::make_shared<PayloadAttr>();
+					rtx_payload->SetRtpmap(payload_type_num++, "rtx", 90000);
+					rtx_payload->SetFmtp(ov::String::FormatString("apt=%d", payload->GetId()));
+
+					video_media_desc->AddPayload(rtx_payload);
+					_rtx_payload_types[payload->GetId()] = rtx_payload->GetId();
+				}
+
+				_video_renditions[payload->GetId()] = track->GetBitrate();
+
 				video_media_desc->Update();
 
 				// RTP Packetizer를 추가한다.
@@ -226,6 +242,14 @@ bool RtcStream::Start(uint32_t worker_count)
 
         video_media_desc->AddPayload(red_payload);
         video_media_desc->AddPayload(ulpfec_payload);
+
+		// RTX of RED: the lost RED packets are retransmitted as they are (with FEC)
+		auto rtx_red_payload = std::make_shared<PayloadAttr>();
+		rtx_red_payload->SetRtpmap(RTX_RED_PAYLOAD_TYPE, "rtx", 90000);
+		rtx_red_payload->SetFmtp(ov::String::FormatString("apt=%d", RED_PAYLOAD_TYPE));
+		video_media_desc->AddPayload(rtx_red_payload);
+		_rtx_payload_types[RED_PAYLOAD_TYPE] = RTX_RED_PAYLOAD_TYPE;
+
 		video_media_desc->Update();
     }
 
@@ -273,7 +297,26 @@ bool RtcStream::OnRtpPacketized(std::shared_ptr<RtpPacket> packet)
 	//                 | origin_pt_of_fec | red block_pt | rtp_payload_type |
 	uint32_t payload_type = rtp_payload_type | (red_block_pt << 8) | (origin_pt_of_fec << 16);
 
-	BroadcastPacket(payload_type, packet->GetData());
+	// The packetizer reuses its buffer, so take a snapshot which is shared by the history and the sessions
+	std::shared_ptr<const ov::Data> snapshot = packet->GetData()->Clone();
+
+	bool is_red = (rtp_payload_type == RED_PAYLOAD_TYPE);
+	auto &histories = is_red ? _red_packet_histories : _packet_histories;
+	auto history = histories.find(is_red ? (packet->IsUlpfec() ? origin_pt_of_fec : red_block_pt) : rtp_payload_type);
+	if(history != histories.end())
+	{
+		history->second->Store(packet->SequenceNumber(), snapshot);
+
+		// FEC packets follow the media packets, so the first RED packet of a keyframe is a media packet
+		bool &keyframe_start = is_red ? _keyframe_start_red : _keyframe_start_rtp;
+		if(keyframe_start)
+		{
+			payload_type |= RTC_PACKET_TYPE_KEYFRAME_START;
+			keyframe_start = false;
+		}
+	}
+
+	BroadcastPacket(payload_type, snapshot);
 	if(_stream_metrics != nullptr)
 	{
 		_stream_metrics->IncreaseBytesOut(PublisherType::Webrtc, packet->GetData()->GetLength() * GetSessionCount());
@@ -320,6 +363,9 @@ void RtcStream::SendVideoFrame(const std::shared_ptr<MediaPacket> &media_packet)
 	auto data = media_packet->GetData();
 	auto fragmentation = media_packet->GetFragHeader();
 
+	// OnRtpPacketized() is called by Packetize()
+	_keyframe_start_rtp = _keyframe_start_red = (frame_type == FrameType::VideoFrameKey);
+
 	packetizer->Packetize(frame_type,
 	                      timestamp,
 	                      data->GetDataAs<uint8_t>(),
@@ -414,6 +460,11 @@ void RtcStream::AddPacketizer(common::MediaCodecId codec_id, uint32_t id, uint8_
 		case MediaCodecId::H265:
 			packetizer->SetVideoCodec(codec_id);
 			packetizer->SetUlpfec(RED_PAYLOAD_TYPE, ULPFEC_PAYLOAD_TYPE);
+			packetizer->SetUlpfecProtectionLevel(_ulpfec_protection_level);
+
+			// NACK is enabled for video only
+			_packet_histories[payload_type] = std::make_shared<RtpPacketHistory>();
+			_red_packet_histories[payload_type] = std::make_shared<RtpPacketHistory>();
 			break;
 		case MediaCodecId::Opus:
 			packetizer->SetAudioCodec(codec_id);
@@ -435,3 +486,85 @@ std::shared_ptr<RtpPacketizer> RtcStream::GetPacketizer(uint32_t id)
 
 	return _packetizers[id];
 }
+
+std::shared_ptr<RtpPacketHistory> RtcStream::GetPacketHistory(uint8_t payload_type, bool red)
+{
+	auto &histories = red ? _red_packet_histories : _packet_histories;
+	auto item = histories.find(payload_type);
+
+	if(item == histories.end())
+	{
+		return nullptr;
+	}
+
+	return item->second;
+}
+
+uint8_t RtcStream::GetRtxPayloadType(uint8_t payload_type)
+{
+	auto item = _rtx_payload_types.find(payload_type);
+
+	if(item == _rtx_payload_types.end())
+	{
+		return 0;
+	}
+
+	return item->second;
+}
+
+const std::map<uint8_t, int32_t> &RtcStream::GetVideoRenditions() const
+{
+	return _video_renditions;
+}
+
+void RtcStream::UpdateUlpfecProtectionLevel(UlpfecProtectionLevel previous_level, UlpfecProtectionLevel level)
+{
+	if(previous_level == level)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock_guard(_ulpfec_mutex);
+
+	if(previous_level != UlpfecProtectionLevel::None)
+	{
+		_ulpfec_session_counts[static_cast<size_t>(previous_level)]--;
+	}
+
+	if(level != UlpfecProtectionLevel::None)
+	{
+		_ulpfec_session_counts[static_cast<size_t>(level)]++;
+	}
+
+	auto stream_level = UlpfecProtectionLevel::None;
+
+	for(size_t index = ULPFEC_PROTECTION_LEVEL_COUNT - 1; index > 0; index--)
+	{
+		if(_ulpfec_session_counts[index] > 0)
+		{
+			stream_level = static_cast<UlpfecProtectionLevel>(index);
+			break;
+		}
+	}
+
+	if(stream_level == _ulpfec_protection_level)
+	{
+		return;
+	}
+
+	logtd("FEC protection level of the stream is changed: %d -> %d (%s)",
+		  static_cast<int>(_ulpfec_protection_level.load()), static_cast<int>(stream_level), GetName().CStr());
+
+	_ulpfec_protection_level = stream_level;
+
+	// _packetizers is not modified after Start()
+	for(auto &item : _packetizers)
+	{
+		item.second->SetUlpfecProtectionLevel(stream_level);
+	}
+}
+
+UlpfecProtectionLevel RtcStream::GetUlpfecProtectionLevel() const
+{
+	return _ulpfec_protection_level;
+}
@@ -7,20 +7,26 @@
 #include "modules/ice/ice_port.h"
 #include "modules/sdp/session_description.h"
 #include "modules/rtp_rtcp/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/rtp_packet_history.h"
+#include "modules/rtp_rtcp/ulpfec_generator.h"
 #include "monitoring/monitoring.h"
 #include "rtc_session.h"
 
 #define PAYLOAD_TYPE_OFFSET		100
+#define RTX_RED_PAYLOAD_TYPE	122 // RTX of RED packets (apt=123)
 #define RED_PAYLOAD_TYPE		123
 #define	ULPFEC_PAYLOAD_TYPE		124
 #define RTCP_PACKET_TYPE		125 // For internal use
+// Set to the packet type of the first packet of a keyframe (for each of RTP and RED), where sessions can switch the rendition
+#define RTC_PACKET_TYPE_KEYFRAME_START	(1 << 24)
 
 class RtcStream : public pub::Stream, public RtpRtcpPacketizerInterface
 {
 public:
 	static std::shared_ptr<RtcStream> Create(const std::shared_ptr<pub::Application> application,
 	                                         const info::Stream &info,
-	                                         uint32_t worker_count);
+	                                         uint32_t worker_count,
+	                                         bool session_sharding = false);
 	explicit RtcStream(const std::shared_ptr<pub::Application> application,
 	                   const info::Stream &info);
 	~RtcStream() final;
@@ -35,6 +41,23 @@ public:
 	void AddPacketizer(common::MediaCodecId codec_id, uint32_t id, uint8_t payload_type, uint32_t ssrc);
 	std::shared_ptr<RtpPacketizer> GetPacketizer(uint32_t id);
 
+	// Recently sent packets of the video track, which are used to retransmit the lost packets (nullptr if NACK is not supported)
+	// Video tracks share the SSRC of the m-line, so the histories are identified by the payload type of the track.
+	// RED packets have their own sequence numbers, so they are kept in the other history.
+	std::shared_ptr<RtpPacketHistory> GetPacketHistory(uint8_t payload_type, bool red);
+	// Returns the RTX payload type which is associated with payload_type, or 0 if there is none
+	uint8_t GetRtxPayloadType(uint8_t payload_type);
+
+	// Video tracks (e.g. transcoded renditions of the same input), which a session can switch between
+	// Key: payload type, Value: bitrate (0 if unknown)
+	const std::map<uint8_t, int32_t> &GetVideoRenditions() const;
+
+	// Each RED session requests the FEC protection level for its own path, and the stream generates FEC with the highest one.
+	// previous_level is the level which the session requested before (None if it is the first request).
+	// Call it with level == None to release the request (e.g. when the session is stopped).
+	void UpdateUlpfecProtectionLevel(UlpfecProtectionLevel previous_level, UlpfecProtectionLevel level);
+	UlpfecProtectionLevel GetUlpfecProtectionLevel() const;
+
 	// RtpRtcpPacketizerInterface Implementation
 	bool OnRtpPacketized(std::shared_ptr<RtpPacket> packet) override;
 
@@ -54,5 +77,23 @@ private:
 	// Packetizing을 위해 RtpSender를 이용한다.
 	std::map<uint32_t, std::shared_ptr<RtpPacketizer>> _packetizers;
 
+	// Created in Start() and never modified after that, so they are read without locking
+	// Key: payload type of the track
+	std::map<uint32_t, std::shared_ptr<RtpPacketHistory>> _packet_histories;
+	std::map<uint32_t, std::shared_ptr<RtpPacketHistory>> _red_packet_histories;
+	// Key: payload type, Value: RTX payload type
+	std::map<uint8_t, uint8_t> _rtx_payload_types;
+	std::map<uint8_t, int32_t> _video_renditions;
+
+	// The next packets are the first ones of a keyframe
+	bool _keyframe_start_rtp = false;
+	bool _keyframe_start_red = false;
+
+	// Number of the sessions which request each protection level
+	std::mutex _ulpfec_mutex;
+	int32_t _ulpfec_session_counts[ULPFEC_PROTECTION_LEVEL_COUNT] = {0, };
+	// FEC is not generated until a session requests it
+	std::atomic<UlpfecProtectionLevel> _ulpfec_protection_level{UlpfecProtectionLevel::None};
+
 	std::shared_ptr<mon::StreamMetrics>		_stream_metrics;
 };
\ No newline at end of file
@@ -283,12 +283,8 @@ std::shared_ptr<const SessionDescription> WebRtcPublisher::OnRequestOffer(const
 
 	auto &candidates = _ice_port->GetIceCandidateList();
 	ice_candidates->insert(ice_candidates->end(), candidates.cbegin(), candidates.cend());
-	auto session_description = std::make_shared<SessionDescription>(*stream->GetSessionDescription());
-	session_description->SetOrigin("OvenMediaEngine", ++_last_issued_session_id, 2, "IN", 4, "127.0.0.1");
-	session_description->SetIceUfrag(_ice_port->GenerateUfrag());
-	session_description->Update();
-
-	return session_description;
+	// Only the session id and the ufrag are different from the offer of the stream
+	return stream->GetSessionDescription()->Clone(++_last_issued_session_id, _ice_port->GenerateUfrag());
 }
 
 // Called when receives an answer sdp from client
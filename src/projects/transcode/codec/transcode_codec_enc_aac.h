@@ -24,7 +24,6 @@ public:
 
 	std::shared_ptr<MediaPacket> RecvBuffer(TranscodeResult *result) override;
 
-	void ThreadEncode() override;
+	void EncodeQueuedFrames() override;
 
-	void Stop() override;	
 };
@@ -102,48 +102,22 @@ bool OvenCodecImplAvcodecEncAVC::Configure(std::shared_ptr<TranscodeContext> con
 		return false;
 	}
 
-	// Generates a thread that reads and encodes frames in the input_buffer queue and places them in the output queue.
-	try
-	{
-		_kill_flag = false;
-
-		_thread_work = std::thread(&OvenCodecImplAvcodecEncAVC::ThreadEncode, this);
-	}
-	catch (const std::system_error &e)
-	{
-		_kill_flag = true;
-
-		logte("Failed to start transcode stream thread.");
-	}
+	// Frames in the input_buffer queue are encoded by the strand of the encoder, and placed in the output queue (See TranscodeEncoder::SendBuffer())
+	_kill_flag = false;
 
 	return true;
 }
 
-void OvenCodecImplAvcodecEncAVC::Stop()
-{
-	_kill_flag = true;
-
-	_queue_event.Notify();
-
-	if (_thread_work.joinable())
-	{
-		_thread_work.join();
-		logtd("AVC encoder thread has ended.");
-	}
-}
-
-void OvenCodecImplAvcodecEncAVC::ThreadEncode()
+void OvenCodecImplAvcodecEncAVC::EncodeQueuedFrames()
 {
 	while(!_kill_flag)
 	{
-		_queue_event.Wait();
-
 		std::unique_lock<std::mutex> mlock(_mutex);
 
-		// 스레드 종료와 같이 큐에 데이터가 없는 경우에는 다시 대기를 한다
+		// 큐에 데이터가 없으면 다음 SendBuffer()까지 대기한다
 		if (_input_buffer.empty())
 		{
-			continue;
+			break;
 		}
 
 		auto frame = std::move(_input_buffer.front());
@@ -198,7 +172,6 @@ void OvenCodecImplAvcodecEncAVC::ThreadEncode()
 			std::unique_lock<std::mutex> mlock(_mutex);
 			_input_buffer.push_front(std::move(frame));
 			mlock.unlock();
-			_queue_event.Notify();
 		}
 
 		///////////////////////////////////////////////////
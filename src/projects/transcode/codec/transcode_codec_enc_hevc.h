@@ -24,9 +24,7 @@ public:
 
 	std::shared_ptr<MediaPacket> RecvBuffer(TranscodeResult *result) override;
 
-	void ThreadEncode() override;
-
-	void Stop() override;
+	void EncodeQueuedFrames() override;
 
 private:
 	std::shared_ptr<MediaPacket> MakePacket() const;
@@ -73,56 +73,28 @@ bool OvenCodecImplAvcodecEncOpus::Configure(std::shared_ptr<TranscodeContext> co
 	_format = common::AudioSample::Format::None;
 	_current_pts = -1;
 
-	// Generates a thread that reads and encodes frames in the input_buffer queue and places them in the output queue.
-	try
-	{
-		_kill_flag = false;
-
-		_thread_work = std::thread(&OvenCodecImplAvcodecEncOpus::ThreadEncode, this);
-	}
-	catch (const std::system_error &e)
-	{
-		_kill_flag = true;
-
-		logte("Failed to start transcode stream thread.");
-	}
+	// Frames in the input_buffer queue are encoded by the strand of the encoder, and placed in the output queue (See TranscodeEncoder::SendBuffer())
+	_kill_flag = false;
 
 
 	return true;
 }
 
-void OvenCodecImplAvcodecEncOpus::Stop()
-{
-	_kill_flag = true;
-
-	_queue_event.Notify();
-
-	if (_thread_work.joinable())
-	{
-		_thread_work.join();
-		logtd("OPUS encoder thread has ended.");
-	}
-}
-
-void OvenCodecImplAvcodecEncOpus::ThreadEncode()
+void OvenCodecImplAvcodecEncOpus::EncodeQueuedFrames()
 {
 	const unsigned int frame_count_to_encode = 480 * 2;
 	const unsigned int bytes_to_encode = frame_count_to_encode * _output_context->GetAudioChannel().GetCounts() * _output_context->GetAudioSample().GetSampleSize();
 
-	int64_t duration = 0LL;
-
 	while(!_kill_flag)
 	{
 		if (_buffer->GetLength() < bytes_to_encode)
 		{
 			// dequeue
-			_queue_event.Wait();
-
 			std::unique_lock<std::mutex> mlock(_mutex);
 
 			if (_input_buffer.empty())
 			{
-				continue;
+				break;
 			}
 
 			auto frame_buffer = std::move(_input_buffer.front());
@@ -142,7 +114,7 @@ void OvenCodecImplAvcodecEncOpus::ThreadEncode()
 				_current_pts = frame->GetPts();
 			}
 
-			duration += frame->GetDuration();
+			_buffered_duration += frame->GetDuration();
 
 			// Append frame data into the buffer
 
@@ -244,14 +216,14 @@ void OvenCodecImplAvcodecEncOpus::ThreadEncode()
 		::memmove(buffer, buffer + bytes_to_encode, _buffer->GetLength() - bytes_to_encode);
 		_buffer->SetLength(_buffer->GetLength() - bytes_to_encode);
 
-		auto packet_buffer = std::make_shared<MediaPacket>(common::MediaType::Audio, 1, encoded, _current_pts, _current_pts, duration, MediaPacketFlag::Key);
+		auto packet_buffer = std::make_shared<MediaPacket>(common::MediaType::Audio, 1, encoded, _current_pts, _current_pts, _buffered_duration, MediaPacketFlag::Key);
 		_current_pts += frame_count_to_encode;
 		// logte("opus pts : %lld, queue:%d, buffer:%d", _current_pts, _input_buffer.size(), _buffer->GetLength());
 		// *result = TranscodeResult::DataReady;
 		
 		SendOutputBuffer(std::move(packet_buffer));
 	
-		duration = 0L;		
+		_buffered_duration = 0L;		
 	}
 
 }
@@ -27,15 +27,15 @@ public:
 
 	std::shared_ptr<MediaPacket> RecvBuffer(TranscodeResult *result) override;
 
-	void ThreadEncode() override;
-
-	void Stop() override;
+	void EncodeQueuedFrames() override;
 
 protected:
 	std::shared_ptr<ov::Data> _buffer;
 
 	common::AudioSample::Format _format;
 	int64_t _current_pts;
+	// Duration of the frames in _buffer that are not encoded yet
+	int64_t _buffered_duration = 0LL;
 
 	OpusEncoder *_encoder;
 };
@@ -70,48 +70,23 @@ bool OvenCodecImplAvcodecEncVP8::Configure(std::shared_ptr<TranscodeContext> con
 		return false;
 	}
 
-	try
-	{
-		_kill_flag = false;
-
-		_thread_work = std::thread(&OvenCodecImplAvcodecEncVP8::ThreadEncode, this);
-	}
-	catch (const std::system_error &e)
-	{
-		_kill_flag = true;
-
-		logte("Failed to start transcode stream thread.");
-	}
+	// Frames in the input_buffer queue are encoded by the strand of the encoder, and placed in the output queue (See TranscodeEncoder::SendBuffer())
+	_kill_flag = false;
 
 
 	return true;
 }
 
 
-void OvenCodecImplAvcodecEncVP8::Stop()
-{
-	_kill_flag = true;
-
-	_queue_event.Notify();
-
-	if (_thread_work.joinable())
-	{
-		_thread_work.join();
-		logtd("VP8 encoder thread has ended.");
-	}
-}
-
-void OvenCodecImplAvcodecEncVP8::ThreadEncode()
+void OvenCodecImplAvcodecEncVP8::EncodeQueuedFrames()
 {
 	while(!_kill_flag)
 	{
-		_queue_event.Wait();
-
 		std::unique_lock<std::mutex> mlock(_mutex);
 
 		if (_input_buffer.empty())
 		{
-			continue;
+			break;
 		}
 
 		///////////////////////////////////////////////////
@@ -166,7 +141,6 @@ void OvenCodecImplAvcodecEncVP8::ThreadEncode()
 			std::unique_lock<std::mutex> mlock(_mutex);
 			_input_buffer.push_front(std::move(frame));
 			mlock.unlock();
-			_queue_event.Notify();
 		}
 
 		///////////////////////////////////////////////////
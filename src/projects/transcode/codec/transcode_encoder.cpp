@@ -26,6 +26,13 @@ TranscodeEncoder::TranscodeEncoder()
 	_frame = ::av_frame_alloc();
 
 	_codec_par = ::avcodec_parameters_alloc();
+
+	_strand.SetHandler([this]() {
+		if (_kill_flag == false)
+		{
+			EncodeQueuedFrames();
+		}
+	});
 }
 
 TranscodeEncoder::~TranscodeEncoder()
@@ -106,7 +113,7 @@ void TranscodeEncoder::SendBuffer(std::shared_ptr<const MediaFrame> frame)
 	
 	mlock.unlock();
 	
-	_queue_event.Notify();;
+	_strand.Notify();
 }
 
 void TranscodeEncoder::SendOutputBuffer(std::shared_ptr<MediaPacket> packet)
@@ -127,12 +134,15 @@ std::shared_ptr<TranscodeContext>& TranscodeEncoder::GetContext()
 	return _output_context;
 }
 
-void TranscodeEncoder::ThreadEncode()
+void TranscodeEncoder::EncodeQueuedFrames()
 {
 	// nothing...
 }
 
 void TranscodeEncoder::Stop()
 {
-	// nothing...
+	_kill_flag = true;
+
+	// Waits for the frame being encoded
+	_strand.Stop();
 }
\ No newline at end of file
@@ -26,7 +26,8 @@ public:
 
 	std::shared_ptr<TranscodeContext>& GetContext();
 
-	virtual void ThreadEncode();
+	// Encodes the frames in the input buffer until it is empty. It is called by the strand of the encoder.
+	virtual void EncodeQueuedFrames();
 
 	virtual void Stop();
 
@@ -56,9 +57,9 @@ protected:
 
 	int _decoded_frame_num = 0;
 
-	bool _kill_flag = false;
+	std::atomic<bool> _kill_flag{false};
 	std::mutex _mutex;
-	std::thread _thread_work;
-	ov::Semaphore _queue_event;
+	// Runs EncodeQueuedFrames() on the shared executor instead of a dedicated thread
+	ov::Strand _strand;
 
 };
@@ -22,11 +22,9 @@ std::shared_ptr<TranscodeApplication> TranscodeApplication::Create(const info::A
 }
 
 TranscodeApplication::TranscodeApplication(const info::Application &application_info)
-	: _application_info(application_info),
-	_indicator(nullptr, 100)
+	: _application_info(application_info)
 {
-	// set alias
-	_indicator.SetAlias(ov::String::FormatString("%s - TranscodeApplication Indicator Queue", _application_info.GetName().CStr()));
+	_kill_flag = true;
 }
 
 TranscodeApplication::~TranscodeApplication()
@@ -36,17 +34,7 @@ TranscodeApplication::~TranscodeApplication()
 
 bool TranscodeApplication::Start()
 {
-	try
-	{
-		_kill_flag = false;
-		_thread_looptask = std::thread(&TranscodeApplication::MessageLooper, this);
-	}
-	catch (const std::system_error &e)
-	{
-		_kill_flag = true;
-		logte("Failed to start transcode stream thread");
-		return false;
-	}
+	_kill_flag = false;
 
 	return true;
 }
@@ -54,11 +42,6 @@ bool TranscodeApplication::Start()
 bool TranscodeApplication::Stop()
 {
 	_kill_flag = true;
-	
-	if (_thread_looptask.joinable())
-	{
-		_thread_looptask.join();
-	}
 
 	std::unique_lock<std::mutex> lock(_mutex);
 
@@ -133,41 +116,35 @@ bool TranscodeApplication::OnSendFrame(const std::shared_ptr<info::Stream> &stre
 
 bool TranscodeApplication::AppendIndicator(std::shared_ptr<TranscodeStream> stream, IndicatorQueueType queue_type)
 {
-	_indicator.Enqueue( std::make_shared<BufferIndicator>(stream,queue_type) );
+	if (_kill_flag)
+	{
+		return false;
+	}
 
-	return true;
+	// The indicators of a stream are processed in order by the strand of the stream,
+	// and different streams are processed in parallel by the shared executor
+	return stream->GetStrand().Post([stream, queue_type]() {
+		ProcessIndicator(stream, queue_type);
+	});
 }
 
-void TranscodeApplication::MessageLooper()
+void TranscodeApplication::ProcessIndicator(const std::shared_ptr<TranscodeStream> &stream, IndicatorQueueType queue_type)
 {
-	while (!_kill_flag)
+	switch (queue_type)
 	{
-		auto indicator_ref = _indicator.Dequeue(10);
-		if (indicator_ref.has_value() == false)
-		{
-			// logti("There is no indicator"); 
-			continue;
-		}
-
-		auto indicator = indicator_ref.value();
-
-		switch(indicator->_queue_type)
-		{
-			case BUFFER_INDICATOR_INPUT_PACKETS:
-				indicator->_stream->DoInputPackets();
-				break;
-
-			case BUFFER_INDICATOR_DECODED_FRAMES:
-				indicator->_stream->DoDecodedFrames();
-				break;
-
-			case BUFFER_INDICATOR_FILTERED_FRAMES:
-				indicator->_stream->DoFilteredFrames();
-				break;
-			default:
-				break;
-		}
-
-		// logti("Append Indicator %p %d %d", indicator->_stream, indicator->_queue_type, _indicator.Size());
+		case BUFFER_INDICATOR_INPUT_PACKETS:
+			stream->DoInputPackets();
+			break;
+
+		case BUFFER_INDICATOR_DECODED_FRAMES:
+			stream->DoDecodedFrames();
+			break;
+
+		case BUFFER_INDICATOR_FILTERED_FRAMES:
+			stream->DoFilteredFrames();
+			break;
+
+		default:
+			break;
 	}
-}
\ No newline at end of file
+}
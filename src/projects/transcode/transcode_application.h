@@ -60,9 +60,6 @@ private:
 	std::mutex _mutex;
 
 	volatile bool _kill_flag;
-	void MessageLooper();
-	std::thread _thread_looptask;
-
 
 public:
 	enum IndicatorQueueType {
@@ -73,21 +70,8 @@ public:
 	
 	// Indicator
 	bool AppendIndicator(std::shared_ptr<TranscodeStream> stream, IndicatorQueueType _queue_type);
-
-	class BufferIndicator
-	{
-	public:
-		explicit BufferIndicator(std::shared_ptr<TranscodeStream> stream, IndicatorQueueType queue_type)
-		{
-			_stream = stream;
-			_queue_type = queue_type;
-		}
-
-		std::shared_ptr<TranscodeStream> _stream;
-		IndicatorQueueType _queue_type;
-	};
 	
 private:
-	ov::Queue<std::shared_ptr<BufferIndicator>> _indicator;
+	static void ProcessIndicator(const std::shared_ptr<TranscodeStream> &stream, IndicatorQueueType queue_type);
 };
 
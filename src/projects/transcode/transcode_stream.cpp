@@ -123,12 +123,14 @@ bool TranscodeStream::Stop()
 
 	logtd("Wait for terminated trancode stream thread. kill_flag(%s)", _kill_flag ? "true" : "false");
 
-
-	// Stop all queues
+	// Stop all queues first, to release the Do*() which is waiting for a queue
 	_queue_input_packets.Stop();
 	_queue_decoded_frames.Stop();
 	_queue_filterd_frames.Stop();
 
+	// Wait for the running Do*(), and discard the pending indicators
+	_strand.Stop();
+
 	// Stop all encoders
 	for (auto &iter : _encoders)
 	{
@@ -178,7 +180,11 @@ bool TranscodeStream::Push(std::shared_ptr<MediaPacket> packet)
 		return false;
 	}
 
-	_queue_input_packets.Enqueue(std::move(packet));
+	if (_queue_input_packets.TryEnqueue(std::move(packet)) == false)
+	{
+		logti("Queue(stream) is full, please check your system: (queue: %zu)", _queue_input_packets.Size());
+		return false;
+	}
 
 	if(GetParent() != nullptr)
 		GetParent()->AppendIndicator(this->GetSharedPtr(), TranscodeApplication::IndicatorQueueType::BUFFER_INDICATOR_INPUT_PACKETS);
@@ -855,7 +861,12 @@ TranscodeResult TranscodeStream::DecodePacket(int32_t track_id, std::shared_ptr<
 					return result;
 				}
 
-				_queue_decoded_frames.Enqueue(std::move(decoded_frame));
+				// Do*() runs on the strand which consumes the queue, so it must not wait for the queue
+				if (_queue_decoded_frames.TryEnqueue(std::move(decoded_frame)) == false)
+				{
+					logti("Decoded frame queue is full, please check your system");
+					return result;
+				}
 
 				if(GetParent() != nullptr)
 					GetParent()->AppendIndicator(this->GetSharedPtr(), TranscodeApplication::IndicatorQueueType::BUFFER_INDICATOR_DECODED_FRAMES);
@@ -911,7 +922,11 @@ TranscodeResult TranscodeStream::FilterFrame(int32_t track_id, std::shared_ptr<M
 					(int64_t)(filtered_frame->GetPts()* filter->GetOutputTimebase().GetExpr()*1000), 
 					filtered_frame->GetBufferSize());
 
-				_queue_filterd_frames.Enqueue(std::move(filtered_frame));
+				if ((_queue_filterd_frames.Size() > _max_queue_threshold) || (_queue_filterd_frames.TryEnqueue(std::move(filtered_frame)) == false))
+				{
+					logti("Filtered frame queue is full, please check your system");
+					break;
+				}
 
 				if(GetParent() != nullptr)
 					GetParent()->AppendIndicator(this->GetSharedPtr(), TranscodeApplication::IndicatorQueueType::BUFFER_INDICATOR_FILTERED_FRAMES);
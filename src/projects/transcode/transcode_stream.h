@@ -57,8 +57,16 @@ public:
 	void DoInputPackets();
 	void DoDecodedFrames();
 	void DoFilteredFrames();
+
+	// Do*() of a stream must be called in order by this strand
+	ov::Strand &GetStrand()
+	{
+		return _strand;
+	}
 	
 private:
+	ov::Strand _strand;
+
 	// ov::Semaphore _queue_event;
 
 	const info::Application _application_info;
@@ -107,13 +115,13 @@ private:
 
 
 	// Buffer for encoded(input) media packets
-	ov::Queue<std::shared_ptr<MediaPacket>> _queue_input_packets;
+	ov::RingQueue<std::shared_ptr<MediaPacket>> _queue_input_packets;
 
 	// Buffer for decoded frames
-	ov::Queue<std::shared_ptr<MediaFrame>> _queue_decoded_frames;
+	ov::RingQueue<std::shared_ptr<MediaFrame>> _queue_decoded_frames;
 
 	// Buffer for filtered frames
-	ov::Queue<std::shared_ptr<MediaFrame>> _queue_filterd_frames;
+	ov::RingQueue<std::shared_ptr<MediaFrame>> _queue_filterd_frames;
 
 
 	// last generated output track id.